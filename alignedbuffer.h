@@ -0,0 +1,31 @@
+#pragma once
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#include <vector>
+
+// 64 bayta (önbellek satırı / AVX-512) hizalı std::vector ayırıcısı. SIMD
+// çekirdeklerine verilen tamponlar satır sınırından başlar, iki thread'in
+// tamponu aynı satırı paylaşmaz.
+template <typename T, std::size_t Align = 64>
+struct AlignedAllocator {
+    using value_type = T;
+    template <typename U> struct rebind { using other = AlignedAllocator<U, Align>; };
+
+    AlignedAllocator() noexcept = default;
+    template <typename U> AlignedAllocator(const AlignedAllocator<U, Align> &) noexcept {}
+
+    T *allocate(std::size_t n)
+    {
+        const std::size_t bytes = ((n * sizeof(T) + Align - 1) / Align) * Align;
+        void *p = ::operator new(bytes, std::align_val_t(Align));
+        return static_cast<T *>(p);
+    }
+    void deallocate(T *p, std::size_t) noexcept { ::operator delete(p, std::align_val_t(Align)); }
+
+    template <typename U> bool operator==(const AlignedAllocator<U, Align> &) const noexcept { return true; }
+    template <typename U> bool operator!=(const AlignedAllocator<U, Align> &) const noexcept { return false; }
+};
+
+template <typename T>
+using AlignedVector = std::vector<T, AlignedAllocator<T>>;
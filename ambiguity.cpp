@@ -0,0 +1,197 @@
+#include "ambiguity.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+namespace {
+
+constexpr double kLightSpeed = 299792458.0;
+// Izgara hücre sayısı aday sayısının en fazla bu katı (seyrek ızgarayı temizleme
+// ve önek toplamı maliyeti adaylarla orantılı kalsın)
+constexpr std::size_t kCellsPerCandidate = 16;
+constexpr std::size_t kMinCells = 4096;
+
+} // namespace
+
+AmbiguityResolver::AmbiguityResolver(const Settings &settings)
+    : cfg(settings)
+{
+    if (cfg.prfHz.empty()) cfg.prfHz.push_back(750.0);
+    for (double &p : cfg.prfHz) p = std::max(p, 1.0);
+    prfCount = int(cfg.prfHz.size());
+    cfg.maxRange = std::max(cfg.maxRange, 1.0);
+    cfg.maxDoppler = std::max(cfg.maxDoppler, 0.0);
+    cfg.rangeTolerance = std::max(cfg.rangeTolerance, 1e-3);
+    cfg.dopplerTolerance = std::max(cfg.dopplerTolerance, 1e-3);
+    cfg.minPrfs = std::min(std::max(cfg.minPrfs, 1), prfCount);
+}
+
+double AmbiguityResolver::unambiguousRange(int prf) const
+{
+    return kLightSpeed / (2.0 * cfg.prfHz[std::size_t(prf)]);
+}
+
+void AmbiguityResolver::resolve(const std::vector<Detection> &detections, std::vector<Target> &targets)
+{
+    using Clock = std::chrono::steady_clock;
+    const auto t0 = Clock::now();
+    targets.clear();
+    stats = Stats{};
+    stats.detections = detections.size();
+
+    // Adaylar: menzil ve Doppler katlarının açılımı. Çapalar (kümeyi başlatan,
+    // sonrasında minPrfs'e yetecek kadar PRF olan) listeye, ilk PRF dışındakiler
+    // ızgaraya girer (eş hep çapadan sonraki PRF'dendir). Önce yalnızca sayılır
+    // (ızgara boyu), sonra hücre indeksiyle birlikte üretilir.
+    const int lastAnchor = prfCount - cfg.minPrfs;
+    std::size_t expected = 0;
+    for (const Detection &d : detections) {
+        if (d.prf < 1 || d.prf >= prfCount) continue;
+        const double prf = cfg.prfHz[std::size_t(d.prf)], ru = unambiguousRange(d.prf);
+        const double r0 = d.range - std::floor(d.range / ru) * ru;
+        const double f0 = d.doppler - std::floor(d.doppler / prf + 0.5) * prf;
+        const long folds = r0 <= cfg.maxRange ? long(std::floor((cfg.maxRange - r0) / ru)) + 1 : 0;
+        const long nLo = long(std::ceil((-cfg.maxDoppler - f0) / prf));
+        const long nHi = long(std::floor((cfg.maxDoppler - f0) / prf));
+        expected += std::size_t(folds * std::max(0L, nHi - nLo + 1));
+    }
+
+    // Izgara: hücre kenarı en az 2 tolerans, böylece tolerans içindeki komşular
+    // adayın hücresinde ya da her eksende yalnızca yakın taraftaki komşudadır
+    // (2 x 2 hücre). Hücre sayısı sınırı aşarsa seyrek eksenin kenarı ikiye katlanır.
+    double edgeR = 2.0 * cfg.rangeTolerance, edgeD = 2.0 * cfg.dopplerTolerance;
+    int rows = int(std::min(cfg.maxRange / edgeR, 1e9)) + 1, cols = int(std::min(2.0 * cfg.maxDoppler / edgeD, 1e9)) + 1;
+    const std::size_t maxCells = std::max(kMinCells, kCellsPerCandidate * expected);
+    while (std::size_t(rows) * std::size_t(cols) > maxCells) {
+        if (rows >= cols) {
+            edgeR *= 2.0;
+            rows = int(cfg.maxRange / edgeR) + 1;
+        } else {
+            edgeD *= 2.0;
+            cols = int(2.0 * cfg.maxDoppler / edgeD) + 1;
+        }
+    }
+    const double cellR = 1.0 / edgeR, cellD = 1.0 / edgeD;
+    auto row = [&](double r) { return std::min(int(std::max(r * cellR, 0.0)), rows - 1); };
+    auto col = [&](double f) { return std::min(int(std::max((f + cfg.maxDoppler) * cellD, 0.0)), cols - 1); };
+
+    const std::size_t cells = std::size_t(rows) * std::size_t(cols);
+    cellStart.assign(cells + 1, 0);
+    anchors.clear();
+    unsorted.clear();
+    cellOf.clear();
+    for (std::size_t k = 0; k < detections.size(); ++k) {
+        const Detection &d = detections[k];
+        if (d.prf < 0 || d.prf >= prfCount) continue;
+        const double prf = cfg.prfHz[std::size_t(d.prf)], ru = unambiguousRange(d.prf);
+        const double r0 = d.range - std::floor(d.range / ru) * ru;
+        const double f0 = d.doppler - std::floor(d.doppler / prf + 0.5) * prf;
+        const long nLo = long(std::ceil((-cfg.maxDoppler - f0) / prf));
+        const long nHi = long(std::floor((cfg.maxDoppler - f0) / prf));
+        for (double r = r0; r <= cfg.maxRange; r += ru) {
+            const std::uint32_t rowBase = std::uint32_t(row(r)) * std::uint32_t(cols);
+            for (long n = nLo; n <= nHi; ++n) {
+                const Candidate c{r, f0 + double(n) * prf, std::uint32_t(k), d.prf};
+                if (d.prf <= lastAnchor) anchors.push_back(c);
+                if (d.prf == 0) continue;
+                const std::uint32_t cell = rowBase + std::uint32_t(col(c.doppler));
+                unsorted.push_back(c);
+                cellOf.push_back(cell);
+                ++cellStart[cell];
+            }
+        }
+    }
+    stats.candidates = unsorted.size() + std::size_t(std::count_if(anchors.begin(), anchors.end(),
+                                                                   [](const Candidate &c) { return c.prf == 0; }));
+
+    // Sayma sıralaması: adaylar hücre sırasına (satır menzil, sütun Doppler).
+    // Birikimli toplamdan geriye dağıtınca cellStart[i] hücre i'nin başı olur.
+    for (std::size_t i = 1; i < cells; ++i) cellStart[i] += cellStart[i - 1];
+    cellStart[cells] = std::uint32_t(unsorted.size());
+    candidates.resize(unsorted.size());
+    for (std::size_t c = unsorted.size(); c-- > 0;) candidates[--cellStart[cellOf[c]]] = unsorted[c];
+
+    // Kümeler: her çapa sonraki PRF'lerde tolerans içindeki en yakın adayla
+    clusters.clear();
+    members.clear();
+    nearest.resize(std::size_t(prfCount));
+    pick.resize(std::size_t(prfCount));
+    double *bestDist = nearest.data();
+    std::int32_t *best = pick.data();
+    const std::uint32_t *start = cellStart.data();
+    const double invR = 1.0 / cfg.rangeTolerance, invD = 1.0 / cfg.dopplerTolerance;
+    for (std::size_t a = 0; a < anchors.size(); ++a) {
+        const Candidate &ca = anchors[a];
+        // Yakın taraftaki komşu satır / sütun; bir satırdaki iki hücre ardışık aralıktır
+        const double ur = ca.range * cellR, ud = (ca.doppler + cfg.maxDoppler) * cellD;
+        const int r = row(ca.range), d = col(ca.doppler);
+        const int r2 = ur - double(r) < 0.5 ? std::max(r - 1, 0) : std::min(r + 1, rows - 1);
+        const int d0 = ud - double(d) < 0.5 ? std::max(d - 1, 0) : d;
+        const int d1 = ud - double(d) < 0.5 ? d : std::min(d + 1, cols - 1);
+        const std::uint32_t *near = start + std::size_t(r) * std::size_t(cols);
+        const std::uint32_t *side = start + std::size_t(r2) * std::size_t(cols);
+        // Komşulukta minPrfs - 1 aday yoksa küme olamaz
+        const std::uint32_t inNear = near[d1 + 1] - near[d0], inSide = r2 != r ? side[d1 + 1] - side[d0] : 0;
+        if (int(inNear + inSide) < cfg.minPrfs - 1) continue;
+
+        std::fill(bestDist, bestDist + prfCount, 1.0);
+        std::fill(best, best + prfCount, -1);
+        for (const std::uint32_t *cellRow : {near, side}) {
+            const std::uint32_t end = cellRow[d1 + 1];
+            for (std::uint32_t b = cellRow[d0]; b < end; ++b) {
+                const Candidate &cb = candidates[b];
+                if (cb.prf <= ca.prf) continue;
+                const double x = (cb.range - ca.range) * invR, y = (cb.doppler - ca.doppler) * invD;
+                const double dist = x * x + y * y;
+                if (dist <= bestDist[cb.prf]) {
+                    bestDist[cb.prf] = dist;
+                    best[cb.prf] = std::int32_t(b);
+                }
+            }
+            if (r2 == r) break;
+        }
+        int count = 1;
+        for (int p = 0; p < prfCount; ++p) count += best[p] >= 0;
+        if (count < cfg.minPrfs) continue;
+        double residual = 0.0;
+        for (int p = 0; p < prfCount; ++p)
+            if (best[p] >= 0) residual += std::sqrt(bestDist[p]);
+        clusters.push_back(Cluster{count, count > 1 ? residual / double(count - 1) : 0.0,
+                                   std::uint32_t(a), std::uint32_t(members.size())});
+        members.insert(members.end(), best, best + prfCount);
+    }
+    stats.clusters = clusters.size();
+
+    // Açgözlü kabul: çok PRF'li ve küçük kalıntılı önce, tespit bir kez kullanılır
+    order.resize(clusters.size());
+    for (std::size_t i = 0; i < order.size(); ++i) order[i] = std::uint32_t(i);
+    std::sort(order.begin(), order.end(), [&](std::uint32_t x, std::uint32_t y) {
+        const Cluster &a = clusters[x], &b = clusters[y];
+        return a.prfs != b.prfs ? a.prfs > b.prfs : a.residual < b.residual;
+    });
+    used.assign(detections.size(), 0);
+    const double lambda = kLightSpeed / std::max(cfg.frequencyHz, 1.0);
+    for (std::uint32_t i : order) {
+        const Cluster &cl = clusters[i];
+        const std::int32_t *m = members.data() + cl.first;
+        const Candidate &anchor = anchors[cl.anchor];
+        bool free = !used[anchor.detection];
+        for (int p = 0; p < prfCount && free; ++p)
+            if (m[p] >= 0 && used[candidates[std::size_t(m[p])].detection]) free = false;
+        if (!free) continue;
+        used[anchor.detection] = 1;
+        double r = anchor.range, f = anchor.doppler;
+        for (int p = 0; p < prfCount; ++p) {
+            if (m[p] < 0) continue;
+            const Candidate &c = candidates[std::size_t(m[p])];
+            used[c.detection] = 1;
+            r += c.range;
+            f += c.doppler;
+        }
+        r /= cl.prfs;
+        f /= cl.prfs;
+        targets.push_back(Target{r, f, 0.5 * f * lambda, cl.prfs, cl.residual});
+    }
+    stats.targets = targets.size();
+    stats.milliseconds = std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+}
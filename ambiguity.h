@@ -0,0 +1,102 @@
+#ifndef AMBIGUITY_H
+#define AMBIGUITY_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Çoklu PRF menzil/Doppler belirsizlik çözümü. Her PRF'de menzil Ru = c / (2 PRF)
+// ve Doppler PRF modülünde katlanır; tespit (r, f) gerçek değerin
+// (r + m Ru, f + n PRF) adaylarından biridir.
+//
+// Tüm tespitlerin adayları (maxRange / maxDoppler içinde) yoğun bir (menzil,
+// Doppler) ızgarasının hücre sırasına sayma sıralamasıyla dizilir (hücre en az
+// 2 tolerans; hücre sayısı aday sayısının birkaç katını aşarsa kenarlar
+// büyütülür). Her aday, yakın 2 x 2 hücrede kendinden sonraki PRF'lerin en
+// yakın adaylarıyla kümelenir; en az minPrfs farklı PRF'yi birleştiren kümeler
+// aday olur. Bir satırdaki iki komşu hücre bellekte tek ardışık aralıktır;
+// ilk PRF'nin adayları ızgaraya hiç girmez (eş olamaz). Kümeler PRF sayısı ve kalıntıya göre sıralanır, tespitleri daha
+// önce kullanılmamış olanlar açgözlü kabul edilir (hayalet hedefleri bastırır).
+// Maliyet aday sayısıyla doğrusal, PRF'ler arası kombinasyonla (N^k) değil.
+// Bütçe: 4 PRF (3-of-4), 300 km / ±5 kHz'de tespit başına ~20 aday ile CPI başına 600
+// tespitte en kötü CPI 1 ms altında (ölçülen ~0.5 ms; bench_ambiguity en kötü
+// CPI'yi ve çözülebilir hedeflerde >= %98 bulunmayı denetler). Süre tespit
+// sayısıyla doğrusal artar: ~1100 tespit ≈ 0.9-1.0 ms en kötü, ~2200 ≈ 2.2 ms.
+//
+// Tamponlar çağrılar arasında tutulur; ısınmadan sonra bellek ayırma yoktur.
+class AmbiguityResolver
+{
+public:
+    struct Settings {
+        std::vector<double> prfHz{750.0};
+        double frequencyHz{3.0e9};          // hız = f λ / 2
+        double maxRange{300000.0};          // m
+        double maxDoppler{5000.0};          // |f| Hz
+        double rangeTolerance{150.0};       // m (≈ menzil hücresi)
+        double dopplerTolerance{25.0};      // Hz (≈ Doppler hücresi)
+        int minPrfs{2};                     // M-of-N
+    };
+
+    struct Detection {
+        int prf;                            // Settings::prfHz indeksi
+        double range;                       // görünen menzil, [0, Ru)
+        double doppler;                     // görünen Doppler, [-PRF/2, PRF/2)
+    };
+
+    struct Target {
+        double range;
+        double doppler;
+        double velocity;                    // radyal, yaklaşan pozitif
+        int prfs;                           // birleşen PRF sayısı
+        double residual;                    // normalize ortalama uzaklık
+    };
+
+    struct Stats {
+        std::size_t detections{0};
+        std::size_t candidates{0};
+        std::size_t clusters{0};
+        std::size_t targets{0};
+        double milliseconds{0.0};
+    };
+
+    explicit AmbiguityResolver(const Settings &settings);
+
+    const Settings &settings() const { return cfg; }
+    double unambiguousRange(int prf) const;
+
+    // targets temizlenip doldurulur
+    void resolve(const std::vector<Detection> &detections, std::vector<Target> &targets);
+
+    const Stats &lastStats() const { return stats; }
+
+private:
+    struct Candidate {
+        double range;
+        double doppler;
+        std::uint32_t detection;
+        int prf;
+    };
+    struct Cluster {
+        int prfs;
+        double residual;
+        std::uint32_t anchor;               // anchors indeksi
+        std::uint32_t first;                // members içinde başlangıç
+    };
+
+    Settings cfg;
+    int prfCount{1};
+    std::vector<Candidate> anchors;         // kümeyi başlatabilen adaylar (üretim sırası)
+    std::vector<Candidate> candidates;      // ilk PRF dışındakiler, hücre sırasında
+    std::vector<Candidate> unsorted;
+    std::vector<std::uint32_t> cellOf;      // unsorted adayın hücresi
+    std::vector<std::uint32_t> cellStart;   // hücre başına candidates başlangıcı (+1 son)
+    std::vector<Cluster> clusters;
+    std::vector<std::int32_t> members;      // küme başına prfCount candidates indeksi (-1 yok / çapa)
+    std::vector<double> nearest;            // PRF başına en yakın uzaklık²
+    std::vector<std::int32_t> pick;         // PRF başına en yakın aday (-1 yok)
+    std::vector<std::uint32_t> order;
+    std::vector<unsigned char> used;        // tespit başına
+    Stats stats;
+};
+
+#endif // AMBIGUITY_H
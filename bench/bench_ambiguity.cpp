@@ -0,0 +1,108 @@
+// Çoklu PRF belirsizlik çözümü: 4 PRF (750-1300 Hz, 3 GHz), 300 km / ±5 kHz
+// içinde rastgele hedefler her PRF'de katlanır, ölçüm gürültüsü ve PRF başına
+// yanlış alarmlar eklenir. 3-of-4 çözümde bulunan / kaçan / hayalet hedef
+// sayısı ve CPI başına süre (hedef sayısına göre) raporlanır. Bulunma oranı
+// çözülebilir hedeflere (en az minPrfs PRF'de tespit edilen) göredir. Her CPI
+// kRepeats kez çözülür, en iyisi o CPI'nin süresidir (önalım gürültüsü); en kötü
+// CPI kBudgetDetections tespite kadar kBudgetMs'i aşarsa ya da bulunma oranı
+// kMinFound altındaysa çıkış kodu 1'dir.
+#include "ambiguity.h"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <algorithm>
+#include <random>
+#include <vector>
+
+namespace {
+
+// ambiguity.h'deki tasarım bütçesi
+constexpr std::size_t kBudgetDetections = 600;
+constexpr double kBudgetMs = 1.0;
+constexpr double kMinFound = 0.98;
+constexpr int kRepeats = 5;
+
+} // namespace
+
+int main()
+{
+    AmbiguityResolver::Settings s;
+    s.prfHz = {750.0, 900.0, 1100.0, 1300.0};
+    s.frequencyHz = 3.0e9;
+    s.maxRange = 300000.0;
+    s.maxDoppler = 5000.0;
+    s.rangeTolerance = 150.0;
+    s.dopplerTolerance = 25.0;
+    s.minPrfs = 3;
+    AmbiguityResolver resolver(s);
+
+    std::mt19937 rng(22);
+    std::uniform_real_distribution<double> uRange(1000.0, s.maxRange), uDoppler(-s.maxDoppler, s.maxDoppler), u01(0.0, 1.0);
+    std::normal_distribution<double> nRange(0.0, 15.0), nDoppler(0.0, 3.0);
+
+    bool overBudget = false, lowFound = false;
+    for (int count : {25, 50, 100, 200, 400}) {
+        const int falseAlarms = count / 2, cpis = 20;
+        int found = 0, missed = 0, unresolvable = 0, ghosts = 0;
+        double worstMs = 0.0, totalMs = 0.0;
+        std::size_t detections = 0, candidates = 0;
+        std::vector<AmbiguityResolver::Detection> dets;
+        std::vector<AmbiguityResolver::Target> out;
+        for (int cpi = 0; cpi < cpis; ++cpi) {
+            std::vector<std::pair<double, double>> truth(static_cast<std::size_t>(count));
+            for (auto &t : truth) t = {uRange(rng), uDoppler(rng)};
+            std::vector<int> seen(truth.size(), 0);
+            dets.clear();
+            for (int p = 0; p < int(s.prfHz.size()); ++p) {
+                const double prf = s.prfHz[std::size_t(p)], ru = resolver.unambiguousRange(p);
+                for (std::size_t i = 0; i < truth.size(); ++i) {
+                    const auto &t = truth[i];
+                    if (u01(rng) < 0.1) continue;   // Pd 0.9
+                    ++seen[i];
+                    const double r = std::fmod(t.first + nRange(rng) + ru, ru);
+                    const double f = t.second + nDoppler(rng);
+                    dets.push_back({p, r, f - std::floor(f / prf + 0.5) * prf});
+                }
+                for (int k = 0; k < falseAlarms; ++k)
+                    dets.push_back({p, u01(rng) * ru, (u01(rng) - 0.5) * prf});
+            }
+            double cpiMs = 1e30;
+            for (int rep = 0; rep < kRepeats; ++rep) {
+                resolver.resolve(dets, out);
+                cpiMs = std::min(cpiMs, resolver.lastStats().milliseconds);
+            }
+            const AmbiguityResolver::Stats &st = resolver.lastStats();
+            worstMs = std::max(worstMs, cpiMs);
+            totalMs += cpiMs;
+            detections += st.detections;
+            candidates += st.candidates;
+
+            std::vector<char> hit(truth.size(), 0);
+            for (const auto &t : out) {
+                bool match = false;
+                for (std::size_t i = 0; i < truth.size(); ++i) {
+                    if (std::fabs(t.range - truth[i].first) < 3 * s.rangeTolerance
+                        && std::fabs(t.doppler - truth[i].second) < 3 * s.dopplerTolerance) {
+                        match = true;
+                        hit[i] = 1;
+                    }
+                }
+                ghosts += match ? 0 : 1;
+            }
+            for (std::size_t i = 0; i < truth.size(); ++i) {
+                if (seen[i] < s.minPrfs) ++unresolvable;
+                else (hit[i] ? found : missed) += 1;
+            }
+        }
+        const double foundRate = double(found) / double(std::max(1, found + missed));
+        std::printf("%3d targets: %4zu det/CPI, %6zu candidates, found %5.1f%% of resolvable, missed %3d, unresolvable %3d, "
+                    "ghosts %4d | %.3f ms avg, %.3f ms worst\n",
+                    count, detections / cpis, candidates / cpis, 100.0 * foundRate, missed, unresolvable, ghosts,
+                    totalMs / cpis, worstMs);
+        if (detections / cpis <= kBudgetDetections && worstMs > kBudgetMs) overBudget = true;
+        if (foundRate < kMinFound) lowFound = true;
+    }
+    std::printf("budget (<= %zu det/CPI, %.1f ms worst CPI): %s\n", kBudgetDetections, kBudgetMs, overBudget ? "EXCEEDED" : "ok");
+    std::printf("found rate (>= %.0f%% of resolvable): %s\n", 100.0 * kMinFound, lowFound ? "LOW" : "ok");
+    return overBudget || lowFound ? 1 : 0;
+}
@@ -0,0 +1,135 @@
+// CFAR: CA/SO/GO/OS eşikleri kaba kuvvet (pencere başına toplam / nth_element)
+// karşılığıyla karşılaştırılır, yalnızca gürültülü haritada gerçekleşen yanlış
+// alarm oranı istenen Pfa ile ölçülür. Ardından 64 x 65536 hücrelik menzil-
+// Doppler haritası (N = 200, guard 2, uygulamanın varsayılanları) tek thread ve
+// iş çalan havuzla işlenir; çıktı varyant başına hücre/s'dir. Eşik kaba kuvvetten
+// ayrılırsa ya da tek thread hızı varyantın tabanının altında kalırsa çıkış kodu 1.
+#include "cfar.h"
+#include "workstealingpool.h"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <algorithm>
+#include <random>
+#include <vector>
+
+namespace {
+
+// Tek thread taban hızı (M hücre/s): CA/SO/GO önek toplamlı döngü ~400, OS
+// kesim başına radix sıralama ve artımlı k. eleman ~30
+constexpr double kMinSumsMcells = 150.0;
+constexpr double kMinOrderedMcells = 15.0;
+constexpr double kMaxRelErr = 1e-5;
+
+template <typename F>
+double secondsPerRun(F &&run, double minSeconds)
+{
+    using Clock = std::chrono::steady_clock;
+    run(); // ısınma
+    double best = 1e30, elapsed = 0.0;
+    while (elapsed < minSeconds) {
+        const auto t0 = Clock::now();
+        run();
+        const double t = std::chrono::duration<double>(Clock::now() - t0).count();
+        best = std::min(best, t);
+        elapsed += t;
+    }
+    return best;
+}
+
+const char *name(Cfar::Type t)
+{
+    switch (t) {
+    case Cfar::Type::CA: return "CA";
+    case Cfar::Type::SO: return "SO";
+    case Cfar::Type::GO: return "GO";
+    case Cfar::Type::OS: return "OS";
+    }
+    return "?";
+}
+
+// Hücre i için kaba kuvvet eşik (kenarlar +inf)
+double bruteThreshold(const Cfar &cfar, const std::vector<float> &x, std::size_t i)
+{
+    const std::size_t n = std::size_t(cfar.trainingPerSide()), g = std::size_t(cfar.settings().guardCells);
+    if (i < n + g || i + n + g >= x.size()) return INFINITY;
+    std::vector<float> lag(x.begin() + std::ptrdiff_t(i - g - n), x.begin() + std::ptrdiff_t(i - g));
+    std::vector<float> lead(x.begin() + std::ptrdiff_t(i + g + 1), x.begin() + std::ptrdiff_t(i + g + 1 + n));
+    double sl = 0.0, sr = 0.0;
+    for (float v : lag) sl += v;
+    for (float v : lead) sr += v;
+    switch (cfar.settings().type) {
+    case Cfar::Type::CA: return cfar.multiplier() * (sl + sr);
+    case Cfar::Type::SO: return cfar.multiplier() * std::min(sl, sr);
+    case Cfar::Type::GO: return cfar.multiplier() * std::max(sl, sr);
+    case Cfar::Type::OS: {
+        std::vector<float> all = lag;
+        all.insert(all.end(), lead.begin(), lead.end());
+        const int k = std::min(std::max(cfar.settings().osRank, 1), int(all.size()));
+        std::nth_element(all.begin(), all.begin() + (k - 1), all.end());
+        return cfar.multiplier() * all[std::size_t(k - 1)];
+    }
+    }
+    return 0.0;
+}
+
+} // namespace
+
+int main()
+{
+    std::mt19937 rng(20);
+    std::exponential_distribution<float> noise(1.0f);
+    const Cfar::Type types[] = {Cfar::Type::CA, Cfar::Type::SO, Cfar::Type::GO, Cfar::Type::OS};
+
+    // Doğruluk: 10000 hücrelik satır (OS birden çok sıralama kesimi), N = 32,
+    // guard 2, OS k = 24
+    bool failed = false;
+    std::vector<float> line(10000);
+    for (float &v : line) v = noise(rng);
+    for (Cfar::Type t : types) {
+        Cfar::Settings s;
+        s.type = t;
+        s.trainingCells = 32;
+        s.osRank = 24;
+        s.pfa = 1e-4;
+        Cfar cfar(s);
+        Cfar::Workspace ws;
+        std::vector<float> thr(line.size());
+        std::vector<Cfar::Hit> hits;
+        cfar.process(line.data(), line.size(), thr.data(), hits, ws);
+        double err = 0.0;
+        for (std::size_t i = 0; i < line.size(); ++i) {
+            const double b = bruteThreshold(cfar, line, i);
+            if (std::isinf(b) != std::isinf(thr[i])) err = INFINITY;
+            else if (!std::isinf(b)) err = std::max(err, std::fabs(thr[i] - b) / b);
+        }
+        std::printf("%s vs brute force      : max rel err %.1e (alpha %.4f)\n", name(t), err, cfar.multiplier());
+        failed |= !(err <= kMaxRelErr);
+    }
+
+    // Harita: 64 Doppler x 65536 menzil, yalnızca gürültü
+    const std::size_t rows = 64, cells = 65536;
+    std::vector<float> map(rows * cells), thr(map.size());
+    for (float &v : map) v = noise(rng);
+    WorkStealingPool pool;
+    std::vector<Cfar::Hit> hits;
+    for (Cfar::Type t : types) {
+        Cfar::Settings s;
+        s.type = t;
+        s.pfa = 1e-3;
+        Cfar cfar(s);
+        hits.clear();
+        cfar.processMap(map.data(), rows, cells, nullptr, hits, &pool);
+        const double tested = double(rows) * double(cells - 2 * (100 + 2));
+        const double t1 = secondsPerRun([&] { hits.clear(); cfar.processMap(map.data(), rows, cells, thr.data(), hits, nullptr); }, 0.5);
+        const double tp = secondsPerRun([&] { hits.clear(); cfar.processMap(map.data(), rows, cells, thr.data(), hits, &pool); }, 0.5);
+        const double total = double(rows * cells);
+        const double floor = t == Cfar::Type::OS ? kMinOrderedMcells : kMinSumsMcells;
+        const bool slow = total / t1 * 1e-6 < floor;
+        std::printf("%s N=200: Pfa 1e-3 measured %.2e | 1 thread %7.1f M cells/s, %2d w %7.1f M cells/s (floor %.0f%s)\n",
+                    name(t), double(hits.size()) / tested, total / t1 * 1e-6, pool.workerCount(), total / tp * 1e-6,
+                    floor, slow ? ", BELOW" : "");
+        failed |= slow;
+    }
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,128 @@
+// EntityStore adım maliyeti: varlık sayısına göre tick süresi (10 .. 100k).
+// Karşılaştırma için eski düzen (isim anahtarlı std::map + ayrı state) de ölçülür.
+// Ardından ecefToGeodeticBatch'in gidiş-dönüş doğruluğu (kutuplar dahil) raporlanır.
+#include "entitystore.h"
+#include "geo.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct MapState {
+    double lat, lon, alt, velN, velE, velD;
+    std::vector<EntityWaypoint> route;
+    int nextWpIndex{0};
+};
+
+void seed(int i, double &lat, double &lon, double &vN, double &vE)
+{
+    lat = 38.0 + 0.001 * (i % 1000);
+    lon = 32.0 + 0.001 * (i / 1000);
+    vN = 50.0 + (i % 7);
+    vE = -30.0 + (i % 11);
+}
+
+template <typename F>
+double timePerTickUs(F &&tick, int minTicks, double minSeconds)
+{
+    using Clock = std::chrono::steady_clock;
+    tick(); // ısınma
+    int ticks = 0;
+    const auto t0 = Clock::now();
+    double elapsed = 0.0;
+    while (ticks < minTicks || elapsed < minSeconds) {
+        tick();
+        ++ticks;
+        elapsed = std::chrono::duration<double>(Clock::now() - t0).count();
+    }
+    return elapsed * 1e6 / ticks;
+}
+
+} // namespace
+
+int main()
+{
+    const double dt = 0.01;   // 100 Hz
+    const double thr = 10.0;
+    const int counts[] = {10, 100, 1000, 10000, 100000};
+
+    std::printf("%10s %14s %14s %12s %10s\n", "entities", "soa_us/tick", "map_us/tick", "soa_ns/ent", "speedup");
+    for (int n : counts) {
+        EntityStore store;
+        store.reserve(n);
+        std::map<std::string, MapState> legacy;
+        for (int i = 0; i < n; ++i) {
+            double lat, lon, vN, vE;
+            seed(i, lat, lon, vN, vE);
+            const int idx = store.add(lat, lon, 1000.0, vN, vE, 0.0);
+            EntityWaypoint wp;
+            wp.lat = lat + 0.5; wp.lon = lon + 0.5; wp.alt = 1000.0;
+            wp.velN = vN; wp.velE = vE;
+            store.setRoute(idx, {wp});
+            legacy["target-" + std::to_string(i)] = MapState{lat, lon, 1000.0, vN, vE, 0.0, {wp}, 0};
+        }
+        std::vector<std::string> names;
+        names.reserve(legacy.size());
+        for (const auto &kv : legacy) names.push_back(kv.first);
+
+        const double soa = timePerTickUs([&] { store.step(dt, thr); }, 20, 0.2);
+        const double map = timePerTickUs([&] {
+            // Eski yol: her varlık için isimle arama + iki ek geodeticToECEF
+            for (const auto &name : names) {
+                MapState &st = legacy[name];
+                double X, Y, Z, nlat, nlon, nalt;
+                Geo::enuToECEF(st.velE * dt, st.velN * dt, -st.velD * dt, st.lat, st.lon, st.alt, X, Y, Z);
+                Geo::ecefToGeodetic(X, Y, Z, nlat, nlon, nalt);
+                const EntityWaypoint &wp = st.route[0];
+                double Xe, Ye, Ze, Xw, Yw, Zw;
+                Geo::geodeticToECEF(nlat, nlon, nalt, Xe, Ye, Ze);
+                Geo::geodeticToECEF(wp.lat, wp.lon, wp.alt, Xw, Yw, Zw);
+                const double d2 = (Xe-Xw)*(Xe-Xw) + (Ye-Yw)*(Ye-Yw) + (Ze-Zw)*(Ze-Zw);
+                st.lat = nlat; st.lon = nlon; st.alt = nalt;
+                if (d2 <= thr * thr) st.nextWpIndex++;
+            }
+        }, 20, 0.2);
+
+        std::printf("%10d %14.2f %14.2f %12.1f %9.2fx\n", n, soa, map, soa * 1e3 / n, map / soa);
+    }
+
+    // Gidiş-dönüş: geodetic -> ECEF (skaler) -> ecefToGeodeticBatch -> ECEF; son iki
+    // nokta tam kutuplardır (X = Y = 0)
+    std::printf("\n%10s %16s %14s %8s\n", "height_m", "max_roundtrip_m", "max_dh_m", "nan");
+    for (double h : {-500.0, 0.0, 1000.0, 10000.0, 30000.0, 100000.0}) {
+        std::vector<double> X, Y, Z;
+        for (double lat = -90.0; lat <= 90.0; lat += 0.05) {
+            for (double lon = -180.0; lon < 180.0; lon += 15.0) {
+                double x, y, z;
+                Geo::geodeticToECEF(lat, lon, h, x, y, z);
+                X.push_back(x); Y.push_back(y); Z.push_back(z);
+            }
+        }
+        const double b = Geo::a * (1.0 - Geo::f);
+        for (double s : {1.0, -1.0}) {
+            X.push_back(0.0); Y.push_back(0.0); Z.push_back(s * (b + h));
+        }
+        const std::size_t n = X.size();
+        std::vector<double> lat(n), lon(n), alt(n);
+        Geo::ecefToGeodeticBatch(X.data(), Y.data(), Z.data(), lat.data(), lon.data(), alt.data(), n);
+        double worst = 0.0, worstH = 0.0;
+        int nan = 0;
+        for (std::size_t i = 0; i < n; ++i) {
+            if (!std::isfinite(lat[i]) || !std::isfinite(alt[i])) {
+                ++nan;
+                continue;
+            }
+            double x, y, z;
+            Geo::geodeticToECEF(lat[i], lon[i], alt[i], x, y, z);
+            worst = std::max(worst, std::sqrt((x - X[i]) * (x - X[i]) + (y - Y[i]) * (y - Y[i]) + (z - Z[i]) * (z - Z[i])));
+            worstH = std::max(worstH, std::fabs(alt[i] - h));
+        }
+        std::printf("%10.0f %16.3g %14.3g %8d\n", h, worst, worstH, nan);
+    }
+    return 0;
+}
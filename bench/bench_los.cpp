@@ -0,0 +1,190 @@
+// Görüş hattı: 10 radar x 2000 target, DTED-2 boyutlu sentetik hücre üzerinde.
+// Soğuk tam matris (tüm çiftler) ve hareket eşiğini aşan %5 target'lı artımlı
+// tick süresi, iş çalan havuzla ölçülür. Kuadratik yol yaklaşımı, her örnekte
+// slerp ile hesaplanan yola karşı, karo tavanıyla blok atlama da atlamasız
+// taramaya karşı doğrulanır. Ayrıca sabit radar için 360° radyal ufuk
+// (CoverageMap'in çekirdeği) süresi ve Los::clear ile tutarlılığı.
+// Artımlı tick kTickBudgetMs'i, tam matris kFullBudgetMs'i aşarsa ya da
+// doğrulamalardan biri tutmazsa çıkış kodu 1'dir.
+#include "lineofsight.h"
+#include "terrainsampler.h"
+#include "workstealingpool.h"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <algorithm>
+#include <limits>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace {
+
+// SimEngine fizik adımı başına LOS bütçesi; tam matris (varlık sayısı değişimi,
+// arazi yenileme) AVX2 ile iki, skaler örneklemeyle dört adıma kadar sürebilir
+constexpr double kTickBudgetMs = 10.0;
+#if defined(__AVX2__)
+constexpr double kFullBudgetMs = 2 * kTickBudgetMs;
+#else
+constexpr double kFullBudgetMs = 4 * kTickBudgetMs;
+#endif
+
+template <typename F>
+double secondsPerRun(F &&run, double minSeconds)
+{
+    using Clock = std::chrono::steady_clock;
+    run(); // ısınma
+    double best = 1e30, elapsed = 0.0;
+    while (elapsed < minSeconds) {
+        const auto t0 = Clock::now();
+        run();
+        const double t = std::chrono::duration<double>(Clock::now() - t0).count();
+        best = std::min(best, t);
+        elapsed += t;
+    }
+    return best;
+}
+
+// Referans: her örnekte küresel slerp ile yol noktası
+bool clearReference(const Terrain::GridView &g, const Los::Endpoint &a, const Los::Endpoint &b, const Los::Params &p)
+{
+    auto unit = [](double lat, double lon, double *v) {
+        lat *= Geo::deg2rad; lon *= Geo::deg2rad;
+        v[0] = std::cos(lat) * std::cos(lon); v[1] = std::cos(lat) * std::sin(lon); v[2] = std::sin(lat);
+    };
+    double u[3], w[3];
+    unit(a.lat, a.lon, u);
+    unit(b.lat, b.lon, w);
+    const double ang = std::acos(std::min(1.0, u[0] * w[0] + u[1] * w[1] + u[2] * w[2]));
+    const double D = ang * Los::earthRadius;
+    if (D < 1.0) return true;
+    const double hA = std::max(a.alt, Terrain::bilinear(g, a.lat, a.lon) + p.minAntennaAgl);
+    const double hB = std::max(b.alt, Terrain::bilinear(g, b.lat, b.lon) + p.minAntennaAgl);
+    const int n = std::clamp(static_cast<int>(std::ceil(D / p.sampleSpacing)), 2, p.maxSamples);
+    for (int k = 1; k < n; ++k) {
+        const double t = double(k) / n;
+        const double s0 = std::sin((1 - t) * ang) / std::sin(ang), s1 = std::sin(t * ang) / std::sin(ang);
+        const double x = s0 * u[0] + s1 * w[0], y = s0 * u[1] + s1 * w[1], z = s0 * u[2] + s1 * w[2];
+        const double lat = std::asin(z) * Geo::rad2deg, lon = std::atan2(y, x) * Geo::rad2deg;
+        const double d = t * D;
+        const double terrain = Terrain::bilinear(g, lat, lon) + d * (D - d) / (2.0 * p.kFactor * Los::earthRadius);
+        if (terrain > hA + (hB - hA) * t) return false;
+    }
+    return true;
+}
+
+} // namespace
+
+int main()
+{
+    const int n = 3601;
+    std::vector<std::int16_t> posts(std::size_t(n) * n);
+    for (int r = 0; r < n; ++r)
+        for (int c = 0; c < n; ++c)
+            posts[std::size_t(r) * n + c] = static_cast<std::int16_t>(
+                900.0 + 700.0 * std::sin(r * 0.004) * std::cos(c * 0.003) + ((r * 31 + c * 17) % 23));
+    std::vector<std::int16_t> tiled, maxima;
+    Terrain::tileGrid(posts.data(), n, n, tiled);
+    Terrain::tileMaxima(tiled, maxima);
+
+    Terrain::GridView g;
+    g.posts = tiled.data();
+    g.rows = n;
+    g.cols = n;
+    g.tilesX = Terrain::tilesFor(n);
+    g.tileMax = maxima.data();
+    g.north = 40.0;
+    g.west = 32.0;
+    g.latStep = 1.0 / 3600.0;
+    g.lonStep = 1.0 / 3600.0;
+
+    const int radarCount = 10, targetCount = 2000;
+    std::mt19937_64 rng(11);
+    std::uniform_real_distribution<double> u(0.0, 1.0);
+    std::vector<Los::Endpoint> radars(radarCount), targets(targetCount);
+    for (auto &r : radars) r = {39.35 + 0.3 * u(rng), 32.35 + 0.3 * u(rng), 0.0};   // zemin + 2 m
+    for (auto &t : targets) t = {39.02 + 0.96 * u(rng), 32.02 + 0.96 * u(rng), 1500.0 + 3000.0 * u(rng)};
+
+    const Los::Params params;
+    auto sampler = [&g](const Terrain::Arc &arc, float *out, std::size_t count) {
+        Terrain::bilinearArc(g, arc, out, count);
+    };
+    auto ceiling = [&g](const Terrain::Arc &arc, std::size_t count) { return Terrain::ceilingAlongArc(g, arc, count); };
+
+    WorkStealingPool pool;
+    std::vector<std::unique_ptr<Los::Scratch>> scratch(pool.workerCount());
+    for (auto &s : scratch) s = std::make_unique<Los::Scratch>();
+
+    const std::size_t pairs = std::size_t(radarCount) * targetCount;
+    std::vector<unsigned char> visible(pairs);
+    std::vector<std::uint32_t> all(pairs), dirty;
+    for (std::size_t i = 0; i < pairs; ++i) all[i] = static_cast<std::uint32_t>(i);
+    for (std::size_t i = 0; i < pairs; ++i)
+        if (i % targetCount < std::size_t(targetCount) / 20) dirty.push_back(static_cast<std::uint32_t>(i));
+
+    auto run = [&](const std::vector<std::uint32_t> &work) {
+        pool.parallelFor(work.size(), 16, [&](std::size_t b, std::size_t e, int worker) {
+            for (std::size_t k = b; k < e; ++k) {
+                const std::size_t idx = work[k];
+                visible[idx] = Los::clear(radars[idx / targetCount], targets[idx % targetCount], params, sampler, ceiling, *scratch[worker]);
+            }
+        });
+    };
+
+    const double tFull = secondsPerRun([&] { run(all); }, 1.0);
+    std::size_t seen = 0;
+    for (unsigned char v : visible) seen += v;
+    const double tDirty = secondsPerRun([&] { run(dirty); }, 1.0);
+
+    int mismatch = 0, skipMismatch = 0;
+    for (std::size_t i = 0; i < pairs; i += 7)
+        if (bool(visible[i]) != clearReference(g, radars[i / targetCount], targets[i % targetCount], params)) ++mismatch;
+    auto noCeiling = [](const Terrain::Arc &, std::size_t) { return std::numeric_limits<float>::infinity(); };
+    for (std::size_t i = 0; i < pairs; ++i)
+        if (bool(visible[i]) != Los::clear(radars[i / targetCount], targets[i % targetCount], params, sampler, noCeiling, *scratch[0]))
+            ++skipMismatch;
+
+    std::printf("workers: %d, pairs: %zu, visible: %zu\n", pool.workerCount(), pairs, seen);
+    std::printf("full matrix      : %8.2f ms\n", tFull * 1e3);
+    std::printf("5%% targets moved : %8.2f ms (%zu pairs)\n", tDirty * 1e3, dirty.size());
+    std::printf("quadratic vs slerp path mismatches: %d / %zu\n", mismatch, (pairs + 6) / 7);
+    std::printf("tile skip vs full scan mismatches : %d / %zu\n", skipMismatch, pairs);
+
+    // 360° ufuk: 100 km, 1 km düğüm, 629 azimut (CoverageMap varsayılanları)
+    const int azBins = 629, nodes = 100;
+    const double rangeStep = 1000.0;
+    std::vector<float> minH(std::size_t(azBins) * nodes);
+    const double tCov = secondsPerRun([&] {
+        pool.parallelFor(azBins, 4, [&](std::size_t b, std::size_t e, int worker) {
+            for (std::size_t a = b; a < e; ++a)
+                Los::minVisibleHeights(radars[0], 360.0 * a / azBins, rangeStep, nodes, params, sampler,
+                                       *scratch[worker], minH.data() + a * nodes);
+        });
+    }, 1.0);
+    // Düğüm noktasında eşiğin 1 m üstü görünür, 1 m altı görünmez olmalı. Örnekler
+    // çakışsın diye (ufuk düğüm başına, clear() yol başına böler) 50 m aralıkla
+    Los::Params aligned = params;
+    aligned.sampleSpacing = 50.0;
+    std::vector<float> rowH(nodes);
+    int covBad = 0, covChecked = 0;
+    for (int a = 0; a < azBins; a += 13) {
+        Los::minVisibleHeights(radars[0], 360.0 * a / azBins, rangeStep, nodes, aligned, sampler, *scratch[0], rowH.data());
+        for (int k = 0; k < nodes; k += 7) {
+            const Los::Endpoint p = Los::destination(radars[0].lat, radars[0].lon, 360.0 * a / azBins, (k + 1) * rangeStep);
+            if (p.lat < 39.0 || p.lat > 40.0 || p.lon < 32.0 || p.lon > 33.0) continue;
+            const double h = rowH[k];
+            const double ground = Terrain::bilinear(g, p.lat, p.lon);
+            if (!Los::clear(radars[0], {p.lat, p.lon, h + 1.0}, aligned, sampler, ceiling, *scratch[0])) ++covBad;
+            if (h > ground + aligned.minAntennaAgl + 1.0
+                && Los::clear(radars[0], {p.lat, p.lon, h - 1.0}, aligned, sampler, ceiling, *scratch[0])) ++covBad;
+            ++covChecked;
+        }
+    }
+    std::printf("360 deg horizon  : %8.2f ms (%d az x %d range), %d / %d inconsistent\n",
+                tCov * 1e3, azBins, nodes, covBad, covChecked);
+
+    const bool overBudget = tDirty * 1e3 > kTickBudgetMs || tFull * 1e3 > kFullBudgetMs;
+    std::printf("budget (tick %.0f ms, full matrix %.0f ms): %s\n", kTickBudgetMs, kFullBudgetMs,
+                overBudget ? "EXCEEDED" : "ok");
+    return overBudget || mismatch || skipMismatch || covBad ? 1 : 0;
+}
@@ -0,0 +1,91 @@
+// Menzil-Doppler: bilinen menzil/Doppler'deki iki hedefin haritada doğru hücrede
+// çıktığı doğrulanır; sonra 4 PRF'li (750-1500 Hz) 64 darbelik CPI'ler, darbe
+// başına 16384 menzil hücresiyle çift tamponlu işlemciye beslenir. Köşe dönüşü
+// karosuz (rangeBlock = 1) ve karolu, tek thread ve havuzla ölçülür; çıktı
+// darbe/s ve en yüksek PRF'ye göre gerçek zaman oranıdır.
+#include "rangedoppler.h"
+#include "workstealingpool.h"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <algorithm>
+#include <random>
+#include <vector>
+
+namespace {
+
+constexpr double kPi = 3.14159265358979323846;
+
+} // namespace
+
+int main()
+{
+    // Doğrulama: 1 PRF, 64 darbe, 1024 hücre; hedefler (300, +PRF/4) ve (700, -PRF/8)
+    {
+        RangeDopplerProcessor::Settings s;
+        s.prfHz = {1000.0};
+        s.rangeBins = 1024;
+        s.pulsesPerCpi = 64;
+        std::vector<float> map;
+        std::size_t bins = 0;
+        RangeDopplerProcessor rd(s, nullptr, [&](const RangeDopplerProcessor::Map &m) {
+            map.assign(m.power, m.power + m.dopplerBins * m.rangeBins);
+            bins = m.dopplerBins;
+        });
+        std::vector<float> re(s.rangeBins), im(s.rangeBins);
+        for (int p = 0; p < s.pulsesPerCpi; ++p) {
+            std::fill(re.begin(), re.end(), 0.0f);
+            std::fill(im.begin(), im.end(), 0.0f);
+            re[300] = float(std::cos(2.0 * kPi * 0.25 * p));
+            im[300] = float(std::sin(2.0 * kPi * 0.25 * p));
+            re[700] = float(std::cos(-2.0 * kPi * 0.125 * p));
+            im[700] = float(std::sin(-2.0 * kPi * 0.125 * p));
+            rd.pushPulse(0, re.data(), im.data());
+        }
+        rd.flush();
+        auto peak = [&](std::size_t r) {
+            std::size_t best = 0;
+            for (std::size_t d = 1; d < bins; ++d)
+                if (map[d * s.rangeBins + r] > map[best * s.rangeBins + r]) best = d;
+            return best;
+        };
+        std::printf("target r=300 +PRF/4: doppler row %zu (expected %zu), r=700 -PRF/8: row %zu (expected %zu)\n",
+                    peak(300), bins / 2 + bins / 4, peak(700), bins / 2 - bins / 8);
+    }
+
+    // Verim: 4 PRF sırayla, her biri 8 CPI
+    const std::vector<double> prfs = {750.0, 1000.0, 1250.0, 1500.0};
+    const std::size_t rangeBins = 16384;
+    const int pulses = 64, cpisPerPrf = 8;
+    std::mt19937 rng(21);
+    std::normal_distribution<float> noise(0.0f, 1.0f);
+    std::vector<float> re(rangeBins * 16), im(rangeBins * 16);
+    for (std::size_t i = 0; i < re.size(); ++i) { re[i] = noise(rng); im[i] = noise(rng); }
+
+    WorkStealingPool pool;
+    for (std::size_t block : {std::size_t(1), std::size_t(32)}) {
+        for (WorkStealingPool *p : {static_cast<WorkStealingPool *>(nullptr), &pool}) {
+            RangeDopplerProcessor::Settings s;
+            s.prfHz = prfs;
+            s.rangeBins = rangeBins;
+            s.pulsesPerCpi = pulses;
+            s.rangeBlock = block;
+            double checksum = 0.0;
+            RangeDopplerProcessor rd(s, p, [&](const RangeDopplerProcessor::Map &m) { checksum += m.power[m.rangeBins / 2]; });
+            const auto t0 = std::chrono::steady_clock::now();
+            std::size_t k = 0;
+            for (int cpi = 0; cpi < cpisPerPrf; ++cpi)
+                for (int prf = 0; prf < int(prfs.size()); ++prf)
+                    for (int n = 0; n < pulses; ++n, ++k)
+                        rd.pushPulse(prf, re.data() + (k % 16) * rangeBins, im.data() + (k % 16) * rangeBins);
+            rd.flush();
+            const double sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+            const RangeDopplerProcessor::Stats st = rd.stats();
+            const double pps = double(st.pulses) / sec;
+            std::printf("block %2zu, %2d w: %7.0f pulses/s (%.1f M samples/s, x%.2f of 1500 Hz), %.2f ms/CPI, producer wait %.1f ms%s\n",
+                        block, p ? p->workerCount() : 1, pps, pps * double(rangeBins) * 1e-6, pps / 1500.0,
+                        st.processingMs / double(st.cpis), st.waitMs, checksum > 0.0 ? "" : " (!)");
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,154 @@
+// Darbe çizelgesi: 4 PRF (grup içi karışık), 2-4 GHz 10 MHz kanallı frekans
+// atlama, 256 CPI x 64 darbelik tarama. Aynı ayarlarla tek thread'de ve 8
+// thread'de eşzamanlı kurulan tabloların birebir aynı olduğu, her grupta her
+// PRF'nin bir kez geçtiği ve kanal dağılımı doğrulanır. Darbe başına tablo
+// bakışı, darbe başına RNG çağrısıyla karşılaştırılır; son olarak çizelgeli
+// EchoGenerator çıktısı tek thread / havuzda karşılaştırılır.
+#include "echogenerator.h"
+#include "pulsescheduler.h"
+#include "workstealingpool.h"
+#include <chrono>
+#include <cstdio>
+#include <algorithm>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace {
+
+template <typename F>
+double secondsPerRun(F &&run, double minSeconds)
+{
+    using Clock = std::chrono::steady_clock;
+    run(); // ısınma
+    double best = 1e30, elapsed = 0.0;
+    while (elapsed < minSeconds) {
+        const auto t0 = Clock::now();
+        run();
+        const double t = std::chrono::duration<double>(Clock::now() - t0).count();
+        best = std::min(best, t);
+        elapsed += t;
+    }
+    return best;
+}
+
+// Taramanın tüm darbeleri (PRF, kanal frekansı, zaman)
+std::vector<double> sequence(const PulseScheduler &s)
+{
+    std::vector<double> out;
+    out.reserve(s.pulsesPerScan() * 3);
+    for (std::uint64_t k = 0; k < s.pulsesPerScan(); ++k) {
+        const PulseScheduler::Pulse p = s.pulse(k);
+        out.push_back(p.prf);
+        out.push_back(p.frequencyHz);
+        out.push_back(p.time);
+    }
+    return out;
+}
+
+} // namespace
+
+int main()
+{
+    PulseScheduler::Settings s;
+    s.prfHz = {750.0, 900.0, 1100.0, 1300.0};
+    s.hopPrfs = true;
+    s.pulsesPerCpi = 64;
+    s.cpisPerScan = 256;
+    s.freqHop = true;
+    s.lowerFrequencyHz = 2.0e9;
+    s.upperFrequencyHz = 4.0e9;
+    s.channelSpacingHz = 10.0e6;
+    s.seed = 25;
+
+    const PulseScheduler ref(s);
+    const std::vector<double> expected = sequence(ref);
+    std::printf("scan: %zu pulses, %.3f s, %d channels, table %zu bytes\n",
+                ref.pulsesPerScan(), ref.scanDuration(), ref.channels(), ref.tableBytes());
+
+    // Tekrarlanabilirlik: 8 thread eşzamanlı kurar
+    {
+        std::vector<std::vector<double>> seqs(8);
+        std::vector<std::thread> threads;
+        for (std::size_t i = 0; i < seqs.size(); ++i)
+            threads.emplace_back([&, i] { seqs[i] = sequence(PulseScheduler(s)); });
+        for (std::thread &t : threads) t.join();
+        int same = 0;
+        for (const std::vector<double> &q : seqs) same += q == expected;
+        const bool otherScan = sequence(PulseScheduler(s, 1)) != expected;
+        std::printf("8 concurrent builds identical: %d / 8, next scan differs: %s\n", same, otherScan ? "yes" : "NO");
+    }
+
+    // Grup başına PRF kapsamı ve kanal dağılımı
+    {
+        int badGroups = 0;
+        const int n = int(s.prfHz.size());
+        for (int g = 0; g * n < s.cpisPerScan; ++g) {
+            unsigned seen = 0;
+            for (int i = 0; i < n && g * n + i < s.cpisPerScan; ++i)
+                seen |= 1u << ref.pulse(std::uint64_t(g * n + i) * std::uint64_t(s.pulsesPerCpi)).prf;
+            if (seen != (1u << n) - 1) ++badGroups;
+        }
+        std::vector<int> hist(std::size_t(ref.channels()), 0);
+        PulseScheduler::Settings p = s;
+        p.everyPulse = true;
+        const PulseScheduler agile(p);
+        for (std::uint64_t k = 0; k < agile.pulsesPerScan(); ++k)
+            ++hist[std::size_t((agile.pulse(k).frequencyHz - s.lowerFrequencyHz) / s.channelSpacingHz + 0.5)];
+        const double mean = double(agile.pulsesPerScan()) / double(hist.size());
+        std::printf("PRF groups missing a PRF: %d, pulse-to-pulse channel counts %d..%d (mean %.1f), table %zu bytes\n",
+                    badGroups, *std::min_element(hist.begin(), hist.end()), *std::max_element(hist.begin(), hist.end()),
+                    mean, agile.tableBytes());
+    }
+
+    // Darbe başına bakış / RNG
+    {
+        const std::size_t pulses = ref.pulsesPerScan();
+        double sink = 0.0;
+        const double tTable = secondsPerRun([&] {
+            for (std::uint64_t k = 0; k < pulses; ++k) {
+                const PulseScheduler::Pulse p = ref.pulse(k);
+                sink += p.frequencyHz + p.prfHz;
+            }
+        }, 0.2);
+        std::mt19937_64 rng(25);
+        const double tRng = secondsPerRun([&] {
+            std::uniform_int_distribution<int> channel(0, ref.channels() - 1), prf(0, int(s.prfHz.size()) - 1);
+            for (std::size_t k = 0; k < pulses; ++k)
+                sink += s.lowerFrequencyHz + channel(rng) * s.channelSpacingHz + s.prfHz[std::size_t(prf(rng))];
+        }, 0.2);
+        std::printf("per-pulse lookup %.1f ns, per-pulse RNG draw %.1f ns%s\n",
+                    tTable / double(pulses) * 1e9, tRng / double(pulses) * 1e9, sink > 0.0 ? "" : " (!)");
+    }
+
+    // Çizelgeli IQ: tek thread / havuz
+    {
+        EchoGenerator::Settings e;
+        e.waveform.type = Wf::Type::Lfm;
+        e.waveform.pulseWidthUs = 10.0;
+        e.waveform.bandwidthMHz = 5.0;
+        e.schedule = std::make_shared<const PulseScheduler>(s);
+        std::vector<EchoGenerator::Target> targets;
+        for (int i = 0; i < 20; ++i) targets.push_back({10000.0 + 7000.0 * i, -200.0 + 20.0 * i, 10.0f});
+        WorkStealingPool pool;
+        std::vector<float> out[2];
+        std::vector<int> prfs[2];
+        for (int run = 0; run < 2; ++run) {
+            EchoGenerator g(e, run ? &pool : nullptr);
+            g.setTargets(targets);
+            for (std::size_t done = 0; done < 512;) {
+                g.generate(32);
+                for (std::size_t i = 0; i < g.available(); ++i) {
+                    const EchoGenerator::Pulse p = g.pulse(i);
+                    prfs[run].push_back(p.prf);
+                    out[run].insert(out[run].end(), p.re, p.re + g.rangeBins());
+                }
+                done += g.available();
+                g.release(g.available());
+            }
+        }
+        std::printf("scheduled echo, single vs pool: samples %s, PRF routing %s\n",
+                    out[0] == out[1] ? "identical" : "DIFFERENT", prfs[0] == prfs[1] ? "identical" : "DIFFERENT");
+    }
+    return 0;
+}
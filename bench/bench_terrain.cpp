@@ -0,0 +1,115 @@
+// Arazi örnekleme: DTED-2 boyutlu (3601x3601) sentetik hücrede çift doğrusal
+// yükseklik sorgusu. Radyal yollarda (LOS/propagasyon deseni) nokta başına
+// Terrain::bilinear ile artımlı Terrain::bilinearArc karşılaştırılır; rastgele
+// erişim önbellek ıskası tabanı olarak verilir. Eğri yay (ikinci fark) doğruluğu
+// ayrıca ölçülür.
+#include "terrainsampler.h"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <algorithm>
+#include <random>
+#include <vector>
+
+namespace {
+
+// Gürültülü makinelerde kararlı sonuç için en iyi koşu süresi
+template <typename F>
+double secondsPerRun(F &&run, double minSeconds)
+{
+    using Clock = std::chrono::steady_clock;
+    run(); // ısınma
+    double best = 1e30, elapsed = 0.0;
+    while (elapsed < minSeconds) {
+        const auto t0 = Clock::now();
+        run();
+        const double t = std::chrono::duration<double>(Clock::now() - t0).count();
+        best = std::min(best, t);
+        elapsed += t;
+    }
+    return best;
+}
+
+} // namespace
+
+int main()
+{
+    const int n = 3601;
+    std::vector<std::int16_t> posts(std::size_t(n) * n);
+    for (int r = 0; r < n; ++r)
+        for (int c = 0; c < n; ++c)
+            posts[std::size_t(r) * n + c] = static_cast<std::int16_t>(
+                800.0 + 600.0 * std::sin(r * 0.004) * std::cos(c * 0.003) + ((r * 31 + c * 17) % 23));
+    posts[12345] = Terrain::Void;
+    std::vector<std::int16_t> tiled;
+    Terrain::tileGrid(posts.data(), n, n, tiled);
+
+    Terrain::GridView g;
+    g.posts = tiled.data();
+    g.rows = n;
+    g.cols = n;
+    g.tilesX = Terrain::tilesFor(n);
+    g.north = 40.0;
+    g.west = 32.0;
+    g.latStep = 1.0 / 3600.0;
+    g.lonStep = 1.0 / 3600.0;
+
+    // 64 radyal yol x 20000 nokta, hücre merkezinden
+    const int paths = 64, perPath = 20000;
+    const std::size_t total = std::size_t(paths) * perPath;
+    std::vector<double> lat(total), lon(total), outScalar(total);
+    std::vector<Terrain::Arc> arcs(paths);
+    std::vector<float> outArc(total);
+    for (int p = 0; p < paths; ++p) {
+        const double az = 2.0 * Geo::pi * p / paths;
+        arcs[std::size_t(p)] = {39.5, 32.5, 0.49 / perPath * std::cos(az), 0.49 / perPath * std::sin(az), 0.0, 0.0};
+        for (int i = 0; i < perPath; ++i) {
+            lat[std::size_t(p) * perPath + i] = arcs[std::size_t(p)].latAt(i);
+            lon[std::size_t(p) * perPath + i] = arcs[std::size_t(p)].lonAt(i);
+        }
+    }
+    std::vector<double> rlat(total), rlon(total), rout(total);
+    std::mt19937_64 rng(7);
+    std::uniform_real_distribution<double> u(0.0, 1.0);
+    for (std::size_t i = 0; i < total; ++i) { rlat[i] = 39.0 + u(rng); rlon[i] = 32.0 + u(rng); }
+
+    const double tScalar = secondsPerRun([&] {
+        for (std::size_t i = 0; i < total; ++i) outScalar[i] = Terrain::bilinear(g, lat[i], lon[i]);
+    }, 1.0);
+    const double tArc = secondsPerRun([&] {
+        for (int p = 0; p < paths; ++p)
+            Terrain::bilinearArc(g, arcs[std::size_t(p)], outArc.data() + std::size_t(p) * perPath, perPath);
+    }, 1.0);
+    double maxErr = 0.0;
+    for (std::size_t i = 0; i < total; ++i) maxErr = std::max(maxErr, std::fabs(outScalar[i] - outArc[i]));
+
+    const double tRandScalar = secondsPerRun([&] {
+        for (std::size_t i = 0; i < total; ++i) rout[i] = Terrain::bilinear(g, rlat[i], rlon[i]);
+    }, 1.0);
+
+    // Eğri yay: 4096 örnek, hücre içinde ~1 km sapan ikinci dereceden yol
+    const Terrain::Arc curved{39.1, 32.1, 0.8 / 4096, 0.7 / 4096, 0.6e-8, -0.5e-8};
+    std::vector<float> outCurved(4096);
+    Terrain::bilinearArc(g, curved, outCurved.data(), outCurved.size());
+    double curvedErr = 0.0;
+    for (int j = 0; j < 4096; ++j)
+        curvedErr = std::max(curvedErr, std::fabs(outCurved[std::size_t(j)] - Terrain::bilinear(g, curved.latAt(j), curved.lonAt(j))));
+
+    auto msps = [total](double t) { return total / t / 1e6; };
+    std::printf("%-14s %14s %14s %10s\n", "pattern", "scalar_Ms/s", "arc_Ms/s", "speedup");
+    std::printf("%-14s %14.1f %14.1f %9.2fx\n", "radial paths", msps(tScalar), msps(tArc), tScalar / tArc);
+    std::printf("%-14s %14.1f %14s\n", "random", msps(tRandScalar), "-");
+    std::printf("max |scalar - arc| = %.3g m (straight), %.3g m (curved)\n", maxErr, curvedErr);
+
+    // Karolu düzen doğrulaması: düğüm noktalarında ham değer okunmalı
+    int bad = 0;
+    for (int r = 0; r < n; r += 97)
+        for (int c = 0; c < n; c += 89) {
+            const std::int16_t raw = posts[std::size_t(r) * n + c];
+            const double want = raw == Terrain::Void ? 0.0 : raw;
+            if (Terrain::bilinear(g, g.north - r * g.latStep, g.west + c * g.lonStep) != want) ++bad;
+            if (tiled[Terrain::postIndex(g.tilesX, r, c)] != raw) ++bad;
+        }
+    std::printf("layout check: %s\n", bad ? "FAILED" : "ok");
+    return bad ? 1 : 0;
+}
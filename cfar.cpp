@@ -0,0 +1,353 @@
+#include "cfar.h"
+#include "workstealingpool.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <tuple>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define CFAR_RESTRICT __restrict
+#else
+#define CFAR_RESTRICT __restrict__
+#endif
+
+namespace {
+
+// Sıfır olmayan 64 bit sözcükte en düşük / en yüksek 1 bitin konumu
+inline unsigned lowestBit(std::uint64_t b)
+{
+#if defined(_MSC_VER)
+    unsigned long i;
+    _BitScanForward64(&i, b);
+    return unsigned(i);
+#else
+    return unsigned(__builtin_ctzll(b));
+#endif
+}
+
+inline unsigned highestBit(std::uint64_t b)
+{
+#if defined(_MSC_VER)
+    unsigned long i;
+    _BitScanReverse64(&i, b);
+    return unsigned(i);
+#else
+    return 63u - unsigned(__builtin_clzll(b));
+#endif
+}
+
+// SO için Gandhi-Kassam toplamı: 2 Σ_{k<n} C(n-1+k, k) (2 + α)^-(n+k)
+double pfaSmallestOf(int n, double a)
+{
+    const double l2 = std::log(2.0 + a);
+    double sum = 0.0;
+    for (int k = 0; k < n; ++k) {
+        const double lc = std::lgamma(double(n + k)) - std::lgamma(double(k + 1)) - std::lgamma(double(n));
+        sum += std::exp(lc - double(n + k) * l2);
+    }
+    return 2.0 * sum;
+}
+
+double logPfa(Cfar::Type type, int n, int rank, double a)
+{
+    const int half = n / 2;
+    switch (type) {
+    case Cfar::Type::CA:
+        return -double(n) * std::log1p(a);
+    case Cfar::Type::SO:
+        return std::log(pfaSmallestOf(half, a));
+    case Cfar::Type::GO: {
+        const double p = 2.0 * std::exp(-double(half) * std::log1p(a)) - pfaSmallestOf(half, a);
+        return p > 0.0 ? std::log(p) : -std::numeric_limits<double>::infinity();
+    }
+    case Cfar::Type::OS: {
+        double s = 0.0;
+        for (int i = 0; i < rank; ++i) s += std::log(double(n - i)) - std::log(double(n - i) + a);
+        return s;
+    }
+    }
+    return 0.0;
+}
+
+// Negatif olmayan float'ların bitleri sayı sırasıyla aynı; (anahtar, indis)
+// çiftleri 64 bitte, 11 + 11 + 10 bit LSD radix (kova sayaçları L1'de kalır,
+// üçü tek geçişte sayılır). Son geçiş sıralı anahtarı ve sıra numarasını yazar.
+void sortIndices(const float *power, std::size_t length, Cfar::Workspace &ws)
+{
+    constexpr int kDigitBits = 11;
+    constexpr std::uint32_t kBuckets = 1u << kDigitBits, kMask = kBuckets - 1;
+    ws.items.resize(length);
+    ws.tmpItems.resize(length);
+    ws.sorted.resize(length);
+    ws.rank.resize(length);
+    std::vector<std::uint32_t> &count = ws.histogram;
+    count.assign(3 * kBuckets, 0u);
+    std::uint64_t *items = ws.items.data(), *tmp = ws.tmpItems.data();
+    for (std::size_t i = 0; i < length; ++i) {
+        const float v = std::max(power[i], 0.0f);
+        std::uint32_t key;
+        std::memcpy(&key, &v, sizeof key);
+        items[i] = std::uint64_t(key) << 32 | std::uint32_t(i);
+        ++count[key & kMask];
+        ++count[kBuckets + ((key >> kDigitBits) & kMask)];
+        ++count[2 * kBuckets + (key >> (2 * kDigitBits))];
+    }
+    for (int pass = 0; pass < 3; ++pass) {
+        std::uint32_t *c = count.data() + pass * kBuckets;
+        std::uint32_t sum = 0;
+        for (std::uint32_t d = 0; d < kBuckets; ++d) {
+            const std::uint32_t v = c[d];
+            c[d] = sum;
+            sum += v;
+        }
+    }
+    for (int pass = 0; pass < 2; ++pass) {
+        std::uint32_t *c = count.data() + pass * kBuckets;
+        const int shift = 32 + kDigitBits * pass;
+        for (std::size_t i = 0; i < length; ++i) tmp[c[(items[i] >> shift) & kMask]++] = items[i];
+        std::swap(items, tmp);
+    }
+    std::uint32_t *c = count.data() + 2 * kBuckets;
+    for (std::size_t i = 0; i < length; ++i) {
+        const std::uint32_t d = c[items[i] >> (32 + 2 * kDigitBits)]++;
+        ws.sorted[d] = std::uint32_t(items[i] >> 32);
+        ws.rank[std::uint32_t(items[i])] = d;
+    }
+}
+
+} // namespace
+
+Cfar::Cfar(const Settings &settings)
+    : cfg(settings)
+{
+    half = std::max(1, cfg.trainingCells / 2);
+    cfg.guardCells = std::max(0, cfg.guardCells);
+    cfg.pfa = std::min(std::max(cfg.pfa, 1e-300), 0.5);
+    rank = std::min(std::max(cfg.osRank, 1), 2 * half);
+    alpha = thresholdMultiplier(cfg.type, 2 * half, rank, cfg.pfa);
+}
+
+double Cfar::thresholdMultiplier(Type type, int n, int rank, double pfa)
+{
+    static std::mutex mutex;
+    static std::map<std::tuple<int, int, int, double>, double> cache;
+    n = std::max(n, 2);
+    rank = type == Type::OS ? std::min(std::max(rank, 1), n) : 0;
+    const auto key = std::make_tuple(int(type), n, rank, pfa);
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        const auto it = cache.find(key);
+        if (it != cache.end()) return it->second;
+    }
+
+    // Pfa α'da azalan: üst sınır ikiye katlanarak bulunur, sonra ikiye bölme
+    const double target = std::log(pfa);
+    double lo = 0.0, hi = 1.0;
+    while (logPfa(type, n, rank, hi) > target && hi < 1e12) hi *= 2.0;
+    for (int it = 0; it < 200 && hi - lo > 1e-12 * hi; ++it) {
+        const double mid = 0.5 * (lo + hi);
+        if (logPfa(type, n, rank, mid) > target) lo = mid;
+        else hi = mid;
+    }
+    const double a = 0.5 * (lo + hi);
+
+    std::lock_guard<std::mutex> lock(mutex);
+    cache[key] = a;
+    return a;
+}
+
+void Cfar::thresholdSums(const float *power, std::size_t length, float *out, Workspace &ws) const
+{
+    const std::size_t n = std::size_t(half), g = std::size_t(cfg.guardCells);
+    ws.prefix.resize(length + 1);
+    double *CFAR_RESTRICT prefix = ws.prefix.data();
+    prefix[0] = 0.0;
+    for (std::size_t i = 0; i < length; ++i) prefix[i + 1] = prefix[i] + power[i];
+
+    const std::size_t first = std::min(length, n + g);
+    const std::size_t last = length > n + g ? length - n - g : 0;
+    const float inf = std::numeric_limits<float>::infinity();
+    std::fill(out, out + first, inf);
+    std::fill(out + std::max(first, last), out + length, inf);
+    if (last <= first) return;
+
+    // Hücre i: geride [i-g-n, i-g), önde [i+g+1, i+g+1+n)
+    const std::size_t count = last - first;
+    const double *CFAR_RESTRICT lag0 = prefix + first - g - n;
+    const double *CFAR_RESTRICT lag1 = prefix + first - g;
+    const double *CFAR_RESTRICT lead0 = prefix + first + g + 1;
+    const double *CFAR_RESTRICT lead1 = prefix + first + g + 1 + n;
+    float *CFAR_RESTRICT dst = out + first;
+    const double a = alpha;
+    switch (cfg.type) {
+    case Type::CA:
+        for (std::size_t j = 0; j < count; ++j) dst[j] = float(a * ((lag1[j] - lag0[j]) + (lead1[j] - lead0[j])));
+        break;
+    case Type::SO:
+        for (std::size_t j = 0; j < count; ++j) dst[j] = float(a * std::min(lag1[j] - lag0[j], lead1[j] - lead0[j]));
+        break;
+    case Type::GO:
+        for (std::size_t j = 0; j < count; ++j) dst[j] = float(a * std::max(lag1[j] - lag0[j], lead1[j] - lead0[j]));
+        break;
+    case Type::OS:
+        break;
+    }
+}
+
+void Cfar::thresholdOrdered(const float *power, std::size_t length, float *out, Workspace &ws) const
+{
+    const std::size_t n = std::size_t(half), g = std::size_t(cfg.guardCells);
+    const std::size_t first = std::min(length, n + g);
+    const std::size_t last = length > n + g ? length - n - g : 0;
+    const float inf = std::numeric_limits<float>::infinity();
+    std::fill(out, out + first, inf);
+    std::fill(out + std::max(first, last), out + length, inf);
+    if (last <= first) return;
+
+    // Satır kesimlerle işlenir: kSegment test hücresi ve iki yanındaki pencere
+    // bir kez (radix) sıralanıp sıra numarasına çevrilir. Pencere bu sıra
+    // üzerinde bir bit kümesidir; kesim kısa olduğundan küme yoğundur (N = 200
+    // için ~%4), komşu üye çoğunlukla aynı 64 bitlik sözcüktedir ve tüm yapı
+    // L1'de kalır. k. eleman (cur) her kaymada artımlı izlenir: below =
+    // pencerede cur'dan küçük eleman sayısı; dört güncellemeden sonra cur en
+    // fazla iki üye ileri/geri kayar.
+    constexpr std::size_t kSegment = 4096;
+    const std::ptrdiff_t k = rank;
+    const float a = float(alpha);
+    for (std::size_t s0 = first; s0 < last; s0 += kSegment) {
+        const std::size_t s1 = std::min(last, s0 + kSegment);
+        const std::size_t lo = s0 - g - n, span = s1 + g + n - lo;
+        sortIndices(power + lo, span, ws);
+        const std::size_t words = (span + 63) / 64;
+        ws.bits.assign(words, 0);
+        std::uint64_t *bits = ws.bits.data();
+        const std::uint32_t *rk = ws.rank.data();
+        const std::uint32_t *sorted = ws.sorted.data();
+        auto flip = [&](std::size_t r) { bits[r >> 6] ^= std::uint64_t(1) << (r & 63); };
+        auto member = [&](std::size_t r) { return (bits[r >> 6] >> (r & 63)) & 1u; };
+        // r'den büyük/küçük ilk üye (yoksa span / -1)
+        auto next = [&](std::size_t r) -> std::ptrdiff_t {
+            std::size_t w = (r + 1) >> 6;
+            if (w >= words) return std::ptrdiff_t(span);
+            std::uint64_t b = (r + 1) & 63 ? bits[w] & (~std::uint64_t(0) << ((r + 1) & 63)) : bits[w];
+            while (!b) {
+                if (++w == words) return std::ptrdiff_t(span);
+                b = bits[w];
+            }
+            return std::ptrdiff_t(w * 64 + lowestBit(b));
+        };
+        auto prev = [&](std::size_t r) -> std::ptrdiff_t {
+            if (r == 0) return -1;
+            std::ptrdiff_t w = std::ptrdiff_t((r - 1) >> 6);
+            std::uint64_t b = bits[w] & (~std::uint64_t(0) >> (63 - ((r - 1) & 63)));
+            while (!b) {
+                if (--w < 0) return -1;
+                b = bits[w];
+            }
+            return w * 64 + std::ptrdiff_t(highestBit(b));
+        };
+        // Değer sıralı anahtardan okunur (negatif güç 0'a kırpılmıştır)
+        auto valueAt = [&](std::ptrdiff_t r) {
+            float v;
+            std::memcpy(&v, &sorted[r], sizeof v);
+            return v;
+        };
+
+        // Kesim içi indisler: hücre c -> c - lo
+        const std::size_t f = s0 - lo;
+        for (std::size_t c = f - g - n; c < f - g; ++c) flip(rk[c]);
+        for (std::size_t c = f + g + 1; c < f + g + 1 + n; ++c) flip(rk[c]);
+        // Başlangıç: ilk üyeden k - 1 adım
+        auto lowest = [&]() -> std::ptrdiff_t { return member(0) ? 0 : next(0); };
+        std::ptrdiff_t cur = lowest();
+        std::ptrdiff_t below = 0;
+        while (below < k - 1) {
+            cur = next(std::size_t(cur));
+            ++below;
+        }
+
+        for (std::size_t i = f; i < s1 - lo; ++i) {
+            out[lo + i] = a * valueAt(cur);
+            if (i + 1 == s1 - lo) break;
+            // Pencere bir hücre kayar: her yanda bir çıkan, bir giren
+            const std::size_t removed[2] = {rk[i - g - n], rk[i + g + 1]};
+            const std::size_t added[2] = {rk[i - g], rk[i + g + 1 + n]};
+            bool lost = false;
+            // Sayaçlar dalsız: karşılaştırmalar rastgele, tahmin edilemez
+            for (std::size_t r : removed) {
+                flip(r);
+                below -= std::ptrdiff_t(r) < cur;
+                lost |= std::ptrdiff_t(r) == cur;
+            }
+            if (lost) {
+                // cur'dan küçüklerin sayısı değişmedi; bir sonraki üye aynı konumu
+                // alır, yoksa bir önceki (pencere boşaldıysa cur = -1)
+                const std::ptrdiff_t up = next(std::size_t(cur));
+                if (up < std::ptrdiff_t(span)) {
+                    cur = up;
+                } else {
+                    cur = prev(std::size_t(cur));
+                    below = cur < 0 ? 0 : below - 1;
+                }
+            }
+            for (std::size_t r : added) {
+                flip(r);
+                below += std::ptrdiff_t(r) < cur;
+            }
+            if (cur < 0) cur = lowest();
+            while (below < k - 1) {
+                cur = next(std::size_t(cur));
+                ++below;
+            }
+            while (below > k - 1) {
+                cur = prev(std::size_t(cur));
+                --below;
+            }
+        }
+    }
+}
+
+std::size_t Cfar::process(const float *power, std::size_t length, float *threshold,
+                          std::vector<Hit> &hits, Workspace &ws, std::uint32_t row) const
+{
+    float *out = threshold;
+    if (!out) {
+        ws.threshold.resize(length);
+        out = ws.threshold.data();
+    }
+    if (cfg.type == Type::OS) thresholdOrdered(power, length, out, ws);
+    else thresholdSums(power, length, out, ws);
+
+    const std::size_t before = hits.size();
+    for (std::size_t i = 0; i < length; ++i)
+        if (power[i] > out[i]) hits.push_back(Hit{row, std::uint32_t(i), power[i], out[i]});
+    return hits.size() - before;
+}
+
+std::size_t Cfar::processMap(const float *power, std::size_t rows, std::size_t length, float *threshold,
+                             std::vector<Hit> &hits, WorkStealingPool *pool)
+{
+    const std::size_t workers = pool ? std::size_t(pool->workerCount()) : 1;
+    if (workspaces.size() < workers) workspaces.resize(workers);
+    if (workerHits.size() < workers) workerHits.resize(workers);
+    for (auto &h : workerHits) h.clear();
+
+    auto run = [&](std::size_t begin, std::size_t end, int worker) {
+        for (std::size_t r = begin; r < end; ++r)
+            process(power + r * length, length, threshold ? threshold + r * length : nullptr,
+                    workerHits[std::size_t(worker)], workspaces[std::size_t(worker)], std::uint32_t(r));
+    };
+    if (pool && rows > 1) pool->parallelFor(rows, 1, run);
+    else run(0, rows, 0);
+
+    const std::size_t before = hits.size();
+    for (const auto &h : workerHits) hits.insert(hits.end(), h.begin(), h.end());
+    std::sort(hits.begin() + std::ptrdiff_t(before), hits.end(), [](const Hit &a, const Hit &b) {
+        return a.row != b.row ? a.row < b.row : a.cell < b.cell;
+    });
+    return hits.size() - before;
+}
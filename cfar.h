@@ -0,0 +1,89 @@
+#ifndef CFAR_H
+#define CFAR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "alignedbuffer.h"
+
+class WorkStealingPool;
+
+// CFAR dedektörü (kare yasa gücü, üstel gürültü varsayımı). Hücre başına eşik
+// T = α · Z; Z eğitim hücrelerinden kestirilir, α istenen Pfa'dan çözülür:
+//
+//   CA: Z = ΣL + ΣR              Pfa = (1 + α)^-N
+//   SO: Z = min(ΣL, ΣR)          GO: Z = max(ΣL, ΣR)   (Gandhi-Kassam, n = N/2)
+//   OS: Z = X(k) (k. küçük)      Pfa = Π_{i<k} (N - i) / (N - i + α)
+//
+// N eğitim hücresi test hücresinin iki yanına yarı yarıya bölünür, aralarında
+// guard hücreleri kalır. CA/SO/GO satır başına bir önek toplamıyla (double) ve
+// pencere boyundan bağımsız, vektörleşen bir döngüyle hesaplanır. OS için satır
+// 4096 hücrelik kesimlerde (pencere taşmasıyla) bir kez radix sıralanıp sıra
+// numarasına çevrilir; kayan pencere kesimin sıra bit kümesidir ve k. eleman
+// kaymalar boyunca artımlı izlenir (hücre başına 4 bit güncellemesi ve birkaç
+// komşu üyeye adım, yeniden sıralama yok). Kesim kısa tutulduğundan küme yoğun
+// ve L1'dedir; OS yine de sıralama bağımlıdır (~30 M hücre/s, CA/SO/GO ~400).
+// Pencerenin sığmadığı kenar hücrelerinde eşik +inf'tir (test edilmez).
+//
+// α (tür, N, k, Pfa) başına bir kez çözülür ve önbelleğe alınır.
+class Cfar
+{
+public:
+    enum class Type { CA, SO, GO, OS };
+
+    struct Settings {
+        Type type{Type::CA};
+        int trainingCells{200};         // toplam (iki yan)
+        int guardCells{2};              // her yanda
+        int osRank{100};                // 1..N
+        double pfa{1e-6};
+    };
+
+    struct Hit {
+        std::uint32_t row;
+        std::uint32_t cell;
+        float power;
+        float threshold;
+    };
+
+    struct Workspace {
+        std::vector<double> prefix;                 // CA/SO/GO
+        std::vector<std::uint64_t> items, tmpItems;  // OS: (değer, indis) radix
+        std::vector<std::uint32_t> rank, sorted, histogram; // OS: değer sırası
+        std::vector<std::uint64_t> bits;            // OS: pencere sıra kümesi
+        AlignedVector<float> threshold;
+    };
+
+    explicit Cfar(const Settings &settings);
+
+    const Settings &settings() const { return cfg; }
+    int trainingPerSide() const { return half; }
+    double multiplier() const { return alpha; }
+
+    // α'yı çözer (önbellekli, thread-safe). n: toplam eğitim hücresi.
+    static double thresholdMultiplier(Type type, int n, int rank, double pfa);
+
+    // Tek satır (güç). threshold verilirse doldurulur. Tespitler hits'e
+    // (row = row) eklenir; eklenen sayıyı döndürür.
+    std::size_t process(const float *power, std::size_t length, float *threshold,
+                        std::vector<Hit> &hits, Workspace &ws, std::uint32_t row = 0) const;
+
+    // rows x length harita (ör. Doppler satırları boyunca menzil), satırlar
+    // havuzda paralel. Tespitler (row, cell) sırasıyla. threshold nullptr olabilir.
+    // Çalışma alanları üyede: aynı nesnede eşzamanlı çağrılmaz.
+    std::size_t processMap(const float *power, std::size_t rows, std::size_t length, float *threshold,
+                           std::vector<Hit> &hits, WorkStealingPool *pool);
+
+private:
+    void thresholdSums(const float *power, std::size_t length, float *out, Workspace &ws) const;
+    void thresholdOrdered(const float *power, std::size_t length, float *out, Workspace &ws) const;
+
+    Settings cfg;
+    int half{1};                        // yan başına eğitim hücresi
+    int rank{1};                        // OS, 1..2 half
+    double alpha{1.0};
+    std::vector<Workspace> workspaces;
+    std::vector<std::vector<Hit>> workerHits;
+};
+
+#endif // CFAR_H
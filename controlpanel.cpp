@@ -10,30 +10,41 @@
 #include <QFont>
 #include <QDebug>
 #include <QSpinBox>
+#include <QComboBox>
 #include <QMessageBox>
-#include "geo.h"
 
 ControlPanel::ControlPanel(QWidget *parent)
     : QWidget(parent)
     , isRunning(false)
     , currentHz(10)
     , simulationTime(0.0)
+    , achievedSpeedUp(0.0)
 {
     setFixedHeight(160);
     setupUI();
     if (mainLayout) { mainLayout->setContentsMargins(10, 6, 10, 6); mainLayout->setSpacing(20); }
     
-    // Timer'ları başlat
-    elapsedTimeTimer = new QTimer(this);
-    connect(elapsedTimeTimer, &QTimer::timeout, this, &ControlPanel::updateElapsedTime);
-    
-    // Simulation timer'ı başlat
-    simulationTimer = new QTimer(this);
-    connect(simulationTimer, &QTimer::timeout, this, &ControlPanel::updateTargetPositions);
+    // Kinematik motoru kendi thread'inde; GUI'ye yalnızca snapshot gelir
+    engine = new SimEngine();
+    engineThread = new QThread(this);
+    engine->moveToThread(engineThread);
+    connect(engineThread, &QThread::started, engine, &SimEngine::run);
+    connect(engine, &SimEngine::stopped, engineThread, &QThread::quit);
+    connect(engine, &SimEngine::snapshotReady, this, &ControlPanel::onSnapshotReady, Qt::QueuedConnection);
 }
 
 ControlPanel::~ControlPanel()
 {
+    stopEngine();
+    delete engine;
+}
+
+void ControlPanel::stopEngine()
+{
+    if (!engineThread || !engineThread->isRunning()) return;
+    engine->requestStop();
+    engineThread->quit();
+    engineThread->wait();
 }
 
 void ControlPanel::setupUI()
@@ -45,6 +56,7 @@ void ControlPanel::setupUI()
     createCheckboxes();
     createHzControl();
     createControlButtons();
+    createTimeControl();
     createStatusDisplay();
     createElapsedTimeDisplay();
 }
@@ -100,11 +112,7 @@ void ControlPanel::createHzControl()
     hzLabel->setAlignment(Qt::AlignCenter);
     hzLayout->addWidget(hzLabel);
     
-    hzSpinBox = new QSpinBox();
-    hzSpinBox->setRange(1, 100);
-    hzSpinBox->setValue(currentHz);
-    hzSpinBox->setSuffix(" Hz");
-    hzSpinBox->setStyleSheet(
+    const QString spinStyle =
         "QSpinBox {"
         "    background-color: #2a2a2a;"
         "    color: #00ff00;"
@@ -112,9 +120,25 @@ void ControlPanel::createHzControl()
         "    border: 1px solid #555;"
         "    border-radius: 3px;"
         "    font-weight: bold;"
-        "}"
-    );
+        "}";
+
+    hzSpinBox = new QSpinBox();
+    hzSpinBox->setRange(1, 10000);
+    hzSpinBox->setValue(currentHz);
+    hzSpinBox->setSuffix(" Hz");
+    hzSpinBox->setToolTip("Physics step rate");
+    hzSpinBox->setStyleSheet(spinStyle);
     hzLayout->addWidget(hzSpinBox);
+
+    // Harita/ekran güncelleme hızı (fizik hızından bağımsız)
+    displayHzSpinBox = new QSpinBox();
+    displayHzSpinBox->setRange(1, 60);
+    displayHzSpinBox->setValue(30);
+    displayHzSpinBox->setPrefix("Display ");
+    displayHzSpinBox->setSuffix(" Hz");
+    displayHzSpinBox->setToolTip("Map refresh rate");
+    displayHzSpinBox->setStyleSheet(spinStyle);
+    hzLayout->addWidget(displayHzSpinBox);
     
     mainLayout->addWidget(hzGroup);
 }
@@ -179,6 +203,49 @@ void ControlPanel::createControlButtons()
     connect(stopButton, &QPushButton::clicked, this, &ControlPanel::onStopClicked);
 }
 
+void ControlPanel::createTimeControl()
+{
+    timeGroup = new QGroupBox("Time");
+    QVBoxLayout *timeLayout = new QVBoxLayout(timeGroup);
+    timeLayout->setContentsMargins(8, 4, 8, 4);
+    timeLayout->setSpacing(4);
+    timeGroup->setMinimumWidth(220);
+
+    // Fizik adımı sabit kalır; yalnızca adımların duvar saatine göre hızı değişir
+    timeScaleCombo = new QComboBox();
+    const double scales[] = {0.1, 0.5, 1.0, 2.0, 5.0, 10.0, 100.0, 1000.0};
+    for (double sc : scales) timeScaleCombo->addItem(QString("x%1").arg(sc), sc);
+    timeScaleCombo->addItem("As fast as possible", SimEngine::AsFastAsPossible);
+    timeScaleCombo->setCurrentIndex(timeScaleCombo->findData(1.0));
+    timeScaleCombo->setToolTip("Simulation time scale");
+    timeLayout->addWidget(timeScaleCombo);
+
+    QHBoxLayout *stepLayout = new QHBoxLayout();
+    stepLayout->setSpacing(4);
+    pauseButton = new QPushButton("Pause");
+    pauseButton->setCheckable(true);
+    pauseButton->setEnabled(false);
+    stepLayout->addWidget(pauseButton);
+
+    stepTicksSpinBox = new QSpinBox();
+    stepTicksSpinBox->setRange(1, 1000000);
+    stepTicksSpinBox->setValue(1);
+    stepTicksSpinBox->setSuffix(" ticks");
+    stepTicksSpinBox->setToolTip("Ticks to advance per Step while paused");
+    stepLayout->addWidget(stepTicksSpinBox);
+
+    stepButton = new QPushButton("Step");
+    stepButton->setEnabled(false);
+    stepLayout->addWidget(stepButton);
+    timeLayout->addLayout(stepLayout);
+
+    mainLayout->addWidget(timeGroup);
+
+    connect(timeScaleCombo, QOverload<int>::of(&QComboBox::currentIndexChanged), this, &ControlPanel::onTimeScaleChanged);
+    connect(pauseButton, &QPushButton::toggled, this, &ControlPanel::onPauseToggled);
+    connect(stepButton, &QPushButton::clicked, this, &ControlPanel::onStepClicked);
+}
+
 void ControlPanel::createStatusDisplay()
 {
     statusGroup = new QGroupBox("Status");
@@ -267,16 +334,23 @@ void ControlPanel::onStartClicked()
     startTime = QTime::currentTime();
     currentHz = hzSpinBox->value();
     simulationTime = 0.0;
-    
-    // Hz değerine göre timer'ları başlat
-    int interval = 1000 / currentHz;
-    // Elapsed time artık Hz'le aynı hızda güncellensin ve simulationTime göstersin
-    elapsedTimeTimer->start(interval);
-    simulationTimer->start(interval);
+    achievedSpeedUp = 0.0;
+    targetDetected.clear();
+    pauseButton->setChecked(false);
+    pauseButton->setEnabled(true);
+    stepButton->setEnabled(false);
     
     setRunningUI(true);
     
+    // Önce senaryo motoru beslensin (MainWindow::startSimulation), sonra thread başlasın
     emit startClicked();
+
+    stopEngine();
+    engine->setPhysicsHz(currentHz);
+    engine->setDisplayHz(displayHz());
+    engine->setTimeScale(timeScaleCombo->currentData().toDouble());
+    engine->setPaused(false);
+    engineThread->start(QThread::TimeCriticalPriority);
 }
 
 void ControlPanel::onStopClicked()
@@ -284,10 +358,12 @@ void ControlPanel::onStopClicked()
     isRunning = false;
     startButton->setEnabled(true);
     stopButton->setEnabled(false);
+    pauseButton->setChecked(false);
+    pauseButton->setEnabled(false);
+    stepButton->setEnabled(false);
     
-    // Timer'ları durdur
-    elapsedTimeTimer->stop();
-    simulationTimer->stop();
+    // Motoru durdur
+    stopEngine();
     
     setRunningUI(false);
     
@@ -297,7 +373,7 @@ void ControlPanel::onStopClicked()
 void ControlPanel::updateElapsedTime()
 {
     if (isRunning) {
-        // simulationTime'i göster (Hz'e bağlı artıyor)
+        // Simülasyon süresi (duvar saati değil) ve elde edilen hızlanma
         int totalSeconds = static_cast<int>(simulationTime);
         int hours = totalSeconds / 3600;
         int minutes = (totalSeconds % 3600) / 60;
@@ -307,172 +383,89 @@ void ControlPanel::updateElapsedTime()
             .arg(minutes, 2, 10, QChar('0'))
             .arg(seconds, 2, 10, QChar('0'));
         elapsedTimeDisplay->setText(timeStr);
+        elapsedTimeLabel->setText(QString("Sim Time (x%1)").arg(achievedSpeedUp, 0, 'f', achievedSpeedUp < 10.0 ? 2 : 0));
     }
 }
 
-void ControlPanel::updateTargetPositions()
+void ControlPanel::onTimeScaleChanged(int index)
 {
-    if (!isRunning) return;
-    
-    // Hz değerine göre delta time hesapla
-    double deltaTime = 1.0 / currentHz;
-    simulationTime += deltaTime;
-    
-    // Radar hareketini güncelle (tekil)
-    updateRadarPosition(deltaTime);
-
-    // Çoklu radarlar
-    for (auto it = radars.begin(); it != radars.end(); ++it) {
-        RadarKin &rk = it.value();
-        if (!rk.initialized) continue;
-        if (rk.nextWpIndex < rk.route.size()) {
-            const auto &wp = rk.route[rk.nextWpIndex];
-            double newLat, newLon, newAlt;
-            bool arrived = advanceTowardsWaypoint(rk.lat, rk.lon, rk.alt, wp,
-                                                  rk.velN, rk.velE, rk.velD,
-                                                  deltaTime, newLat, newLon, newAlt);
-            rk.lat = newLat; rk.lon = newLon; rk.alt = newAlt;
-            emit namedRadarPositionUpdated(it.key(), rk.lat, rk.lon, rk.alt);
-            if (arrived) { rk.velN = wp.velN; rk.velE = wp.velE; rk.velD = wp.velD; rk.nextWpIndex++; }
-        } else {
-            double newLat, newLon, newAlt; RadarRouteWaypoint dummy{rk.lat, rk.lon, rk.alt, 0,0,0};
-            advanceTowardsWaypoint(rk.lat, rk.lon, rk.alt, dummy, rk.velN, rk.velE, rk.velD, deltaTime, newLat, newLon, newAlt);
-            rk.lat = newLat; rk.lon = newLon; rk.alt = newAlt;
-            emit namedRadarPositionUpdated(it.key(), rk.lat, rk.lon, rk.alt);
-        }
-    }
-    
-    // Tüm target'ların pozisyonlarını güncelle
-    for (auto it = targets.begin(); it != targets.end(); ++it) {
-        updateTargetPosition(it.value(), deltaTime);
-    }
+    const double scale = timeScaleCombo->itemData(index).toDouble();
+    qDebug() << "Time scale:" << scale;
+    engine->setTimeScale(scale);
 }
 
-bool ControlPanel::advanceTowardsWaypoint(double curLat, double curLon, double curAlt,
-                                const RadarRouteWaypoint &wp,
-                                double velN, double velE, double velD,
-                                double deltaTime,
-                                double &outLat, double &outLon, double &outAlt)
-{
-    // ENU adımını uygula
-    double dE = velE * deltaTime;
-    double dN = velN * deltaTime;
-    double dU = -velD * deltaTime; // D aşağı (+) kabul: u = -D
-    double Xn, Yn, Zn;
-    Geo::enuToECEF(dE, dN, dU, curLat, curLon, curAlt, Xn, Yn, Zn);
-    double nlat, nlon, nalt;
-    Geo::ecefToGeodetic(Xn, Yn, Zn, nlat, nlon, nalt);
-
-    // Varış kontrolü (yakınsaklık): mevcut nokta ile hedef WP arasındaki mesafe < threshold?
-    double Xe, Ye, Ze, Xw, Yw, Zw;
-    Geo::geodeticToECEF(nlat, nlon, nalt, Xe, Ye, Ze);
-    Geo::geodeticToECEF(wp.lat, wp.lon, wp.alt, Xw, Yw, Zw);
-    double dist = std::sqrt((Xe-Xw)*(Xe-Xw) + (Ye-Yw)*(Ye-Yw) + (Ze-Zw)*(Ze-Zw));
-
-    outLat = nlat; outLon = nlon; outAlt = nalt;
-    return dist <= waypointArriveThresholdMeters;
-}
-
-void ControlPanel::updateRadarPosition(double deltaTime)
-{
-    if (!radar.initialized) return;
-
-    // Hedef WP var ise
-    if (radar.nextWpIndex < radar.route.size()) {
-        const auto &wp = radar.route[radar.nextWpIndex];
-        double newLat, newLon, newAlt;
-        bool arrived = advanceTowardsWaypoint(radar.lat, radar.lon, radar.alt,
-                                              wp, radar.velN, radar.velE, radar.velD,
-                                              deltaTime, newLat, newLon, newAlt);
-        radar.lat = newLat; radar.lon = newLon; radar.alt = newAlt;
-        emit radarPositionUpdated(radar.lat, radar.lon, radar.alt);
-        if (arrived) {
-            // WP hızlarını devral
-            radar.velN = wp.velN; radar.velE = wp.velE; radar.velD = wp.velD;
-            radar.nextWpIndex++;
-        }
-    } else {
-        // Son hızla devam
-        double newLat, newLon, newAlt;
-        RadarRouteWaypoint dummy{radar.lat, radar.lon, radar.alt, 0,0,0};
-        advanceTowardsWaypoint(radar.lat, radar.lon, radar.alt, dummy,
-                               radar.velN, radar.velE, radar.velD,
-                               deltaTime, newLat, newLon, newAlt);
-        radar.lat = newLat; radar.lon = newLon; radar.alt = newAlt;
-        emit radarPositionUpdated(radar.lat, radar.lon, radar.alt);
-    }
+void ControlPanel::onPauseToggled(bool paused)
+{
+    engine->setPaused(paused);
+    pauseButton->setText(paused ? "Resume" : "Pause");
+    stepButton->setEnabled(paused && isRunning);
+    setStatus(paused ? "Paused" : "Running");
 }
 
-void ControlPanel::updateTargetPosition(const Target &target, double deltaTime)
+void ControlPanel::onStepClicked()
 {
-    // ECEF state yoksa başlat
-    if (!targetStates.contains(target.name)) {
-        TargetState st;
-        st.lat = target.initLatitude;
-        st.lon = target.initLongitude;
-        st.alt = target.initAltitude;
-        st.velN = target.initVelocityN;
-        st.velE = target.initVelocityE;
-        st.velD = target.initVelocityD;
-        Geo::geodeticToECEF(st.lat, Geo::wrapLon(st.lon), st.alt, st.X, st.Y, st.Z);
-        targetStates[target.name] = st;
+    engine->requestSteps(stepTicksSpinBox->value());
+}
+
+void ControlPanel::onSnapshotReady(const SimSnapshot &snapshot)
+{
+    if (!isRunning) return;
+    simulationTime = snapshot.simTime;
+    achievedSpeedUp = snapshot.speedUp;
+
+    // Ekran hızında tek seferde yayınla
+    if (snapshot.radarValid) {
+        emit radarPositionUpdated(snapshot.radar.lat, snapshot.radar.lon, snapshot.radar.alt);
     }
-    TargetState &st = targetStates[target.name];
-
-    // Waypoint varsa, sıradaki WP'ye doğru ilerle
-    if (st.nextWpIndex < st.route.size()) {
-        const auto &wp = st.route[st.nextWpIndex];
-        double newLat, newLon, newAlt;
-        bool arrived = advanceTowardsWaypoint(st.lat, st.lon, st.alt, wp,
-                                              st.velN, st.velE, st.velD,
-                                              deltaTime, newLat, newLon, newAlt);
-        st.lat = newLat; st.lon = newLon; st.alt = newAlt;
-        emit targetPositionUpdated(target.name, st.lat, st.lon, st.alt);
-        if (arrived) {
-            // WP hızlarını devral
-            st.velN = wp.velN; st.velE = wp.velE; st.velD = wp.velD;
-            st.nextWpIndex++;
+    for (const auto &r : snapshot.radars) {
+        emit namedRadarPositionUpdated(r.name, r.lat, r.lon, r.alt);
+    }
+    for (const auto &t : snapshot.targets) {
+        emit targetPositionUpdated(t.name, t.lat, t.lon, t.alt);
+        auto it = targetDetected.find(t.name);
+        if (it == targetDetected.end()) {
+            if (!t.detected) continue;
+            targetDetected.insert(t.name, true);
+        } else if (it.value() != t.detected) {
+            it.value() = t.detected;
+        } else {
+            continue;
         }
-    } else {
-        // Son hızla devam
-        double newLat, newLon, newAlt;
-        RadarRouteWaypoint dummy{st.lat, st.lon, st.alt, 0,0,0};
-        advanceTowardsWaypoint(st.lat, st.lon, st.alt, dummy,
-                               st.velN, st.velE, st.velD,
-                               deltaTime, newLat, newLon, newAlt);
-        st.lat = newLat; st.lon = newLon; st.alt = newAlt;
-        emit targetPositionUpdated(target.name, st.lat, st.lon, st.alt);
+        emit targetDetectionChanged(t.name, t.detected);
     }
+    for (const auto &e : snapshot.detections) emit detectionEvent(e);
+    if (snapshot.detectionsDropped > 0) qDebug() << "Detection events dropped:" << snapshot.detectionsDropped;
+    updateElapsedTime();
 }
 
 void ControlPanel::addTarget(const Target &target)
 {
-    targets[target.name] = target;
-    // ECEF init
-    TargetState st;
-    st.lat = target.initLatitude;
-    st.lon = target.initLongitude;
-    st.alt = target.initAltitude;
-    Geo::geodeticToECEF(st.lat, Geo::wrapLon(st.lon), st.alt, st.X, st.Y, st.Z);
-    targetStates[target.name] = st;
+    engine->addTarget(target);
     qDebug() << "Added target:" << target.name << "to simulation";
 }
 
 void ControlPanel::removeTarget(const QString &targetName)
 {
-    if (targets.remove(targetName) > 0) {
-        targetStates.remove(targetName);
-        qDebug() << "Removed target:" << targetName << "from simulation";
-    }
+    engine->removeTarget(targetName);
+    qDebug() << "Removed target:" << targetName << "from simulation";
 }
 
 void ControlPanel::clearTargets()
 {
-    targets.clear();
-    targetStates.clear();
+    engine->clearTargets();
     qDebug() << "Cleared all targets from simulation";
 }
 
+void ControlPanel::addTerrainFiles(const QStringList &paths)
+{
+    for (const QString &path : paths) {
+        QString error;
+        if (!engine->addTerrainFile(path, &error)) qDebug() << "Terrain:" << error;
+    }
+    // Arazi yüklüyse radar-target görüş hattı her adımda hesaplanır
+    if (!engine->terrainCache()->files().isEmpty()) engine->setLineOfSightEnabled(true);
+}
+
 void ControlPanel::onShowDTEDAreasChanged(bool checked)
 {
     qDebug() << "Show DTED Areas:" << checked;
@@ -493,24 +486,32 @@ void ControlPanel::onShowTargetsTrajChanged(bool checked)
 
 void ControlPanel::setRadarInitialKinematics(double lat, double lon, double alt, double velN, double velE, double velD)
 {
-    radar.lat = lat; radar.lon = lon; radar.alt = alt;
-    radar.velN = velN; radar.velE = velE; radar.velD = velD;
-    radar.initialized = true;
+    engine->setRadarInitialKinematics(lat, lon, alt, velN, velE, velD);
 }
 
 void ControlPanel::setRadarRoute(const QVector<RadarRouteWaypoint> &route)
 {
-    radar.route = route;
-    radar.nextWpIndex = 0;
+    engine->setRadarRoute(route);
 }
 
 void ControlPanel::setTargetRoute(const QString &targetName, const QVector<RadarRouteWaypoint> &route)
 {
-    if (!targetStates.contains(targetName)) {
-        TargetState st; targetStates[targetName] = st;
-    }
-    targetStates[targetName].route = route;
-    targetStates[targetName].nextWpIndex = 0;
+    engine->setTargetRoute(targetName, route);
+}
+
+void ControlPanel::setPropagationSettings(const PropagationSettings &settings)
+{
+    engine->setPropagationSettings(settings);
+}
+
+void ControlPanel::setRadarParameters(const RadarParameters &parameters)
+{
+    engine->setRadarParameters(parameters);
+}
+
+void ControlPanel::setWeatherCells(const QVector<WeatherCell> &cells)
+{
+    engine->setWeatherCells(cells);
 }
 
 int ControlPanel::hz() const
@@ -518,10 +519,15 @@ int ControlPanel::hz() const
     return hzSpinBox ? hzSpinBox->value() : currentHz;
 }
 
-void ControlPanel::addRadarProfile(const QString &name, double lat, double lon, double alt, double velN, double velE, double velD, const QVector<RadarRouteWaypoint> &route)
+int ControlPanel::displayHz() const
+{
+    return displayHzSpinBox ? displayHzSpinBox->value() : 30;
+}
+
+void ControlPanel::addRadarProfile(const QString &name, double lat, double lon, double alt, double velN, double velE, double velD, const QVector<RadarRouteWaypoint> &route,
+                                   const RadarParameters &parameters)
 {
-    RadarKin rk; rk.lat = lat; rk.lon = lon; rk.alt = alt; rk.velN = velN; rk.velE = velE; rk.velD = velD; rk.route = route; rk.nextWpIndex = 0; rk.initialized = true;
-    radars[name] = rk;
+    engine->addRadarProfile(name, lat, lon, alt, velN, velE, velD, route, parameters);
 }
 
 void ControlPanel::setStatus(const QString &status)
@@ -11,8 +11,11 @@
 #include <QTime>
 #include <QTimer>
 #include <QSpinBox>
+#include <QComboBox>
 #include <QMap>
+#include <QThread>
 #include "mapwidget.h"
+#include "simengine.h"
 
 class ControlPanel : public QWidget
 {
@@ -26,6 +29,7 @@ public:
     void addTarget(const Target &target);
     void removeTarget(const QString &targetName);
     void clearTargets();
+    void addTerrainFiles(const QStringList &paths);
 
 signals:
     void startClicked();
@@ -36,6 +40,9 @@ signals:
     void targetPositionUpdated(const QString &targetName, double lat, double lon, double alt);
     void radarPositionUpdated(double lat, double lon, double alt);
     void namedRadarPositionUpdated(const QString &radarName, double lat, double lon, double alt);
+    // Radar denklemi: çift bazında tespit/kayıp ve target'ın (herhangi bir radarca) tespit durumu
+    void detectionEvent(const SimDetectionEvent &event);
+    void targetDetectionChanged(const QString &targetName, bool detected);
 
 private slots:
     void onStartClicked();
@@ -44,18 +51,28 @@ private slots:
     void onShowWeatherConditionsChanged(bool checked);
     void onShowTargetsTrajChanged(bool checked);
     void updateElapsedTime();
-    void updateTargetPositions();
+    void onTimeScaleChanged(int index);
+    void onPauseToggled(bool paused);
+    void onStepClicked();
+    void onSnapshotReady(const SimSnapshot &snapshot);
 
 public:
     void setRadarInitialKinematics(double lat, double lon, double alt, double velN, double velE, double velD);
     void setRadarRoute(const QVector<RadarRouteWaypoint> &route);
     void setTargetRoute(const QString &targetName, const QVector<RadarRouteWaypoint> &route);
+    void setPropagationSettings(const PropagationSettings &settings);
+    void setRadarParameters(const RadarParameters &parameters);
+    void setWeatherCells(const QVector<WeatherCell> &cells);
     int hz() const; // current Hz at start
+    int displayHz() const; // UI yayın hızı
     bool calculateWeatherEnabled() const { return false; }
+    // Canlı kinematikten sentetik IQ hedefleri (EchoGenerator); motor kilidiyle
+    std::vector<EchoGenerator::Target> echoTargets(int radar = 0) const { return engine->echoTargets(radar); }
     bool showTargetsTrajEnabled() const { return showTargetsTrajCheckBox ? showTargetsTrajCheckBox->isChecked() : false; }
 
     // Multi-radar API
-    void addRadarProfile(const QString &name, double lat, double lon, double alt, double velN, double velE, double velD, const QVector<RadarRouteWaypoint> &route);
+    void addRadarProfile(const QString &name, double lat, double lon, double alt, double velN, double velE, double velD, const QVector<RadarRouteWaypoint> &route,
+                         const RadarParameters &parameters = RadarParameters());
 
     // UI mode
     void setRunningUI(bool running);
@@ -65,15 +82,10 @@ private:
     void createCheckboxes();
     void createHzControl();
     void createControlButtons();
+    void createTimeControl();
     void createStatusDisplay();
     void createElapsedTimeDisplay();
-    void updateTargetPosition(const Target &target, double deltaTime);
-    void updateRadarPosition(double deltaTime);
-    bool advanceTowardsWaypoint(double curLat, double curLon, double curAlt,
-                                const RadarRouteWaypoint &wp,
-                                double velN, double velE, double velD,
-                                double deltaTime,
-                                double &outLat, double &outLon, double &outAlt);
+    void stopEngine();
 
     // UI bileşenleri
     QHBoxLayout *mainLayout;
@@ -95,10 +107,18 @@ private:
     // Hz kontrolü
     QLabel *hzLabel;
     QSpinBox *hzSpinBox;
+    QSpinBox *displayHzSpinBox;
     
     // Kontrol butonları
     QPushButton *startButton;
     QPushButton *stopButton;
+
+    // Zaman ölçeği / duraklat / N adım (çalışırken de görünür)
+    QGroupBox *timeGroup;
+    QComboBox *timeScaleCombo;
+    QPushButton *pauseButton;
+    QSpinBox *stepTicksSpinBox;
+    QPushButton *stepButton;
     
     // Durum gösterimi
     QLabel *statusLabel;
@@ -109,46 +129,15 @@ private:
     QLabel *elapsedTimeDisplay;
     
     bool isRunning;
-    QTimer *elapsedTimeTimer;
-    QTimer *simulationTimer;  // Target simulation için
     QTime startTime;
     int currentHz;
-    
-    // Target simulation için
-    QMap<QString, Target> targets;
-    double simulationTime;  // Simülasyon süresi (saniye)
-
-    struct TargetState {
-        double X{0.0};
-        double Y{0.0};
-        double Z{0.0};
-        double lat{0.0};
-        double lon{0.0};
-        double alt{0.0};
-        double velN{0.0};
-        double velE{0.0};
-        double velD{0.0};
-        QVector<RadarRouteWaypoint> route;
-        int nextWpIndex{0};
-    };
-    QMap<QString, TargetState> targetStates;
-
-    // Radar kinematikleri
-    struct RadarKin {
-        double lat{0.0};
-        double lon{0.0};
-        double alt{0.0};
-        double velN{0.0};
-        double velE{0.0};
-        double velD{0.0};
-        QVector<RadarRouteWaypoint> route;
-        int nextWpIndex{0};
-        bool initialized{false};
-    } radar;
-
-    QMap<QString, RadarKin> radars; // multi-radar
+    double simulationTime;  // Simülasyon süresi (saniye), son snapshot'tan
+    double achievedSpeedUp; // sim/duvar oranı, son snapshot'tan
+    QHash<QString, bool> targetDetected;    // yalnızca değişimler yayınlanır
 
-    double waypointArriveThresholdMeters{10.0};
+    // Kinematik motoru ve çalıştığı thread
+    SimEngine *engine;
+    QThread *engineThread;
 };
 
 #endif // CONTROLPANEL_H
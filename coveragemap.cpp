@@ -0,0 +1,202 @@
+#include "coveragemap.h"
+#include "terraincache.h"
+#include "terrainmodel.h"
+#include "workstealingpool.h"
+#include <QFile>
+#include <QFileInfo>
+#include <QDir>
+#include <QSaveFile>
+#include <QDateTime>
+#include <QDataStream>
+#include <QCryptographicHash>
+#include <QDebug>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace {
+
+struct CoverageHeader {
+    char magic[8];
+    double lat;
+    double lon;
+    double alt;
+    double rangeStep;
+    double altitudeStep;
+    qint32 azimuthBins;
+    qint32 rangeBins;
+    qint32 altitudeLevels;
+    qint32 reserved;
+};
+static_assert(sizeof(CoverageHeader) == 64, "coverage header must stay 64 bytes");
+constexpr char kCoverageMagic[8] = {'R', 'D', 'R', 'C', 'O', 'V', '0', '1'};
+
+// Izgara üst sınırı (~32 MB); aşılırsa menzil adımı büyütülür
+constexpr qint64 kMaxCells = qint64(1) << 24;
+
+// Dış menzilde azimut yayı menzil adımını geçmesin
+int azimuthBinsFor(const CoverageMap::Settings &s)
+{
+    const double bins = std::ceil(2.0 * Geo::pi * s.maxDistance / s.distanceStep);
+    return std::clamp(static_cast<int>(bins), 360, 3600);
+}
+
+} // namespace
+
+CoverageMap::CoverageMap(const Los::Endpoint &radar, int azimuthBins, int rangeBins, double rangeStep,
+                         int altitudeLevels, double altitudeStep)
+    : origin(radar)
+    , azBins(azimuthBins)
+    , rBins(rangeBins)
+    , rStep(rangeStep)
+    , levels(altitudeLevels)
+    , altStep(altitudeStep)
+    , firstLevel(std::size_t(azimuthBins) * rangeBins, quint16(altitudeLevels))
+{
+    const double la = radar.lat * Geo::deg2rad, lo = radar.lon * Geo::deg2rad;
+    ux = std::cos(la) * std::cos(lo);
+    uy = std::cos(la) * std::sin(lo);
+    uz = std::sin(la);
+    ex = -std::sin(lo);
+    ey = std::cos(lo);
+    nx = -std::sin(la) * std::cos(lo);
+    ny = -std::sin(la) * std::sin(lo);
+    nz = std::cos(la);
+}
+
+std::shared_ptr<const CoverageMap> CoverageMap::build(TerrainTileCache &terrain, WorkStealingPool &pool,
+                                                      const Los::Endpoint &radar, const Settings &settings,
+                                                      const Los::Params &params)
+{
+    const int az = azimuthBinsFor(settings);
+    int rangeBins = std::max(1, static_cast<int>(std::ceil(settings.maxDistance / settings.distanceStep)));
+    if (qint64(az) * rangeBins > kMaxCells) rangeBins = static_cast<int>(kMaxCells / az);
+    const double rangeStep = settings.maxDistance / rangeBins;
+    const int levels = std::min(65535, static_cast<int>(std::floor(settings.maxAltitude / settings.altitudeStep)) + 1);
+
+    std::shared_ptr<CoverageMap> map(new CoverageMap(radar, az, rangeBins, rangeStep, levels, settings.altitudeStep));
+
+    std::vector<std::unique_ptr<Los::Scratch>> scratch(pool.workerCount());
+    std::vector<std::vector<float>> heights(pool.workerCount());
+
+    pool.parallelFor(std::size_t(az), 4, [&](std::size_t begin, std::size_t end, int worker) {
+        if (!scratch[worker]) {
+            scratch[worker] = std::make_unique<Los::Scratch>();
+            heights[worker].resize(std::size_t(rangeBins));
+        }
+        // Reader parça kapsamında; tüm derleme boyunca epoch'u tutmaz
+        TerrainTileCache::Reader reader(terrain);
+        auto sampler = [&reader](const Terrain::Arc &arc, float *out, std::size_t n) {
+            TerrainModel::heightsOnArc(reader, arc, out, n);
+        };
+        float *h = heights[worker].data();
+        for (std::size_t a = begin; a < end; ++a) {
+            Los::minVisibleHeights(radar, 360.0 * a / az, rangeStep, rangeBins, params, sampler, *scratch[worker], h);
+            quint16 *row = map->firstLevel.data() + a * std::size_t(rangeBins);
+            for (int r = 0; r < rangeBins; ++r) {
+                // Yukarı yuvarla: kademe görünürse gerçek irtifa da görünür
+                const double k = std::ceil(std::max(0.0, double(h[r])) / settings.altitudeStep);
+                row[r] = static_cast<quint16>(std::min(k, double(levels)));
+            }
+        }
+    });
+    return map;
+}
+
+int CoverageMap::visibility(const Los::Endpoint &target) const
+{
+    const double la = target.lat * Geo::deg2rad, lo = target.lon * Geo::deg2rad;
+    const double cl = std::cos(la);
+    const double vx = cl * std::cos(lo), vy = cl * std::sin(lo), vz = std::sin(la);
+    const double dx = vx - ux, dy = vy - uy, dz = vz - uz;
+    const double chord = std::sqrt(dx * dx + dy * dy + dz * dz);
+    const double dist = 2.0 * Los::earthRadius * std::asin(std::min(1.0, 0.5 * chord));
+
+    // En yakın menzil düğümü (düğüm k, (k+1)*rStep menzilindedir)
+    const int r = static_cast<int>(std::lround(dist / rStep)) - 1;
+    if (r >= rBins || target.alt > (levels - 1) * altStep) return -1;
+    if (r < 0) return 1;
+
+    double az = std::atan2(dx * ex + dy * ey, dx * nx + dy * ny + dz * nz) * Geo::rad2deg;
+    if (az < 0.0) az += 360.0;
+    const int a = static_cast<int>(std::lround(az * azBins / 360.0)) % azBins;
+
+    const int k = firstLevel[std::size_t(a) * rBins + r];
+    if (k >= levels) return 0;
+    return target.alt >= k * altStep ? 1 : 0;
+}
+
+QByteArray CoverageMap::cacheKey(TerrainTileCache &terrain, const Los::Endpoint &radar,
+                                 const Settings &settings, const Los::Params &params)
+{
+    QByteArray blob;
+    QDataStream ds(&blob, QIODevice::WriteOnly);
+    // Konum ~1 cm / 1 mm çözünürlükte; kayan nokta gürültüsü anahtarı bozmasın
+    ds << qint64(std::llround(radar.lat * 1e7)) << qint64(std::llround(radar.lon * 1e7))
+       << qint64(std::llround(radar.alt * 1e3));
+    ds << settings.maxAltitude << settings.maxDistance << settings.altitudeStep << settings.distanceStep;
+    ds << params.sampleSpacing << params.kFactor << params.minAntennaAgl << params.clearance;
+    QStringList files = terrain.files();
+    files.sort();
+    for (const QString &f : files) {
+        const QFileInfo fi(f);
+        ds << f << fi.size() << fi.lastModified().toMSecsSinceEpoch();
+    }
+    return QCryptographicHash::hash(blob, QCryptographicHash::Sha1).toHex().left(20);
+}
+
+std::shared_ptr<const CoverageMap> CoverageMap::loadOrBuild(TerrainTileCache &terrain, WorkStealingPool &pool,
+                                                            const Los::Endpoint &radar, const Settings &settings,
+                                                            const Los::Params &params, const QString &cacheDir,
+                                                            bool *fromDisk)
+{
+    const QString path = QDir(cacheDir).filePath(QString::fromLatin1(cacheKey(terrain, radar, settings, params)) + ".cov");
+    if (auto map = load(path)) {
+        if (fromDisk) *fromDisk = true;
+        return map;
+    }
+    if (fromDisk) *fromDisk = false;
+    auto map = build(terrain, pool, radar, settings, params);
+    QDir().mkpath(cacheDir);
+    if (!map->save(path)) qDebug() << "Coverage cache not written:" << path;
+    return map;
+}
+
+std::shared_ptr<const CoverageMap> CoverageMap::load(const QString &path)
+{
+    QFile f(path);
+    if (!f.open(QIODevice::ReadOnly) || f.size() < qint64(sizeof(CoverageHeader))) return nullptr;
+    CoverageHeader hdr;
+    if (f.read(reinterpret_cast<char *>(&hdr), sizeof(hdr)) != qint64(sizeof(hdr))) return nullptr;
+    if (std::memcmp(hdr.magic, kCoverageMagic, sizeof(kCoverageMagic)) != 0
+        || hdr.azimuthBins < 1 || hdr.rangeBins < 1 || hdr.altitudeLevels < 1
+        || f.size() != qint64(sizeof(hdr)) + qint64(hdr.azimuthBins) * hdr.rangeBins * qint64(sizeof(quint16)))
+        return nullptr;
+
+    std::shared_ptr<CoverageMap> map(new CoverageMap(Los::Endpoint{hdr.lat, hdr.lon, hdr.alt}, hdr.azimuthBins,
+                                                     hdr.rangeBins, hdr.rangeStep, hdr.altitudeLevels, hdr.altitudeStep));
+    const qint64 bytes = qint64(map->firstLevel.size() * sizeof(quint16));
+    if (f.read(reinterpret_cast<char *>(map->firstLevel.data()), bytes) != bytes) return nullptr;
+    return map;
+}
+
+bool CoverageMap::save(const QString &path) const
+{
+    CoverageHeader hdr{};
+    std::memcpy(hdr.magic, kCoverageMagic, sizeof(kCoverageMagic));
+    hdr.lat = origin.lat;
+    hdr.lon = origin.lon;
+    hdr.alt = origin.alt;
+    hdr.rangeStep = rStep;
+    hdr.altitudeStep = altStep;
+    hdr.azimuthBins = azBins;
+    hdr.rangeBins = rBins;
+    hdr.altitudeLevels = levels;
+
+    const qint64 bytes = qint64(firstLevel.size() * sizeof(quint16));
+    QSaveFile out(path);
+    return out.open(QIODevice::WriteOnly)
+        && out.write(reinterpret_cast<const char *>(&hdr), sizeof(hdr)) == qint64(sizeof(hdr))
+        && out.write(reinterpret_cast<const char *>(firstLevel.data()), bytes) == bytes
+        && out.commit();
+}
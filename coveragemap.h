@@ -0,0 +1,75 @@
+#ifndef COVERAGEMAP_H
+#define COVERAGEMAP_H
+
+#include <QString>
+#include <QByteArray>
+#include <memory>
+#include <vector>
+#include "lineofsight.h"
+
+class TerrainTileCache;
+class WorkStealingPool;
+
+// Sabit bir radarın 360° görüş (LOS) haritası: azimut x menzil x irtifa ızgarası.
+//
+// LOS görünürlüğü hedef irtifasında monotondur (daha yüksek hedef daha az
+// engellenir), bu yüzden ızgara her (azimut, menzil) hücresinde yalnızca ilk
+// görünür irtifa kademesini tutar (uint16). Hesap azimut dilimleri üzerinden
+// paralel yürür (Los::minVisibleHeights); sonuç radar konumu, ayarlar ve DTED
+// kümesiyle anahtarlanmış küçük bir dosyada saklanır, aynı radar için sonraki
+// koşular yalnızca dosyayı okur. Hedef sorgusu O(1)'dir.
+class CoverageMap
+{
+public:
+    struct Settings {
+        double maxAltitude{10000.0};    // m (ızgara 0..maxAltitude)
+        double maxDistance{100000.0};   // m
+        double altitudeStep{100.0};     // m
+        double distanceStep{1000.0};    // m
+    };
+
+    // Izgarayı hesaplar (pool'daki tüm worker'larla)
+    static std::shared_ptr<const CoverageMap> build(TerrainTileCache &terrain, WorkStealingPool &pool,
+                                                    const Los::Endpoint &radar, const Settings &settings,
+                                                    const Los::Params &params);
+    // cacheDir'de aynı anahtarlı dosya varsa okur, yoksa hesaplayıp yazar
+    static std::shared_ptr<const CoverageMap> loadOrBuild(TerrainTileCache &terrain, WorkStealingPool &pool,
+                                                          const Los::Endpoint &radar, const Settings &settings,
+                                                          const Los::Params &params, const QString &cacheDir,
+                                                          bool *fromDisk = nullptr);
+
+    static std::shared_ptr<const CoverageMap> load(const QString &path);
+    bool save(const QString &path) const;
+
+    // 1: görünür, 0: görünmez, -1: ızgara dışı (menzil ya da irtifa aşıldı)
+    int visibility(const Los::Endpoint &target) const;
+
+    const Los::Endpoint &radar() const { return origin; }
+    int azimuthBins() const { return azBins; }
+    int rangeBins() const { return rBins; }
+    int altitudeLevels() const { return levels; }
+    double rangeStep() const { return rStep; }
+    double altitudeStep() const { return altStep; }
+
+private:
+    CoverageMap(const Los::Endpoint &radar, int azimuthBins, int rangeBins, double rangeStep,
+                int altitudeLevels, double altitudeStep);
+
+    static QByteArray cacheKey(TerrainTileCache &terrain, const Los::Endpoint &radar,
+                               const Settings &settings, const Los::Params &params);
+
+    Los::Endpoint origin;
+    int azBins;
+    int rBins;
+    double rStep;
+    int levels;          // irtifa kademeleri: k * altStep, k = 0..levels-1
+    double altStep;
+
+    // Radar birim vektörü ve yerel kuzey/doğu eksenleri (sorgu için)
+    double ux, uy, uz, ex, ey, nx, ny, nz;
+
+    // [az * rBins + r] = ilk görünür kademe; levels: ızgarada hiç görünmez
+    std::vector<quint16> firstLevel;
+};
+
+#endif // COVERAGEMAP_H
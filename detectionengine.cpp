@@ -0,0 +1,106 @@
+#include "detectionengine.h"
+#include "workstealingpool.h"
+#include <algorithm>
+#include <chrono>
+
+namespace {
+
+// Bir iş parçasındaki hedef sayısı
+constexpr std::size_t kTargetBlock = 4096;
+
+} // namespace
+
+void DetectionEngine::resize(std::size_t radars, std::size_t targets)
+{
+    if (radars == radarCount && targets == targetCount) return;
+    std::vector<unsigned char> moved(radars * targets, 0);
+    const std::size_t nr = std::min(radars, radarCount), nt = std::min(targets, targetCount);
+    for (std::size_t r = 0; r < nr; ++r)
+        std::copy_n(detected.begin() + r * targetCount, nt, moved.begin() + r * targets);
+    detected.swap(moved);
+    radarCount = radars;
+    targetCount = targets;
+}
+
+void DetectionEngine::removeTarget(std::size_t t)
+{
+    if (t >= targetCount) return;
+    const std::size_t last = targetCount - 1;
+    for (std::size_t r = 0; r < radarCount; ++r) detected[r * targetCount + t] = detected[r * targetCount + last];
+    resize(radarCount, last);
+}
+
+void DetectionEngine::reset()
+{
+    detected.assign(detected.size(), 0);
+}
+
+void DetectionEngine::compute(const std::vector<Radar> &radars,
+                              const double *targetX, const double *targetY, const double *targetZ,
+                              const float *rcsDb, std::size_t targets,
+                              const unsigned char *visible, const float *propagationDb,
+                              WorkStealingPool *pool,
+                              std::vector<float> &snr, std::vector<Event> &events)
+{
+    using Clock = std::chrono::steady_clock;
+    const auto t0 = Clock::now();
+
+    const std::size_t nr = radars.size(), nt = targets;
+    resize(nr, nt);
+    const std::size_t pairs = nr * nt;
+    snr.resize(pairs);
+    next.resize(pairs);
+
+    // Hücre zayıflaması radar frekansına bağlı, adım başına bir kez
+    const std::size_t nc = weather.size();
+    cellLoss.resize(nr * nc);
+    for (std::size_t r = 0; r < nr; ++r)
+        for (std::size_t c = 0; c < nc; ++c) cellLoss[r * nc + c] = RadarEq::dbPerKm(weather[c], radars[r].frequencyGHz) * 1e-3;
+
+    const std::size_t blocks = (nt + kTargetBlock - 1) / kTargetBlock;
+    auto run = [&](std::size_t begin, std::size_t end, int) {
+        for (std::size_t item = begin; item < end; ++item) {
+            const std::size_t r = item / blocks;
+            const std::size_t t0b = (item % blocks) * kTargetBlock;
+            const std::size_t n = std::min(kTargetBlock, nt - t0b);
+            const Radar &rd = radars[r];
+            const std::size_t row = r * nt + t0b;
+            float *out = snr.data() + row;
+
+            RadarEq::rangeRow(rd.X, rd.Y, rd.Z, static_cast<float>(rd.constantDb),
+                              targetX + t0b, targetY + t0b, targetZ + t0b, rcsDb + t0b, n, out);
+            if (propagationDb) RadarEq::propagationRow(propagationDb + row, n, out);
+            for (std::size_t c = 0; c < nc; ++c)
+                RadarEq::cellRow(weather[c], cellLoss[r * nc + c], rd.X, rd.Y, rd.Z,
+                                 targetX + t0b, targetY + t0b, targetZ + t0b, n, out);
+
+            const float threshold = static_cast<float>(rd.thresholdDb);
+            unsigned char *det = next.data() + row;
+            if (visible) {
+                const unsigned char *vis = visible + row;
+                for (std::size_t i = 0; i < n; ++i) det[i] = static_cast<unsigned char>((out[i] >= threshold) & (vis[i] != 0));
+            } else {
+                for (std::size_t i = 0; i < n; ++i) det[i] = static_cast<unsigned char>(out[i] >= threshold);
+            }
+        }
+    };
+    const std::size_t items = nr * blocks;
+    if (pool && pairs >= kParallelPairs) pool->parallelFor(items, 1, run);
+    else run(0, items, 0);
+
+    // Durum değişimleri (olaylar seyrek; tarama bayt karşılaştırması)
+    stats = Stats{};
+    for (std::size_t r = 0; r < nr; ++r) {
+        const std::size_t row = r * nt;
+        for (std::size_t t = 0; t < nt; ++t) {
+            const unsigned char d = next[row + t];
+            stats.detected += d;
+            if (d == detected[row + t]) continue;
+            events.push_back(Event{int(r), int(t), d != 0, snr[row + t]});
+            ++stats.events;
+        }
+    }
+    detected.swap(next);
+    stats.pairs = pairs;
+    stats.milliseconds = std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+}
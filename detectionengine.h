@@ -0,0 +1,77 @@
+#ifndef DETECTIONENGINE_H
+#define DETECTIONENGINE_H
+
+#include <cstddef>
+#include <vector>
+#include "radarequation.h"
+
+class WorkStealingPool;
+
+// Radar x target SNR matrisi ve tespit durumu. Her adımda tüm çiftler radar
+// denklemiyle (RadarEq) yeniden değerlendirilir; hedefler SoA (ECEF + RCS)
+// verilir, radar satırları havuzda hedef bloklarına bölünerek paralel işlenir.
+//
+// Çift başına tespit durumu saklanır; SNR eşiği geçildiğinde ya da düştüğünde
+// (veya görüş hattı değiştiğinde) olay üretilir. Durum matrisi varlık
+// ekleme/silmesine resize() ve removeTarget() ile eşlenir.
+class DetectionEngine
+{
+public:
+    struct Radar {
+        double X{0.0}, Y{0.0}, Z{0.0};  // ECEF
+        double frequencyGHz{3.0};
+        double constantDb{0.0};         // RadarEq::constantDb
+        double thresholdDb{10.0};
+    };
+
+    struct Event {
+        int radar;
+        int target;
+        bool detected;                  // false: tespit kaybedildi
+        float snrDb;
+    };
+
+    struct Stats {
+        std::size_t pairs{0};
+        std::size_t detected{0};
+        std::size_t events{0};
+        double milliseconds{0.0};
+    };
+
+    // Bundan az çiftte havuz kullanılmaz
+    static constexpr std::size_t kParallelPairs = 16384;
+
+    // Hava hücreleri (boş: zayıflama yok)
+    void setWeather(const std::vector<RadarEq::Cell> &cells) { weather = cells; }
+
+    // Durumu (radars x targets) korunarak yeniden boyutlandırır; yeni çiftler tespitsiz
+    void resize(std::size_t radars, std::size_t targets);
+    // Hedef t silindi, son hedef t'ye taşındı (EntityStore::removeSwap ile aynı)
+    void removeTarget(std::size_t t);
+    void reset();
+
+    // snr[r * nt + t] doldurulur, durum değişimleri events'e eklenir.
+    // visible (LOS, 0: engelli) ve propagationDb (F, dB) yoksa nullptr.
+    // pool verilmezse ya da çift sayısı küçükse tek thread'de çalışır.
+    void compute(const std::vector<Radar> &radars,
+                 const double *targetX, const double *targetY, const double *targetZ,
+                 const float *rcsDb, std::size_t targets,
+                 const unsigned char *visible, const float *propagationDb,
+                 WorkStealingPool *pool,
+                 std::vector<float> &snr, std::vector<Event> &events);
+
+    // [r * nt + t] = 1: son compute()'ta tespit var
+    const std::vector<unsigned char> &state() const { return detected; }
+    const Stats &lastStats() const { return stats; }
+
+private:
+    std::vector<RadarEq::Cell> weather;
+    std::size_t radarCount{0};
+    std::size_t targetCount{0};
+    std::vector<unsigned char> detected;
+    std::vector<unsigned char> next;
+    std::vector<double> cellLoss;       // [r * cells + c] dB/m
+    Stats stats;
+};
+
+#endif // DETECTIONENGINE_H
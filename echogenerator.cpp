@@ -0,0 +1,259 @@
+#include "echogenerator.h"
+#include "geo.h"
+#include "radarequation.h"
+#include "workstealingpool.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+#if defined(_MSC_VER)
+#define EG_RESTRICT __restrict
+#else
+#define EG_RESTRICT __restrict__
+#endif
+
+namespace {
+
+constexpr double kTwoPi = 2.0 * RadarEq::kPi;
+
+// 32 bit karıştırıcı (lowbias32): birebir, çarpmalar 32 bit, vektörleşir
+inline std::uint32_t mix32(std::uint32_t x)
+{
+    x ^= x >> 16;
+    x *= 0x7feb352du;
+    x ^= x >> 15;
+    x *= 0x846ca68bu;
+    x ^= x >> 16;
+    return x;
+}
+
+// Karmaşık Gauss gürültü (E|n|² = 1), Box-Muller: |n|² = -ln u1 üstel,
+// açı x = 2π u2 - π. sin/cos y = x/2 üzerinde Taylor (|y| <= π/2, hata < 1e-7)
+// ve çift açı formülüyle; dallanmasız, derleyicide vektörleşir.
+void gaussianNoise(float *EG_RESTRICT re, float *EG_RESTRICT im, std::size_t count,
+                   std::uint32_t key, std::uint32_t first)
+{
+    for (std::size_t i = 0; i < count; ++i) {
+        const std::uint32_t c = 2u * (first + std::uint32_t(i));
+        const std::uint32_t h1 = mix32(key + c), h2 = mix32(key + c + 1u);
+        const float u1 = (float(h1 >> 8) + 0.5f) * (1.0f / 16777216.0f);
+        const float u2 = float(h2 >> 8) * (1.0f / 16777216.0f);
+        const float r = std::sqrt(-RadarEq::fastLog2(u1) * 0.69314718f);
+        const float y = (u2 - 0.5f) * 3.14159265f, y2 = y * y;
+        const float s = y * (1.0f - y2 * (1.0f / 6.0f - y2 * (1.0f / 120.0f - y2 * (1.0f / 5040.0f
+                        - y2 * (1.0f / 362880.0f - y2 * (1.0f / 39916800.0f))))));
+        const float co = 1.0f - y2 * (0.5f - y2 * (1.0f / 24.0f - y2 * (1.0f / 720.0f - y2 * (1.0f / 40320.0f
+                         - y2 * (1.0f / 3628800.0f - y2 * (1.0f / 479001600.0f))))));
+        re[i] = r * (co * co - s * s);
+        im[i] = r * (2.0f * s * co);
+    }
+}
+
+// out[i] += g · ((1 - mu) u[i + 1] + mu u[i])
+void addEcho(float *EG_RESTRICT outRe, float *EG_RESTRICT outIm,
+             const float *EG_RESTRICT uRe, const float *EG_RESTRICT uIm, std::size_t count,
+             float mu, float gRe, float gIm)
+{
+    const float a = 1.0f - mu;
+    for (std::size_t i = 0; i < count; ++i) {
+        const float xr = a * uRe[i + 1] + mu * uRe[i];
+        const float xi = a * uIm[i + 1] + mu * uIm[i];
+        outRe[i] += gRe * xr - gIm * xi;
+        outIm[i] += gRe * xi + gIm * xr;
+    }
+}
+
+// NED hız -> ECEF
+inline void velocityEcef(double lat, double lon, double vN, double vE, double vD,
+                         double &vX, double &vY, double &vZ)
+{
+    double sl, cl, slon, clon;
+    Geo::Fast::sincos(lat * Geo::deg2rad, sl, cl);
+    Geo::Fast::sincos(lon * Geo::deg2rad, slon, clon);
+    const double u = -vD;
+    vX = -slon * vE - sl * clon * vN + cl * clon * u;
+    vY =  clon * vE - sl * slon * vN + cl * slon * u;
+    vZ =  cl * vN + sl * u;
+}
+
+} // namespace
+
+EchoGenerator::EchoGenerator(const Settings &settings, WorkStealingPool *workerPool)
+    : cfg(settings)
+    , wf(Wf::get(settings.waveform))
+    , pool(workerPool)
+{
+    cfg.prfHz = std::max(cfg.prfHz, 1.0);
+    cfg.ringPulses = std::max<std::size_t>(cfg.ringPulses, 1);
+    cfg.rangeBlock = std::max<std::size_t>(cfg.rangeBlock, 256);
+    if (cfg.schedule) {
+        const std::vector<double> &prfs = cfg.schedule->settings().prfHz;
+        priSamples = wf->sampleRateHz / *std::min_element(prfs.begin(), prfs.end());
+    } else {
+        priSamples = wf->sampleRateHz / cfg.prfHz;
+    }
+    bins = cfg.rangeBins ? cfg.rangeBins : std::max<std::size_t>(std::size_t(std::ceil(priSamples)), 1);
+    blocks = (bins + cfg.rangeBlock - 1) / cfg.rangeBlock;
+    constantDb = RadarEq::constantDb(cfg.txPeakW, cfg.frequencyHz, 1.0 / wf->sampleRateHz, cfg.gainDbi,
+                                     cfg.noiseFigureDb, cfg.temperatureK, cfg.lossDb, 1.0);
+    shiftStride = (wf->samples + 2 + 15) & ~std::size_t(15);
+    ringRe.assign(cfg.ringPulses * bins, 0.0f);
+    ringIm.assign(cfg.ringPulses * bins, 0.0f);
+}
+
+double EchoGenerator::rangePerBin() const
+{
+    return 0.5 * RadarEq::kLightSpeed / wf->sampleRateHz;
+}
+
+void EchoGenerator::setTargets(const std::vector<Target> &targets)
+{
+    targetList = targets;
+    epoch = head;
+    epochTime = pulse(std::size_t(head - tail)).time;
+    const std::size_t nt = targets.size(), m = wf->samples;
+    if (shiftedRe.size() < nt * shiftStride) {
+        shiftedRe.resize(nt * shiftStride);
+        shiftedIm.resize(nt * shiftStride);
+    }
+    echoes.reserve(cfg.ringPulses * nt);
+
+    // Darbe içi Doppler: u[j + 1] = s[j] e^{jωj}, ω = 2π f_D / fs
+    const double lambda = RadarEq::kLightSpeed / std::max(cfg.frequencyHz, 1.0);
+    for (std::size_t t = 0; t < nt; ++t) {
+        const double w = kTwoPi * 2.0 * targets[t].radialVelocity / lambda / wf->sampleRateHz;
+        float *EG_RESTRICT ur = shiftedRe.data() + t * shiftStride;
+        float *EG_RESTRICT ui = shiftedIm.data() + t * shiftStride;
+        const float *EG_RESTRICT sr = wf->re.data();
+        const float *EG_RESTRICT si = wf->im.data();
+        for (std::size_t j = 0; j < m; ++j) {
+            double s, c;
+            Geo::Fast::sincos(w * double(j), s, c);
+            ur[j + 1] = float(sr[j] * c - si[j] * s);
+            ui[j + 1] = float(sr[j] * s + si[j] * c);
+        }
+        std::fill(ur, ur + 1, 0.0f);
+        std::fill(ui, ui + 1, 0.0f);
+        std::fill(ur + m + 1, ur + shiftStride, 0.0f);
+        std::fill(ui + m + 1, ui + shiftStride, 0.0f);
+    }
+}
+
+void EchoGenerator::kinematics(const Platform &radar,
+                               const double *X, const double *Y, const double *Z,
+                               const double *lat, const double *lon,
+                               const double *velN, const double *velE, const double *velD,
+                               const float *rcsDb, std::size_t n, std::vector<Target> &out)
+{
+    out.resize(n);
+    double rX, rY, rZ;
+    velocityEcef(radar.lat, radar.lon, radar.velN, radar.velE, radar.velD, rX, rY, rZ);
+    for (std::size_t i = 0; i < n; ++i) {
+        double vX, vY, vZ;
+        velocityEcef(lat[i], lon[i], velN[i], velE[i], velD[i], vX, vY, vZ);
+        const double dx = X[i] - radar.X, dy = Y[i] - radar.Y, dz = Z[i] - radar.Z;
+        const double range = std::sqrt(dx * dx + dy * dy + dz * dz);
+        const double closing = -(dx * (vX - rX) + dy * (vY - rY) + dz * (vZ - rZ)) / std::max(range, 1e-3);
+        out[i] = Target{range, closing, rcsDb ? rcsDb[i] : 0.0f};
+    }
+}
+
+std::size_t EchoGenerator::generate(std::size_t count)
+{
+    using Clock = std::chrono::steady_clock;
+    count = std::min(count, cfg.ringPulses - available());
+    if (count == 0) return 0;
+    const auto t0 = Clock::now();
+
+    // (darbe, hedef) gecikme, kesir ve karmaşık genlik: skaler ön geçiş
+    const std::size_t nt = targetList.size();
+    const double fs = wf->sampleRateHz, f0 = std::max(cfg.frequencyHz, 1.0);
+    echoes.resize(count * nt);
+    batchFirst = head;
+    for (std::size_t p = 0; p < count; ++p) {
+        double t = double(head + p - epoch) / cfg.prfHz, pri = priSamples, lambda = RadarEq::kLightSpeed / f0, gainDb = 0.0;
+        if (cfg.schedule) {
+            // Çizelge tablosundan: gönderim anı, PRI ve taşıyıcı (genlik λ²)
+            const PulseScheduler::Pulse sp = cfg.schedule->pulse(head + p);
+            t = sp.time - epochTime;
+            pri = fs / sp.prfHz;
+            lambda = RadarEq::kLightSpeed / sp.frequencyHz;
+            gainDb = 20.0 * std::log10(f0 / sp.frequencyHz);
+        }
+        for (std::size_t i = 0; i < nt; ++i) {
+            Echo &e = echoes[p * nt + i];
+            const Target &tg = targetList[i];
+            const double range = tg.range - tg.radialVelocity * t;
+            if (!(range > 1.0)) {
+                e = Echo{std::int64_t(bins), 0.0f, 0.0f, 0.0f};
+                continue;
+            }
+            double delay = 2.0 * range / RadarEq::kLightSpeed * fs;
+            delay -= std::floor(delay / pri) * pri;
+            const double start = std::floor(delay);
+            const double amp = std::pow(10.0, (constantDb + gainDb + tg.rcsDb - 40.0 * std::log10(range)) / 20.0);
+            const double phase = -std::fmod(4.0 * RadarEq::kPi * range / lambda, kTwoPi);
+            e = Echo{std::int64_t(start), float(delay - start), float(amp * std::cos(phase)), float(amp * std::sin(phase))};
+        }
+    }
+
+    const std::size_t tiles = count * blocks;
+    auto run = [&](std::size_t begin, std::size_t end, int) {
+        for (std::size_t k = begin; k < end; ++k) renderTile(k / blocks, k % blocks);
+    };
+    if (pool && tiles > 1) pool->parallelFor(tiles, 1, run);
+    else run(0, tiles, 0);
+
+    head += count;
+    counters.pulses += count;
+    counters.milliseconds += std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+    return count;
+}
+
+void EchoGenerator::renderTile(std::size_t p, std::size_t block)
+{
+    const std::uint64_t k = batchFirst + p;
+    const std::size_t slot = std::size_t(k % cfg.ringPulses);
+    const std::size_t b0 = block * cfg.rangeBlock, b1 = std::min(b0 + cfg.rangeBlock, bins);
+    float *re = ringRe.data() + slot * bins + b0;
+    float *im = ringIm.data() + slot * bins + b0;
+
+    if (cfg.noise) {
+        const std::uint32_t key = mix32(cfg.seed ^ mix32(std::uint32_t(k) ^ mix32(std::uint32_t(k >> 32) + 0x9e3779b9u)));
+        gaussianNoise(re, im, b1 - b0, key, std::uint32_t(b0));
+    } else {
+        std::fill(re, re + (b1 - b0), 0.0f);
+        std::fill(im, im + (b1 - b0), 0.0f);
+    }
+
+    // Yankı örnekleri [start, start + M], karo ile kesişen kısım
+    const std::size_t nt = targetList.size();
+    const std::int64_t span = std::int64_t(wf->samples) + 1;
+    const Echo *echo = echoes.data() + p * nt;
+    for (std::size_t t = 0; t < nt; ++t) {
+        const Echo &e = echo[t];
+        const std::int64_t lo = std::max<std::int64_t>(std::int64_t(b0), e.start);
+        const std::int64_t hi = std::min<std::int64_t>(std::int64_t(b1), e.start + span);
+        if (lo >= hi) continue;
+        const std::size_t m = std::size_t(lo - e.start);
+        addEcho(re + (lo - std::int64_t(b0)), im + (lo - std::int64_t(b0)),
+                shiftedRe.data() + t * shiftStride + m, shiftedIm.data() + t * shiftStride + m,
+                std::size_t(hi - lo), e.mu, e.gRe, e.gIm);
+    }
+}
+
+EchoGenerator::Pulse EchoGenerator::pulse(std::size_t i) const
+{
+    const std::uint64_t k = tail + i;
+    const std::size_t slot = std::size_t(k % cfg.ringPulses);
+    if (cfg.schedule) {
+        const PulseScheduler::Pulse sp = cfg.schedule->pulse(k);
+        return Pulse{k, sp.time, sp.prf, ringRe.data() + slot * bins, ringIm.data() + slot * bins};
+    }
+    return Pulse{k, double(k) / cfg.prfHz, 0, ringRe.data() + slot * bins, ringIm.data() + slot * bins};
+}
+
+void EchoGenerator::release(std::size_t count)
+{
+    tail += std::min<std::uint64_t>(count, head - tail);
+}
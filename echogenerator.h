@@ -0,0 +1,137 @@
+#ifndef ECHOGENERATOR_H
+#define ECHOGENERATOR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "alignedbuffer.h"
+#include "pulsescheduler.h"
+#include "waveform.h"
+
+class WorkStealingPool;
+
+// Sentetik ham IQ üreteci: her darbe için menzil satırı (darbe gönderiminden
+// itibaren rangeBins örnek) = hedef yankıları + termal gürültü.
+//
+// Yankı, dalga biçiminin 2R/c gecikmeli (kesirli kısım doğrusal aradeğerle),
+// e^{-j4πR/λ} fazlı ve darbe içinde f_D = 2 v_r / λ kaydırılmış kopyasıdır;
+// R darbeden darbeye R0 - v_r t ile ilerler (menzil göçü). Gecikme PRI'ye göre
+// katlanır (ikinci tur yankıları). Genlik tek darbe radar denkleminden gelir:
+// örnekler örnek başına gürültü gücüne (k T F fs) normalize edilir, gürültü
+// E|n|² = 1 karmaşık Gauss'tur. Çizelge verilirse darbe başına PRI ve taşıyıcı
+// (λ, faz, genlik) PulseScheduler tablosundan indeksle okunur; darbe içi
+// Doppler kaydırması merkez frekansla hesaplanır. Gürültü (seed, darbe,
+// örnek) sayacından üretildiği için çıktı thread sayısından bağımsızdır.
+//
+// Darbeler kurulumda ayrılan halka tampona (ringPulses satır) yazılır;
+// generate() (darbe, menzil bloğu) karolarını iş çalan havuzda paralel üretir,
+// tüketici pulse()/release() ile okur. Doppler kaydırılmış dalga biçimleri
+// setTargets()'ta hedef başına bir kez hesaplanır; ısınmadan sonra darbe
+// yolunda bellek ayırma yoktur. Üretici ve tüketici aynı thread'dedir.
+class EchoGenerator
+{
+public:
+    struct Settings {
+        Wf::Settings waveform;
+        double prfHz{750.0};
+        std::size_t rangeBins{0};           // 0: PRI · fs (katlanmasız tüm PRI; çizelgede en uzun PRI)
+        std::shared_ptr<const PulseScheduler> schedule;  // nullptr: sabit PRF ve frequencyHz
+        double txPeakW{8000.0};
+        double frequencyHz{3.0e9};
+        double gainDbi{20.0};
+        double noiseFigureDb{3.0};
+        double temperatureK{290.0};
+        double lossDb{2.0};
+        bool noise{true};
+        std::uint32_t seed{1};
+        std::size_t ringPulses{256};
+        std::size_t rangeBlock{4096};       // paralel karo genişliği (örnek)
+    };
+
+    struct Target {
+        double range;                       // m, setTargets() anındaki darbede
+        double radialVelocity;              // m/s, yaklaşan pozitif
+        float rcsDb;                        // dBsm
+    };
+
+    // Radar / hedef kinematiği: ECEF konum, geodezik lat/lon (ENU tabanı) ve NED hız
+    struct Platform {
+        double X{0.0}, Y{0.0}, Z{0.0};
+        double lat{0.0}, lon{0.0};          // derece
+        double velN{0.0}, velE{0.0}, velD{0.0};
+    };
+
+    struct Pulse {
+        std::uint64_t index;                // üretilen darbe sayacı (çizelge indeksi)
+        double time;                        // s, gönderim anı
+        int prf;                            // çizelgenin PRF indeksi (çizelgesiz 0)
+        const float *re;
+        const float *im;
+    };
+
+    struct Stats {
+        std::uint64_t pulses{0};
+        double milliseconds{0.0};           // generate() toplamı
+    };
+
+    // pool nullptr ise karolar çağıran thread'de sırayla üretilir
+    EchoGenerator(const Settings &settings, WorkStealingPool *pool);
+
+    const Settings &settings() const { return cfg; }
+    const Wf::Waveform &waveform() const { return *wf; }
+    double sampleRateHz() const { return wf->sampleRateHz; }
+    std::size_t rangeBins() const { return bins; }
+    double rangePerBin() const;
+
+    // Hedefleri değiştirir; menziller sıradaki üretilecek darbeye aittir
+    void setTargets(const std::vector<Target> &targets);
+
+    // Hedef satırı: radar (ECEF, NED) ile n hedef (SoA) arası menzil ve radyal hız
+    static void kinematics(const Platform &radar,
+                           const double *X, const double *Y, const double *Z,
+                           const double *lat, const double *lon,
+                           const double *velN, const double *velE, const double *velD,
+                           const float *rcsDb, std::size_t n, std::vector<Target> &out);
+
+    // En fazla count darbe üretir (halkadaki boş yer kadar), üretilen sayıyı döndürür
+    std::size_t generate(std::size_t count);
+    // Okunmamış darbe sayısı; pulse(0) en eskisi
+    std::size_t available() const { return std::size_t(head - tail); }
+    Pulse pulse(std::size_t i) const;
+    void release(std::size_t count);
+
+    const Stats &stats() const { return counters; }
+
+private:
+    struct Echo {                           // (darbe, hedef) başına
+        std::int64_t start;                 // ilk örnek (kesirli gecikmenin tabanı)
+        float mu;                           // kesirli gecikme
+        float gRe, gIm;                     // genlik · e^{jφ}
+    };
+
+    void renderTile(std::size_t pulse, std::size_t block);
+
+    Settings cfg;
+    std::shared_ptr<const Wf::Waveform> wf;
+    WorkStealingPool *pool{nullptr};
+    std::size_t bins{0};
+    std::size_t blocks{0};
+    double priSamples{0.0};
+    double constantDb{0.0};                 // RadarEq::constantDb, τ = 1 / fs
+
+    std::size_t shiftStride{0};             // M + 2, 16'ya yuvarlı
+    std::vector<Target> targetList;
+    std::uint64_t epoch{0};                 // targetList menzillerinin darbesi
+    double epochTime{0.0};
+    AlignedVector<float> shiftedRe, shiftedIm;  // [t * stride + m + 1], baş/son sıfır
+    std::vector<Echo> echoes;               // [batch darbe * hedef]
+    std::uint64_t batchFirst{0};
+
+    AlignedVector<float> ringRe, ringIm;    // [slot * rangeBins + r]
+    std::uint64_t head{0};                  // sıradaki üretilecek darbe
+    std::uint64_t tail{0};                  // en eski okunmamış darbe
+    Stats counters;
+};
+
+#endif // ECHOGENERATOR_H
@@ -0,0 +1,198 @@
+#include "entitystore.h"
+#include "geo.h"
+#include <cmath>
+
+namespace {
+
+// Konum += taban · (ENU hız · dt) ve tazeleme bayrağı. Ayrı fonksiyon: restrict
+// parametreler ve döngüde dal / çağrı olmaması sayesinde GCC -O3 -mavx2 ile
+// vektörleştirir (-fopt-info-vec). D aşağı (+) kabul: u = -D.
+void integrate(std::size_t m, double dt, double refresh2,
+               double *GEO_RESTRICT px, double *GEO_RESTRICT py, double *GEO_RESTRICT pz,
+               double *GEO_RESTRICT ph, unsigned char *GEO_RESTRICT flag,
+               const double *GEO_RESTRICT vn, const double *GEO_RESTRICT ve, const double *GEO_RESTRICT vd,
+               const double *GEO_RESTRICT sl, const double *GEO_RESTRICT cl,
+               const double *GEO_RESTRICT so, const double *GEO_RESTRICT co,
+               const double *GEO_RESTRICT ax, const double *GEO_RESTRICT ay, const double *GEO_RESTRICT az)
+{
+    for (std::size_t i = 0; i < m; ++i) {
+        const double e = ve[i] * dt;
+        const double nn = vn[i] * dt;
+        const double u = -vd[i] * dt;
+        px[i] += -so[i] * e - sl[i] * co[i] * nn + cl[i] * co[i] * u;
+        py[i] +=  co[i] * e - sl[i] * so[i] * nn + cl[i] * so[i] * u;
+        pz[i] +=                 cl[i] * nn        + sl[i] * u;
+        ph[i] += u;
+        const double dx = px[i] - ax[i], dy = py[i] - ay[i], dz = pz[i] - az[i];
+        flag[i] = (dx*dx + dy*dy + dz*dz > refresh2) ? 1 : 0;
+    }
+}
+
+} // namespace
+
+void EntityStore::reserve(int n)
+{
+    const std::size_t m = static_cast<std::size_t>(n);
+    X.reserve(m); Y.reserve(m); Z.reserve(m);
+    lat.reserve(m); lon.reserve(m); alt.reserve(m);
+    velN.reserve(m); velE.reserve(m); velD.reserve(m);
+    cursor.reserve(m); routeEnd.reserve(m); routeBegin.reserve(m);
+    sinLat.reserve(m); cosLat.reserve(m); sinLon.reserve(m); cosLon.reserve(m);
+    anchorX.reserve(m); anchorY.reserve(m); anchorZ.reserve(m);
+    hInt.reserve(m);
+}
+
+void EntityStore::clear()
+{
+    X.clear(); Y.clear(); Z.clear();
+    lat.clear(); lon.clear(); alt.clear();
+    velN.clear(); velE.clear(); velD.clear();
+    cursor.clear(); routeEnd.clear(); routeBegin.clear();
+    sinLat.clear(); cosLat.clear(); sinLon.clear(); cosLon.clear();
+    anchorX.clear(); anchorY.clear(); anchorZ.clear();
+    hInt.clear();
+    waypoints.clear();
+    liveWaypoints = 0;
+    geodeticDirty = false;
+}
+
+int EntityStore::add(double latDeg, double lonDeg, double altM,
+                     double vN, double vE, double vD)
+{
+    X.push_back(0.0); Y.push_back(0.0); Z.push_back(0.0);
+    lat.push_back(0.0); lon.push_back(0.0); alt.push_back(0.0);
+    velN.push_back(0.0); velE.push_back(0.0); velD.push_back(0.0);
+    sinLat.push_back(0.0); cosLat.push_back(1.0); sinLon.push_back(0.0); cosLon.push_back(1.0);
+    anchorX.push_back(0.0); anchorY.push_back(0.0); anchorZ.push_back(0.0);
+    hInt.push_back(0.0);
+    const int wpEnd = static_cast<int>(waypoints.size());
+    routeBegin.push_back(wpEnd);
+    cursor.push_back(wpEnd);
+    routeEnd.push_back(wpEnd);
+
+    const int i = size() - 1;
+    setKinematics(i, latDeg, lonDeg, altM, vN, vE, vD);
+    return i;
+}
+
+int EntityStore::removeSwap(int i)
+{
+    const int last = size() - 1;
+    if (i < 0 || i > last) return -1;
+    liveWaypoints -= static_cast<std::size_t>(routeEnd[i] - routeBegin[i]);
+    auto mv = [i, last](auto &v) { v[i] = v[last]; v.pop_back(); };
+    mv(X); mv(Y); mv(Z);
+    mv(lat); mv(lon); mv(alt);
+    mv(velN); mv(velE); mv(velD);
+    mv(cursor); mv(routeBegin); mv(routeEnd);
+    mv(sinLat); mv(cosLat); mv(sinLon); mv(cosLon);
+    mv(anchorX); mv(anchorY); mv(anchorZ);
+    mv(hInt);
+    return (i == last) ? -1 : last;
+}
+
+void EntityStore::setKinematics(int i, double latDeg, double lonDeg, double altM,
+                                double vN, double vE, double vD)
+{
+    lat[i] = latDeg; lon[i] = Geo::wrapLon(lonDeg); alt[i] = altM;
+    velN[i] = vN; velE[i] = vE; velD[i] = vD;
+    hInt[i] = altM;
+    Geo::geodeticToECEF(lat[i], lon[i], altM, X[i], Y[i], Z[i]);
+    refreshBasis(i);
+}
+
+void EntityStore::refreshBasis(int i)
+{
+    // ECEF -> geodetic; irtifa integre edilen değere oturtulur, böylece eski
+    // teğet düzlemde ilerlemekten gelen d^2/2R tırmanma birikmez.
+    double la, lo, h;
+    Geo::ecefToGeodetic(X[i], Y[i], Z[i], la, lo, h);
+    double sl, cl, slon, clon;
+    Geo::Fast::sincos(la * Geo::deg2rad, sl, cl);
+    Geo::Fast::sincos(lo * Geo::deg2rad, slon, clon);
+    const double N = Geo::a / std::sqrt(1.0 - Geo::e2 * sl*sl);
+    const double hh = hInt[i];
+    X[i] = (N + hh) * cl * clon;
+    Y[i] = (N + hh) * cl * slon;
+    Z[i] = (N * (1.0 - Geo::e2) + hh) * sl;
+    sinLat[i] = sl; cosLat[i] = cl; sinLon[i] = slon; cosLon[i] = clon;
+    anchorX[i] = X[i]; anchorY[i] = Y[i]; anchorZ[i] = Z[i];
+    lat[i] = la; lon[i] = lo; alt[i] = hh;
+}
+
+void EntityStore::setRoute(int i, const std::vector<EntityWaypoint> &route)
+{
+    liveWaypoints -= static_cast<std::size_t>(routeEnd[i] - routeBegin[i]);
+    // Eski aralık havuzda yetim kalır; yarıdan fazlası yetimse sıkıştır
+    if (waypoints.size() > 2 * liveWaypoints + 64) compactWaypoints();
+
+    const int begin = static_cast<int>(waypoints.size());
+    for (EntityWaypoint wp : route) {
+        Geo::geodeticToECEF(wp.lat, Geo::wrapLon(wp.lon), wp.alt, wp.X, wp.Y, wp.Z);
+        waypoints.push_back(wp);
+    }
+    routeBegin[i] = begin;
+    cursor[i] = begin;
+    routeEnd[i] = static_cast<int>(waypoints.size());
+    liveWaypoints += route.size();
+}
+
+void EntityStore::compactWaypoints()
+{
+    std::vector<EntityWaypoint> packed;
+    packed.reserve(liveWaypoints);
+    for (int i = 0; i < size(); ++i) {
+        const int begin = static_cast<int>(packed.size());
+        for (int k = routeBegin[i]; k < routeEnd[i]; ++k) packed.push_back(waypoints[k]);
+        cursor[i] = begin + (cursor[i] - routeBegin[i]);
+        routeBegin[i] = begin;
+        routeEnd[i] = static_cast<int>(packed.size());
+    }
+    waypoints.swap(packed);
+}
+
+void EntityStore::step(double deltaTime, double arriveThresholdMeters)
+{
+    const int n = size();
+    lastRefreshCount = 0;
+    if (n == 0) return;
+    const std::size_t m = static_cast<std::size_t>(n);
+    if (refreshFlag.size() < m) refreshFlag.resize(m);
+
+    // ENU adımı önbellekli tabanla doğrudan ECEF'e (trig yok, dalsız; vektörleşir)
+    integrate(m, deltaTime, basisRefreshDistance * basisRefreshDistance,
+              X.data(), Y.data(), Z.data(), hInt.data(), refreshFlag.data(),
+              velN.data(), velE.data(), velD.data(),
+              sinLat.data(), cosLat.data(), sinLon.data(), cosLon.data(),
+              anchorX.data(), anchorY.data(), anchorZ.data());
+    geodeticDirty = true;
+
+    // Varış kontrolü: ECEF konum ile önbellekli WP ECEF'i arasındaki mesafe
+    const double thr2 = arriveThresholdMeters * arriveThresholdMeters;
+    for (int i = 0; i < n; ++i) {
+        const int c = cursor[i];
+        if (c >= routeEnd[i]) continue;
+        const EntityWaypoint &wp = waypoints[c];
+        const double dx = X[i] - wp.X, dy = Y[i] - wp.Y, dz = Z[i] - wp.Z;
+        if (dx*dx + dy*dy + dz*dz <= thr2) {
+            // WP hızlarını devral
+            velN[i] = wp.velN; velE[i] = wp.velE; velD[i] = wp.velD;
+            cursor[i] = c + 1;
+        }
+    }
+
+    // Yeterince uzaklaşan varlıkların tabanını tazele (seyrek)
+    for (int i = 0; i < n; ++i) {
+        if (!refreshFlag[i]) continue;
+        refreshBasis(i);
+        ++lastRefreshCount;
+    }
+}
+
+void EntityStore::syncGeodetic()
+{
+    if (!geodeticDirty) return;
+    Geo::ecefToGeodeticBatch(X.data(), Y.data(), Z.data(), lat.data(), lon.data(), alt.data(),
+                             static_cast<std::size_t>(size()));
+    geodeticDirty = false;
+}
@@ -0,0 +1,104 @@
+#ifndef ENTITYSTORE_H
+#define ENTITYSTORE_H
+
+#include <vector>
+#include <cstddef>
+
+// Rota noktası (simülasyon içi, ECEF önbellekli)
+struct EntityWaypoint {
+    double lat{0.0};
+    double lon{0.0};
+    double alt{0.0};
+    double velN{0.0};
+    double velE{0.0};
+    double velD{0.0};
+    double X{0.0};   // ECEF, setRoute sırasında bir kez hesaplanır
+    double Y{0.0};
+    double Z{0.0};
+};
+
+// Structure-of-arrays varlık tablosu. Her alan ayrı, bitişik bir dizide tutulur;
+// adım döngüsü isimle arama yapmadan 0..size()-1 üzerinde doğrusal ilerler.
+// İsim -> indeks eşlemesi bu sınıfın dışında, yalnızca kenarlarda (ekleme/silme/
+// yayın) kullanılır. Silme "swap-with-last" ile yapılır, diziler boşluksuz kalır.
+//
+// Durum ECEF'tedir. Her varlık için ENU tabanı (sin/cos lat/lon) önbellekte
+// tutulur ve yalnızca varlık son tazelemeden beri basisRefreshDistance'tan
+// fazla yer değiştirdiğinde yeniden hesaplanır; aradaki adımlar trig içermez.
+// Tazelemede konum, ayrıca integre edilen irtifaya (hInt) oturtulur.
+//
+// Hata bütçesi (d = tazeleme mesafesi, R ~ 6.37e6 m):
+//   irtifa   : tazelemeler arasında <= d^2 / 2R   (d = 100 m için 0.8 mm)
+//   yatay    : eski tabanla büyük daire boyunca ilerleme nedeniyle, D metre
+//              uçuşta <= D * d * tan(|lat|) / 2R   (d = 100 m, 100 km, 45° için ~0.8 m)
+// Geodezik diziler (lat/lon/alt) tembel güncellenir: syncGeodetic() sonrası geçerlidir.
+class EntityStore
+{
+public:
+    int size() const { return static_cast<int>(X.size()); }
+    bool empty() const { return X.empty(); }
+    void reserve(int n);
+    void clear();
+
+    // Yeni varlık ekler, indeksini döndürür
+    int add(double latDeg, double lonDeg, double altM,
+            double vN, double vE, double vD);
+
+    // i'yi siler; son eleman i'ye taşınır. Taşınan elemanın eski indeksini
+    // döndürür (i son elemansa -1).
+    int removeSwap(int i);
+
+    void setKinematics(int i, double latDeg, double lonDeg, double altM,
+                       double vN, double vE, double vD);
+    void setRoute(int i, const std::vector<EntityWaypoint> &route);
+    int remainingWaypoints(int i) const { return routeEnd[i] - cursor[i]; }
+
+    void setBasisRefreshDistance(double meters) { basisRefreshDistance = meters; }
+    double basisRefreshDistanceMeters() const { return basisRefreshDistance; }
+    // Son step() içinde ENU tabanı tazelenen varlık sayısı
+    int lastBasisRefreshCount() const { return lastRefreshCount; }
+
+    // Tüm varlıkları bir adım ilerletir (ENU Euler + WP varış kontrolü)
+    void step(double deltaTime, double arriveThresholdMeters);
+
+    // ECEF -> lat/lon/alt (yalnızca adım atıldıysa, toplu)
+    void syncGeodetic();
+
+    // ECEF durum
+    std::vector<double> X;
+    std::vector<double> Y;
+    std::vector<double> Z;
+
+    // Geodezik görünüm (syncGeodetic() sonrası geçerli)
+    std::vector<double> lat;
+    std::vector<double> lon;
+    std::vector<double> alt;
+
+    std::vector<double> velN;
+    std::vector<double> velE;
+    std::vector<double> velD;
+    std::vector<int> cursor;     // sıradaki WP (waypoints içindeki mutlak indeks)
+    std::vector<int> routeEnd;   // rotanın bitişi (exclusive)
+
+private:
+    void compactWaypoints();
+    void refreshBasis(int i);
+
+    std::vector<int> routeBegin;
+    std::vector<EntityWaypoint> waypoints;   // tüm rotalar tek havuzda
+    std::size_t liveWaypoints{0};
+
+    // Önbellekli ENU tabanı ve tazeleme anındaki ECEF konum (çapa)
+    std::vector<double> sinLat, cosLat, sinLon, cosLon;
+    std::vector<double> anchorX, anchorY, anchorZ;
+    std::vector<double> hInt;    // integre edilen irtifa (m)
+
+    double basisRefreshDistance{100.0};
+    int lastRefreshCount{0};
+    bool geodeticDirty{false};
+
+    // step() için çalışma alanı (yalnızca büyüdüğünde ayırır)
+    std::vector<unsigned char> refreshFlag;
+};
+
+#endif // ENTITYSTORE_H
@@ -0,0 +1,98 @@
+#include "fft.h"
+#include <cmath>
+#include <map>
+#include <mutex>
+#include <stdexcept>
+
+#if defined(_MSC_VER)
+#define FFT_RESTRICT __restrict
+#else
+#define FFT_RESTRICT __restrict__
+#endif
+
+namespace {
+
+// a, b = a + w b, a - w b (h kelebek). Ayrı fonksiyon: restrict parametreler
+// iç içe döngüde kaybolmaz, döngü vektörleşir.
+void butterflies(float *FFT_RESTRICT ar, float *FFT_RESTRICT ai, float *FFT_RESTRICT br, float *FFT_RESTRICT bi,
+                 const float *FFT_RESTRICT wr, const float *FFT_RESTRICT wi, std::size_t h)
+{
+    for (std::size_t j = 0; j < h; ++j) {
+        const float tr = br[j] * wr[j] - bi[j] * wi[j];
+        const float ti = br[j] * wi[j] + bi[j] * wr[j];
+        br[j] = ar[j] - tr;
+        bi[j] = ai[j] - ti;
+        ar[j] = ar[j] + tr;
+        ai[j] = ai[j] + ti;
+    }
+}
+
+} // namespace
+
+FftPlan::FftPlan(std::size_t size)
+    : n(size)
+{
+    if (n < 2 || (n & (n - 1)) != 0) throw std::invalid_argument("FftPlan: size must be a power of two");
+
+    int bits = 0;
+    while ((std::size_t(1) << bits) < n) ++bits;
+    for (std::size_t i = 0; i < n; ++i) {
+        std::size_t j = 0;
+        for (int b = 0; b < bits; ++b) j |= ((i >> b) & 1) << (bits - 1 - b);
+        if (i < j) swaps.emplace_back(static_cast<std::uint32_t>(i), static_cast<std::uint32_t>(j));
+    }
+
+    // h = 1 ve 2 aşamaları twiddle'sız; h >= 4 için w_j = e^{-iπj/h}
+    for (std::size_t h = 4; h < n; h <<= 1) {
+        for (std::size_t j = 0; j < h; ++j) {
+            const double a = -3.14159265358979323846 * double(j) / double(h);
+            twRe.push_back(static_cast<float>(std::cos(a)));
+            twIm.push_back(static_cast<float>(std::sin(a)));
+        }
+    }
+}
+
+std::shared_ptr<const FftPlan> FftPlan::get(std::size_t n)
+{
+    static std::mutex mutex;
+    static std::map<std::size_t, std::shared_ptr<const FftPlan>> plans;
+    std::lock_guard<std::mutex> lock(mutex);
+    std::shared_ptr<const FftPlan> &plan = plans[n];
+    if (!plan) plan = std::make_shared<const FftPlan>(n);
+    return plan;
+}
+
+void FftPlan::forward(float *re, float *im) const
+{
+    for (const auto &s : swaps) {
+        std::swap(re[s.first], re[s.second]);
+        std::swap(im[s.first], im[s.second]);
+    }
+
+    // h = 1 ve h = 2 birlikte: 4 noktalı kelebek (twiddle 1 ve -i)
+    if (n >= 4) {
+        for (std::size_t s = 0; s < n; s += 4) {
+            const float a0r = re[s] + re[s + 1], a0i = im[s] + im[s + 1];
+            const float a1r = re[s] - re[s + 1], a1i = im[s] - im[s + 1];
+            const float b0r = re[s + 2] + re[s + 3], b0i = im[s + 2] + im[s + 3];
+            const float b1r = re[s + 2] - re[s + 3], b1i = im[s + 2] - im[s + 3];
+            re[s] = a0r + b0r;     im[s] = a0i + b0i;
+            re[s + 2] = a0r - b0r; im[s + 2] = a0i - b0i;
+            // b1 * (-i) = (b1i, -b1r)
+            re[s + 1] = a1r + b1i; im[s + 1] = a1i - b1r;
+            re[s + 3] = a1r - b1i; im[s + 3] = a1i + b1r;
+        }
+    } else {
+        const float r0 = re[0], i0 = im[0];
+        re[0] = r0 + re[1]; im[0] = i0 + im[1];
+        re[1] = r0 - re[1]; im[1] = i0 - im[1];
+        return;
+    }
+
+    std::size_t off = 0;
+    for (std::size_t h = 4; h < n; h <<= 1) {
+        for (std::size_t s = 0; s < n; s += 2 * h)
+            butterflies(re + s, im + s, re + s + h, im + s + h, twRe.data() + off, twIm.data() + off, h);
+        off += h;
+    }
+}
@@ -0,0 +1,40 @@
+#ifndef FFT_H
+#define FFT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+#include "alignedbuffer.h"
+
+// Planlı radix-2 karmaşık FFT (yalnızca std, Qt gerektirmez).
+//
+// Veri ayrık re[] / im[] dizileridir (split format); kelebek döngüleri böylece
+// derleyici tarafından doğrudan vektörleştirilir. Plan bit-ters permütasyonu ve
+// her aşamanın twiddle'larını bitişik (hizalı) tablolarda bir kez hesaplar;
+// get() aynı boy için planı paylaşır. Plan sabittir, thread'ler arası paylaşılabilir.
+class FftPlan
+{
+public:
+    // n ikinin kuvveti olmalı (>= 2)
+    explicit FftPlan(std::size_t n);
+
+    // Boy başına tek plan (thread-safe önbellek)
+    static std::shared_ptr<const FftPlan> get(std::size_t n);
+
+    std::size_t size() const { return n; }
+
+    // X_k = sum x_j e^{-2πijk/n}
+    void forward(float *re, float *im) const;
+    // x_j = sum X_k e^{+2πijk/n} (1/n ölçeklemesi yok)
+    void inverse(float *re, float *im) const { forward(im, re); }
+
+private:
+    std::size_t n;
+    std::vector<std::pair<std::uint32_t, std::uint32_t>> swaps;   // bit-ters (i < j)
+    AlignedVector<float> twRe;     // aşama h için h twiddle, h = 4, 8, ..., n/2 ardışık
+    AlignedVector<float> twIm;
+};
+
+#endif // FFT_H
@@ -0,0 +1,199 @@
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include "geo.h"
+#include "terrainsampler.h"
+
+// Qt'siz görüş hattı (LOS) çekirdeği. Yükseklik örnekleyici dışarıdan verilir
+// (TerrainModel::heightsOnArc ya da bench'te sentetik ızgara).
+namespace Los {
+
+    static constexpr double earthRadius = 6371008.8;   // ortalama küre yarıçapı (m)
+
+    struct Endpoint {
+        double lat{0.0};
+        double lon{0.0};
+        double alt{0.0};     // m (DTED ile aynı düşey referans)
+    };
+
+    struct Params {
+        double sampleSpacing{60.0};      // yol boyunca örnek aralığı (m)
+        int maxSamples{4096};            // çok uzun yollarda aralık büyür
+        double kFactor{4.0 / 3.0};       // etkin dünya yarıçapı katsayısı (standart kırılma)
+        double minAntennaAgl{2.0};       // uç nokta araziye gömülüyse en az bu kadar yukarı alınır
+        double clearance{0.0};           // ışının araziden en az bu kadar yukarıda kalması (m)
+    };
+
+    // Örnek tamponu; her worker kendi Scratch'ini kullanır
+    struct Scratch {
+        static constexpr std::size_t kChunk = 512;
+        static constexpr int kBlock = 32;      // clear() örnekleme bloğu (~2 km)
+        static constexpr int kMaxSkip = 256;   // tek sınamada geçilebilecek en uzun parça
+        alignas(64) float h[kChunk];
+    };
+
+    // Büyük daire yolu: uçlar ve gerçek orta nokta üzerinden ikinci dereceden
+    // parametrik eğri (lat/lon). Yüzlerce km'lik yollarda sapma metre altıdır;
+    // örnek başına trig gerekmez, döngü vektörleşir.
+    struct Path {
+        double lat0, dLat1, dLat2;     // lat(s) = lat0 + s*dLat1 + s^2*dLat2
+        double lon0, dLon1, dLon2;
+        double length;                 // yer yüzeyi boyunca (m)
+
+        Path(const Endpoint &a, const Endpoint &b)
+        {
+            const double la1 = a.lat * Geo::deg2rad, lo1 = a.lon * Geo::deg2rad;
+            const double la2 = b.lat * Geo::deg2rad, lo2 = b.lon * Geo::deg2rad;
+            const double x1 = std::cos(la1) * std::cos(lo1), y1 = std::cos(la1) * std::sin(lo1), z1 = std::sin(la1);
+            const double x2 = std::cos(la2) * std::cos(lo2), y2 = std::cos(la2) * std::sin(lo2), z2 = std::sin(la2);
+            const double cx = x2 - x1, cy = y2 - y1, cz = z2 - z1;
+            const double chord = std::sqrt(cx * cx + cy * cy + cz * cz);
+            length = 2.0 * earthRadius * std::asin(std::min(1.0, 0.5 * chord));
+
+            const double mx = x1 + x2, my = y1 + y2, mz = z1 + z2;
+            const double mn = std::sqrt(mx * mx + my * my + mz * mz);
+            double latM = a.lat, lonM = a.lon;
+            if (mn > 1e-12) {
+                latM = std::asin(mz / mn) * Geo::rad2deg;
+                lonM = std::atan2(my, mx) * Geo::rad2deg;
+            }
+            // Boylamları başlangıca göre aç (antimeridyen)
+            const double lonB = a.lon + Geo::wrapLon(b.lon - a.lon);
+            lonM = a.lon + Geo::wrapLon(lonM - a.lon);
+
+            lat0 = a.lat;
+            dLat1 = 4.0 * latM - 3.0 * a.lat - b.lat;
+            dLat2 = 2.0 * a.lat + 2.0 * b.lat - 4.0 * latM;
+            lon0 = a.lon;
+            dLon1 = 4.0 * lonM - 3.0 * a.lon - lonB;
+            dLon2 = 2.0 * a.lon + 2.0 * lonB - 4.0 * lonM;
+        }
+
+        // t = t0 + j*dt örnekleri yay olarak (örnekleyiciye verilir)
+        Terrain::Arc arc(double t0, double dt) const
+        {
+            return {lat0 + t0 * (dLat1 + t0 * dLat2), lon0 + t0 * (dLon1 + t0 * dLon2),
+                    dt * (dLat1 + 2.0 * t0 * dLat2), dt * (dLon1 + 2.0 * t0 * dLon2),
+                    dt * dt * dLat2, dt * dt * dLon2};
+        }
+    };
+
+    // a'dan b'ye ışın arazi tarafından kesilmiyorsa true. Kırılma, etkin yarıçap
+    // Re = k*R ile: x mesafesindeki arazi, uçları birleştiren düz ışına göre
+    // x*(D-x)/(2*Re) kadar yükselmiş sayılır.
+    //
+    // Yol a'dan dışarı doğru Scratch::kBlock örneklik bloklarla taranır; engel
+    // görülen ilk blokta durulur. Işının blok içindeki en alçak noktası, bloğun
+    // arazi tavanı + bloktaki en büyük kabarma + clearance'tan yüksekse blok hiç
+    // örneklenmez (yüksek hedeflerde yolun çoğu böyle geçilir; sonuç değişmez).
+    // sampler(arc, hOut*, n) yayın ilk n örneğinin yüksekliğini (m, float) yazar;
+    // ceiling(arc, n) aynı örneklerin altındaki arazinin üst sınırını (bilinmiyorsa +sonsuz).
+    template <typename Sampler, typename Ceiling>
+    bool clear(const Endpoint &a, const Endpoint &b, const Params &p, Sampler &&sampler, Ceiling &&ceiling, Scratch &s)
+    {
+        const Path path(a, b);
+        const double D = path.length;
+        if (D < 1.0) return true;
+
+        // Uç noktalar (iki örneklik doğru): araziye gömülü anten en az minAntennaAgl yukarı alınır
+        float ends[2];
+        sampler(Terrain::Arc{a.lat, a.lon, b.lat - a.lat, Geo::wrapLon(b.lon - a.lon), 0.0, 0.0}, ends, 2);
+        const double hA = std::max(a.alt, ends[0] + p.minAntennaAgl);
+        const double hB = std::max(b.alt, ends[1] + p.minAntennaAgl);
+
+        // Yuvarlama gürültüsü (D = 1000.0000001) fazladan örnek eklemesin
+        const int n = std::clamp(static_cast<int>(std::ceil(D / p.sampleSpacing - 1e-6)), 2, p.maxSamples);
+        const double ds = 1.0 / n;
+        const double inv2Re = 1.0 / (2.0 * p.kFactor * earthRadius);
+        const double dh = hB - hA;
+
+        // İç örnekler k = 1 .. n-1. Geçilen bloktan sonra sınama boyu ikiye katlanır
+        // (kMaxSkip'e kadar); geçilemeyen büyük blok kBlock'larla yeniden denenir.
+        int span = Scratch::kBlock;
+        for (int k0 = 1; k0 < n;) {
+            const int m = std::min(span, n - k0);
+            const Terrain::Arc arc = path.arc(k0 * ds, ds);
+            const double t0 = k0 * ds, t1 = (k0 + m - 1) * ds;
+            const double xPeak = std::clamp(0.5 * D, t0 * D, t1 * D);
+            const double rayLow = hA + dh * (dh < 0.0 ? t1 : t0);
+            if (ceiling(arc, static_cast<std::size_t>(m)) + xPeak * (D - xPeak) * inv2Re + p.clearance < rayLow) {
+                k0 += m;
+                span = std::min(2 * span, Scratch::kMaxSkip);
+                continue;
+            }
+            if (span > Scratch::kBlock) {
+                span = Scratch::kBlock;
+                continue;
+            }
+            sampler(arc, s.h, static_cast<std::size_t>(m));
+            int blocked = 0;
+            for (int j = 0; j < m; ++j) {
+                const double t = (k0 + j) * ds;
+                const double x = t * D;
+                const double terrain = s.h[j] + x * (D - x) * inv2Re + p.clearance;
+                const double ray = hA + dh * t;
+                blocked |= (terrain > ray) ? 1 : 0;
+            }
+            if (blocked) return false;
+            k0 += m;
+        }
+        return true;
+    }
+
+    // Küre üzerinde (lat, lon)'dan azimuth (derece, kuzeyden saat yönü) yönünde
+    // dist metre ilerideki nokta
+    inline Endpoint destination(double lat, double lon, double azimuthDeg, double dist)
+    {
+        const double d = dist / earthRadius, az = azimuthDeg * Geo::deg2rad;
+        const double la = lat * Geo::deg2rad;
+        const double sinLa = std::sin(la), cosLa = std::cos(la);
+        const double sinD = std::sin(d), cosD = std::cos(d);
+        const double sinLa2 = sinLa * cosD + cosLa * sinD * std::cos(az);
+        const double dLon = std::atan2(std::sin(az) * sinD * cosLa, cosD - sinLa * sinLa2);
+        return Endpoint{std::asin(sinLa2) * Geo::rad2deg, lon + dLon * Geo::rad2deg, 0.0};
+    }
+
+    // Radyal ufuk: radardan azimuth yönünde k = 1..nodes için r_k = k*rangeStep
+    // menzilinde görünür olunabilecek en düşük yükseklik (m) out[k-1]'e yazılır.
+    //
+    // Etkin dünya (Re = k*R) düz yaklaşımında x'teki engelin görünür açısı
+    // (h(x) - hA)/x - x/(2Re)'dir; r'deki hB yüksekliği, r'ye kadarki en büyük
+    // açıdan yukarıdaysa görünür (clear() ile aynı ölçüt). Tek geçişte koşan
+    // maksimumla bütün menziller çıkar; sonuç ayrıca o noktadaki zeminin altına inmez.
+    template <typename Sampler>
+    void minVisibleHeights(const Endpoint &radar, double azimuthDeg, double rangeStep, int nodes,
+                           const Params &p, Sampler &&sampler, Scratch &s, float *out)
+    {
+        float ground;
+        sampler(Terrain::Arc{radar.lat, radar.lon}, &ground, 1);
+        const double hA = std::max(radar.alt, ground + p.minAntennaAgl);
+        const double inv2Re = 1.0 / (2.0 * p.kFactor * earthRadius);
+
+        // Düğümler örneklerle çakışsın
+        const int perNode = std::max(1, static_cast<int>(std::ceil(rangeStep / p.sampleSpacing)));
+        const double dx = rangeStep / perNode;
+        const long total = long(nodes) * perNode;
+
+        double maxAngle = -1e300;
+        for (long j0 = 1; j0 <= total; j0 += long(Scratch::kChunk)) {
+            const int m = static_cast<int>(std::min(long(Scratch::kChunk), total - j0 + 1));
+            // Parça başına kısa (<= 512 örnek) kuadratik büyük daire yayı
+            const Endpoint a = destination(radar.lat, radar.lon, azimuthDeg, j0 * dx);
+            const Endpoint b = destination(radar.lat, radar.lon, azimuthDeg, (j0 + m - 1) * dx);
+            const Path path(a, b);
+            sampler(path.arc(0.0, m > 1 ? 1.0 / (m - 1) : 0.0), s.h, static_cast<std::size_t>(m));
+            for (int j = 0; j < m; ++j) {
+                const long idx = j0 + j;
+                const double x = idx * dx;
+                if (idx % perNode == 0) {
+                    const double r = x;
+                    const double hMin = hA + r * (maxAngle + r * inv2Re);
+                    out[idx / perNode - 1] = static_cast<float>(std::max(hMin, double(s.h[j])));
+                }
+                maxAngle = std::max(maxAngle, (s.h[j] + p.clearance - hA) / x - x * inv2Re);
+            }
+        }
+    }
+
+} // namespace Los
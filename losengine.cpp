@@ -0,0 +1,131 @@
+#include "losengine.h"
+#include "terrainmodel.h"
+#include "workstealingpool.h"
+#include "coveragemap.h"
+#include "geo.h"
+#include <chrono>
+
+namespace {
+
+// Bir havuz çağrısında worker'a düşen en küçük çift sayısı
+constexpr std::size_t kPairGrain = 16;
+
+} // namespace
+
+LosEngine::LosEngine(std::shared_ptr<TerrainTileCache> cache, int threads)
+    : tiles(std::move(cache))
+    , threadCount(threads)
+{
+}
+
+LosEngine::~LosEngine() = default;
+
+WorkStealingPool &LosEngine::workers()
+{
+    if (!pool) pool = std::make_unique<WorkStealingPool>(threadCount);
+    return *pool;
+}
+
+void LosEngine::Anchors::resize(std::size_t n)
+{
+    X.assign(n, 0.0);
+    Y.assign(n, 0.0);
+    Z.assign(n, 0.0);
+    version.assign(n, 0);
+}
+
+void LosEngine::Anchors::update(const std::vector<Los::Endpoint> &pts, double threshold, bool reset)
+{
+    const double t2 = threshold * threshold;
+    for (std::size_t i = 0; i < pts.size(); ++i) {
+        double x, y, z;
+        Geo::geodeticToECEF(pts[i].lat, pts[i].lon, pts[i].alt, x, y, z);
+        const double dx = x - X[i], dy = y - Y[i], dz = z - Z[i];
+        if (reset || dx * dx + dy * dy + dz * dz > t2) {
+            X[i] = x; Y[i] = y; Z[i] = z;
+            ++version[i];
+        }
+    }
+}
+
+void LosEngine::compute(const std::vector<Los::Endpoint> &radars,
+                        const std::vector<Los::Endpoint> &targets,
+                        std::vector<unsigned char> &visible,
+                        const std::vector<std::shared_ptr<const CoverageMap>> *coverage)
+{
+    using Clock = std::chrono::steady_clock;
+    const auto t0 = Clock::now();
+
+    const std::size_t nr = radars.size(), nt = targets.size();
+    const std::size_t pairs = nr * nt;
+
+    // Varlık sayısı değişti ya da arazi yenilendi: tüm önbelleği at
+    bool reset = dirty.exchange(false, std::memory_order_acq_rel);
+    if (radarAnchors.version.size() != nr || targetAnchors.version.size() != nt) {
+        radarAnchors.resize(nr);
+        targetAnchors.resize(nt);
+        pairRadarVersion.assign(pairs, 0);
+        pairTargetVersion.assign(pairs, 0);
+        result.assign(pairs, 0);
+        reset = true;
+    }
+    radarAnchors.update(radars, moveThreshold, reset);
+    targetAnchors.update(targets, moveThreshold, reset);
+
+    // Kirli çiftleri topla (sürümler 1'den başlar, çift sürümü 0 ile açılır)
+    work.clear();
+    std::size_t looked = 0;
+    for (std::size_t r = 0; r < nr; ++r) {
+        const std::uint32_t rv = radarAnchors.version[r];
+        const std::size_t row = r * nt;
+        const CoverageMap *map = (coverage && r < coverage->size()) ? (*coverage)[r].get() : nullptr;
+        for (std::size_t t = 0; t < nt; ++t) {
+            if (map) {
+                const int v = map->visibility(targets[t]);
+                if (v >= 0) {
+                    result[row + t] = static_cast<unsigned char>(v);
+                    // Izgara dışına çıkınca (ya da harita kalkınca) yeniden taransın
+                    pairRadarVersion[row + t] = 0;
+                    ++looked;
+                    continue;
+                }
+            }
+            if (pairRadarVersion[row + t] != rv || pairTargetVersion[row + t] != targetAnchors.version[t])
+                work.push_back(static_cast<std::uint32_t>(row + t));
+        }
+    }
+
+    if (!work.empty()) {
+        workers();
+
+        // Çiftlerin yolu, hesaplandığı andaki çapa değil gerçek konumlardan taranır
+        std::vector<std::unique_ptr<Los::Scratch>> scratch(pool->workerCount());
+        const Los::Params p = params;
+
+        pool->parallelFor(work.size(), kPairGrain, [&](std::size_t begin, std::size_t end, int worker) {
+            if (!scratch[worker]) scratch[worker] = std::make_unique<Los::Scratch>();
+            // Reader parça kapsamında: worker'lar arası bekleyen hücreler geri kazanılabilsin
+            TerrainTileCache::Reader reader(*tiles);
+            auto sampler = [&reader](const Terrain::Arc &arc, float *out, std::size_t n) {
+                TerrainModel::heightsOnArc(reader, arc, out, n);
+            };
+            auto ceiling = [&reader](const Terrain::Arc &arc, std::size_t n) {
+                return TerrainModel::ceilingOnArc(reader, arc, n);
+            };
+            for (std::size_t k = begin; k < end; ++k) {
+                const std::size_t idx = work[k];
+                const std::size_t r = idx / nt, t = idx % nt;
+                result[idx] = Los::clear(radars[r], targets[t], p, sampler, ceiling, *scratch[worker]) ? 1 : 0;
+                pairRadarVersion[idx] = radarAnchors.version[r];
+                pairTargetVersion[idx] = targetAnchors.version[t];
+            }
+        });
+    }
+
+    visible = result;
+
+    stats.pairs = pairs;
+    stats.recomputed = work.size();
+    stats.fromCoverage = looked;
+    stats.milliseconds = std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+}
@@ -0,0 +1,95 @@
+#ifndef LOSENGINE_H
+#define LOSENGINE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "lineofsight.h"
+#include "terraincache.h"
+
+class WorkStealingPool;
+class CoverageMap;
+
+// Radar x target görüş hattı matrisi. Her çift için büyük daire yolu, önbellekteki
+// DTED yüksekliklerine karşı 4/3 dünya kırılmasıyla taranır (Los::clear). Işının
+// karo en yüksek noktalarının üstünde kaldığı bloklar örneklenmez, engel görülen
+// ilk blokta durulur.
+//
+// Bütçe (bench_los, tek worker, 10 radar x 2000 target): artımlı tick (%5 target
+// eşiği aştı) ~0.6 ms, fizik adımı bütçesi 10 ms; soğuk tam matris (varlık sayısı
+// değişimi, arazi yenileme) AVX2 ile ~12-16 ms (en fazla iki adım), AVX2'siz
+// derlemede ~26-33 ms (dört adım), tick ~1 ms. Worker sayısıyla bölünür.
+//
+// Sonuçlar önbelleklenir: her uç noktanın bir çapa konumu ve sürümü vardır; uç
+// nokta çapasından moveThreshold'dan fazla uzaklaşınca sürümü artar ve yalnızca
+// o uca bağlı çiftler yeniden hesaplanır. Kirli çiftler iş çalan havuzda paralel
+// işlenir; her worker kendi Reader'ı ve tamponlarıyla çalışır.
+//
+// Sabit radarlar için önceden hesaplanmış CoverageMap verilirse o radarın
+// ızgara içindeki çiftleri yol taraması yerine O(1) tablo sorgusuyla çözülür.
+class LosEngine
+{
+public:
+    struct Stats {
+        std::size_t pairs{0};
+        std::size_t recomputed{0};
+        std::size_t fromCoverage{0};    // ızgara sorgusuyla çözülen çiftler
+        double milliseconds{0.0};
+    };
+
+    // threads <= 0: donanım thread sayısı
+    explicit LosEngine(std::shared_ptr<TerrainTileCache> cache, int threads = 0);
+    ~LosEngine();
+
+    void setMoveThreshold(double meters) { moveThreshold = meters; invalidate(); }
+    void setSampleSpacing(double meters) { params.sampleSpacing = meters; invalidate(); }
+    void setRefractionK(double k) { params.kFactor = k; invalidate(); }
+    double moveThresholdMeters() const { return moveThreshold; }
+    const Los::Params &parameters() const { return params; }
+
+    // Arazi değiştiğinde çağrılır (thread-safe); sonraki compute() her şeyi yeniden hesaplar
+    void invalidate() { dirty.store(true, std::memory_order_release); }
+
+    // visible[r * targets.size() + t] = 1: radar r target t'yi görüyor.
+    // coverage verilirse radars ile aynı boyda olmalı (boş eleman: tarama)
+    void compute(const std::vector<Los::Endpoint> &radars,
+                 const std::vector<Los::Endpoint> &targets,
+                 std::vector<unsigned char> &visible,
+                 const std::vector<std::shared_ptr<const CoverageMap>> *coverage = nullptr);
+
+    // Hesap havuzu (ilk çağrıda kurulur); CoverageMap::build de bunu kullanır
+    WorkStealingPool &workers();
+
+    const Stats &lastStats() const { return stats; }
+
+private:
+    struct Anchors {
+        std::vector<double> X, Y, Z;
+        std::vector<std::uint32_t> version;
+        void resize(std::size_t n);
+        // Eşikten fazla kayan uçların sürümünü artırır
+        void update(const std::vector<Los::Endpoint> &pts, double threshold, bool reset);
+    };
+
+    std::shared_ptr<TerrainTileCache> tiles;
+    int threadCount;
+    std::unique_ptr<WorkStealingPool> pool;    // ilk compute()'ta kurulur
+
+    Los::Params params;
+    double moveThreshold{50.0};
+    std::atomic<bool> dirty{true};
+
+    Anchors radarAnchors;
+    Anchors targetAnchors;
+    // Çift başına hesaplandığı andaki uç sürümleri ve sonuç
+    std::vector<std::uint32_t> pairRadarVersion;
+    std::vector<std::uint32_t> pairTargetVersion;
+    std::vector<unsigned char> result;
+    std::vector<std::uint32_t> work;           // bu tick kirli çift indeksleri
+
+    Stats stats;
+};
+
+#endif // LOSENGINE_H
@@ -3,9 +3,12 @@
 #include <QPalette>
 #include <QDir>
 #include "mainwindow.h"
+#include "tileschemehandler.h"
 
 int main(int argc, char *argv[])
 {
+    // Özel URL şemaları WebEngine başlamadan kaydedilmelidir
+    TileSchemeHandler::registerUrlScheme();
     QApplication app(argc, argv);
     
     // Dark theme uygula
@@ -19,6 +19,29 @@
 #include <QFile>
 #include <QFileInfo>
 #include <QDateTime>
+#include "scenario.h"
+
+namespace {
+
+// Harita hava koşulları -> çekirdek zayıflatıcı hücreler
+QVector<WeatherCell> toWeatherCells(const QList<WeatherCondition> &conditions)
+{
+    QVector<WeatherCell> cells;
+    for (const WeatherCondition &w : conditions) {
+        WeatherCell c;
+        c.type = w.type == "Rain" ? WeatherType::Rain : WeatherType::Fog;
+        c.lat = w.latitude;
+        c.lon = w.longitude;
+        c.radiusKm = w.radius;
+        c.rainRate = w.rainRate;
+        c.fogVisibility = w.fogVisibility;
+        c.temperatureK = c.type == WeatherType::Rain ? w.rainTemperature : w.fogTemperature;
+        cells.append(c);
+    }
+    return cells;
+}
+
+} // namespace
 
 MainWindow::MainWindow(QWidget *parent)
     : QMainWindow(parent)
@@ -198,6 +221,9 @@ void MainWindow::createConnections()
     
     // Target pozisyon güncellemelerini MapWidget'a ilet
     connect(controlPanel, &ControlPanel::targetPositionUpdated, this, &MainWindow::updateTargetPositionOnMap);
+    // Tespit: haritada target rengi, olaylar log'a
+    connect(controlPanel, &ControlPanel::targetDetectionChanged, mapWidget, &MapWidget::setTargetDetected);
+    connect(controlPanel, &ControlPanel::detectionEvent, this, &MainWindow::onDetectionEvent);
 
     // Radar pozisyon güncellemesini initial marker ile gösterelim
     connect(controlPanel, &ControlPanel::radarPositionUpdated, this, [this](double lat, double lon, double alt){
@@ -249,6 +275,25 @@ void MainWindow::saveFile()
     root["showTargetsTraj"] = controlPanel ? controlPanel->showTargetsTrajEnabled() : false;
     root["calculateWeather"] = sidebar ? sidebar->sidebarCalculateWeatherEnabled() : false;
 
+    // Advanced Propagations
+    if (sidebar) {
+        const PropagationSettings p = sidebar->propagationSettings();
+        QJsonObject po;
+        po["mode"] = static_cast<int>(p.mode);
+        po["maxAltitude"] = p.maxAltitude;
+        po["maxDistanceKm"] = p.maxDistanceKm;
+        po["altitudeStep"] = p.altitudeStep;
+        po["distanceStep"] = p.distanceStep;
+        po["ground"] = static_cast<int>(p.ground);
+        po["conductivity"] = p.conductivity;
+        po["permittivity"] = p.permittivity;
+        po["flatTerrain"] = p.flatTerrain;
+        po["halfBeamWidthDeg"] = p.halfBeamWidthDeg;
+        po["frequencyGHz"] = p.frequencyGHz;
+        po["verticalPolarization"] = p.verticalPolarization;
+        root["propagation"] = po;
+    }
+
     // Radar initial
     QJsonObject radarInit;
     radarInit["name"] = sidebar ? sidebar->radarName() : "Radar";
@@ -258,6 +303,7 @@ void MainWindow::saveFile()
     radarInit["velN"] = sidebar ? sidebar->radarInitVelN() : 0.0;
     radarInit["velE"] = sidebar ? sidebar->radarInitVelE() : 0.0;
     radarInit["velD"] = sidebar ? sidebar->radarInitVelD() : 0.0;
+    radarInit["parameters"] = radarParametersToJson(sidebar ? sidebar->radarParameters() : RadarParameters());
     root["radarInitial"] = radarInit;
 
     // Radar route
@@ -328,6 +374,7 @@ void MainWindow::saveFile()
         for (const auto &rp : profiles) {
             QJsonObject ro; ro["name"] = rp.name; ro["lat"] = rp.initLat; ro["lon"] = rp.initLon; ro["alt"] = rp.initAlt; ro["velN"] = rp.velN; ro["velE"] = rp.velE; ro["velD"] = rp.velD;
             QJsonArray rr; for (const auto &wp : rp.route) { QJsonObject w; w["lat"] = wp.lat; w["lon"] = wp.lon; w["alt"] = wp.alt; w["velN"] = wp.velN; w["velE"] = wp.velE; w["velD"] = wp.velD; rr.append(w);} ro["route"] = rr;
+            ro["parameters"] = radarParametersToJson(rp.parameters);
             radarsArr.append(ro);
         }
     }
@@ -402,13 +449,18 @@ void MainWindow::startSimulation()
             sidebar->radarInitVelD()
         );
         controlPanel->setRadarRoute(sidebar->radarRouteWaypoints());
+        controlPanel->setPropagationSettings(sidebar->propagationSettings());
+        controlPanel->setRadarParameters(sidebar->radarParameters());
+        controlPanel->setWeatherCells(sidebar->sidebarCalculateWeatherEnabled()
+                                          ? toWeatherCells(sidebar->getWeatherConditions()) : QVector<WeatherCell>());
 
         if (mapWidget) mapWidget->addRadar(sidebar->radarName(), sidebar->radarInitLat(), sidebar->radarInitLon(), sidebar->radarInitAlt());
 
         auto profiles = sidebar->getAllRadarProfiles();
         for (const auto &rp : profiles) {
             controlPanel->addRadarProfile(rp.name, rp.initLat, rp.initLon, rp.initAlt, rp.velN, rp.velE, rp.velD,
-                                          [&](){ QVector<RadarRouteWaypoint> v; for(const auto &x: rp.route){ RadarRouteWaypoint w{ x.lat,x.lon,x.alt,x.velN,x.velE,x.velD}; v.push_back(w);} return v;}());
+                                          [&](){ QVector<RadarRouteWaypoint> v; for(const auto &x: rp.route){ RadarRouteWaypoint w{ x.lat,x.lon,x.alt,x.velN,x.velE,x.velD}; v.push_back(w);} return v;}(),
+                                          rp.parameters);
             if (mapWidget) mapWidget->addRadar(rp.name, rp.initLat, rp.initLon, rp.initAlt);
         }
 
@@ -454,6 +506,17 @@ void MainWindow::addWeatherCondition(const WeatherCondition &condition)
     mapWidget->updateLegend();
 }
 
+void MainWindow::onDetectionEvent(const SimDetectionEvent &event)
+{
+    const QString radar = event.radarName.isEmpty() && sidebar ? sidebar->radarName() : event.radarName;
+    const QString msg = QString("t=%1 s: %2 %3 %4 (SNR %5 dB)")
+                            .arg(event.simTime, 0, 'f', 1)
+                            .arg(radar, event.detected ? QStringLiteral("detected") : QStringLiteral("lost"), event.targetName)
+                            .arg(event.snrDb, 0, 'f', 1);
+    qInfo().noquote() << "Detection:" << msg;
+    statusBar()->showMessage(msg, 5000);
+}
+
 void MainWindow::removeWeatherCondition(int index)
 {
     mapWidget->removeWeatherCondition(index);
@@ -473,6 +536,8 @@ void MainWindow::addDTEDFiles(const QStringList &fileNames)
         
         mapWidget->addDTEDFile(dtedFile);
     }
+    // Yükseklik verisi motorun arazi önbelleğine (ilk sorguda eşlenir)
+    controlPanel->addTerrainFiles(fileNames);
     mapWidget->updateLegend();
 }
 
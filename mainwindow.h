@@ -38,6 +38,7 @@ private slots:
     void stopSimulation();
     void addWeatherCondition(const WeatherCondition &condition);
     void removeWeatherCondition(int index);
+    void onDetectionEvent(const SimDetectionEvent &event);
     void addDTEDFiles(const QStringList &fileNames);
     void addTargetToSimulation(const Target &target);
     void removeTargetFromSimulation(const QString &targetName);
@@ -0,0 +1,17 @@
+#include "mapbridge.h"
+
+MapBridge::MapBridge(QObject *parent)
+    : QObject(parent)
+{
+}
+
+void MapBridge::pushFrame(const QByteArray &packed, const QString &meta)
+{
+    emit framePushed(QString::fromLatin1(packed.toBase64()), meta);
+}
+
+void MapBridge::notifyReady()
+{
+    ready = true;
+    emit readyChanged();
+}
@@ -0,0 +1,39 @@
+#ifndef MAPBRIDGE_H
+#define MAPBRIDGE_H
+
+#include <QObject>
+#include <QString>
+
+// QWebChannel üzerinden haritaya konum aktaran köprü nesnesi.
+// Konumlar paketlenmiş (yerel bayt sırası) Float64 dizisi olarak gönderilir; JS tarafı
+// bunu metin ayrıştırmadan Float64Array olarak okur. QWebChannel QByteArray'i
+// metin olarak taşıdığı için tampon base64 ile sarılır (atob + typed array view).
+//
+// Paket düzeni: [nTargets, nRadars, hasInitial,
+//                nTargets x (id, lon, lat, alt), nRadars x (id, lon, lat, alt),
+//                hasInitial ? (lon, lat, alt)]
+// meta: yalnızca gerektiğinde dolu JSON ({"n":{id:isim}, "x":[id], "rn":{id:isim}})
+class MapBridge : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit MapBridge(QObject *parent = nullptr);
+
+    bool isReady() const { return ready; }
+    void reset() { ready = false; }
+    void pushFrame(const QByteArray &packed, const QString &meta);
+
+public slots:
+    // JS tarafı kanala bağlandığında çağırır
+    void notifyReady();
+
+signals:
+    void framePushed(const QString &packedBase64, const QString &meta);
+    void readyChanged();
+
+private:
+    bool ready{false};
+};
+
+#endif // MAPBRIDGE_H
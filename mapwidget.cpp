@@ -9,7 +9,15 @@
 #include <QDebug>
 #include <QApplication>
 #include <QDir>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonArray>
 #include "geo.h"
+#include "mapbridge.h"
+#include "tileprovider.h"
+#include "tileschemehandler.h"
+#include <QWebChannel>
+#include <QFile>
 #include <gdal_priv.h>
 #include <cmath> // For std::sin, std::cos, std::asin, std::atan2
 
@@ -86,7 +94,13 @@ MapWidget::MapWidget(QWidget *parent)
     , showDTEDAreas(false)
 {
     setupWebView();
+    setupOfflineTiles();
     loadMap();
+
+    flushTimer = new QTimer(this);
+    flushTimer->setSingleShot(true);
+    flushTimer->setInterval(kFrameIntervalMs);
+    connect(flushTimer, &QTimer::timeout, this, &MapWidget::flushPendingUpdates);
 }
 
 MapWidget::~MapWidget()
@@ -110,14 +124,70 @@ void MapWidget::setupWebView()
     // Fullscreen kontrolü QWebEngine içinde her zaman desteklenmediği için JS tarafında koşullu ekleyeceğiz
     
     layout->addWidget(webView);
+
+    // Konum köprüsü: JS kanala bağlanınca bekleyen kare gönderilir
+    bridge = new MapBridge(this);
+    webChannel = new QWebChannel(this);
+    webChannel->registerObject(QStringLiteral("mapBridge"), bridge);
+    webPage->setWebChannel(webChannel);
+    connect(bridge, &MapBridge::readyChanged, this, &MapWidget::flushPendingUpdates);
     
     // Bağlantılar
     connect(webView, &QWebEngineView::loadFinished, this, &MapWidget::onLoadFinished);
     connect(webView, &QWebEngineView::loadProgress, this, &MapWidget::onLoadProgress);
 }
 
+QString MapWidget::findTileArchive() const
+{
+    // Önce RADARMAP_TILES, yoksa <uygulama dizini>/tiles altındaki ilk arşiv
+    const QString env = qEnvironmentVariable("RADARMAP_TILES");
+    if (!env.isEmpty()) return env;
+    const QDir dir(QDir(QCoreApplication::applicationDirPath()).filePath("tiles"));
+    const QStringList found = dir.entryList({"*.mbtiles", "*.pmtiles"}, QDir::Files, QDir::Name);
+    return found.isEmpty() ? QString() : dir.filePath(found.first());
+}
+
+void MapWidget::setupOfflineTiles()
+{
+    tileProvider = std::make_shared<TileProvider>();
+    QWebEngineProfile *profile = webPage->profile();
+    if (!profile->urlSchemeHandler(TileSchemeHandler::schemeName())) {
+        profile->installUrlSchemeHandler(TileSchemeHandler::schemeName(),
+                                         new TileSchemeHandler(tileProvider, this));
+    }
+
+    const QString archivePath = findTileArchive();
+    if (archivePath.isEmpty()) return;
+    QString error;
+    if (!tileProvider->open(archivePath, &error)) {
+        qDebug() << "Offline tiles disabled:" << error;
+        return;
+    }
+    offlineTiles = true;
+    mapStyleUrl = QString("%1://tiles/style.json").arg(TileSchemeHandler::schemeName());
+    qDebug() << "Offline tiles:" << archivePath << "cache" << tileProvider->cacheBudgetMB() << "MB";
+
+    // Açılış görünümü için kaba seviyeleri baştan belleğe al
+    const double *b = tileProvider->tileArchive()->bounds();
+    tileProvider->prefetch(b[0], b[1], b[2], b[3], 0, 5);
+}
+
+void MapWidget::prefetchTiles(double minLon, double minLat, double maxLon, double maxLat,
+                              int minZoom, int maxZoom)
+{
+    if (offlineTiles) tileProvider->prefetch(minLon, minLat, maxLon, maxLat, minZoom, maxZoom);
+}
+
 void MapWidget::loadMap()
 {
+    // Yeni sayfa: JS durumu sıfırlanır, id tabloları da baştan başlar
+    if (bridge) bridge->reset();
+    targetFeatureIds.clear();
+    radarFeatureIds.clear();
+    removedTargetIds.clear();
+    removedRadarIds.clear();
+    clearTargetsPending = false;
+    clearRadarsPending = false;
     QString html = generateMapHTML();
     webView->setHtml(html);
 }
@@ -130,9 +200,9 @@ QString MapWidget::generateMapHTML()
 <head>
     <meta charset="utf-8">
     <title>Radar Map - Offline Tile System</title>
-    <!-- MapLibre GL JS (jsDelivr CDN) -->
-    <script src="https://cdn.jsdelivr.net/npm/maplibre-gl@3.6.2/dist/maplibre-gl.min.js"></script>
-    <link href="https://cdn.jsdelivr.net/npm/maplibre-gl@3.6.2/dist/maplibre-gl.min.css" rel="stylesheet" />
+    <!-- MapLibre GL JS (yerel kopya varsa radartiles://assets, yoksa jsDelivr CDN) -->
+    <script src="@MAPLIBRE_BASE@/maplibre-gl.min.js"></script>
+    <link href="@MAPLIBRE_BASE@/maplibre-gl.min.css" rel="stylesheet" />
     <style>
         html, body { margin: 0; padding: 0; height: 100%; }
         #map { position: absolute; top: 0; bottom: 0; width: 100%; }
@@ -166,9 +236,154 @@ QString MapWidget::generateMapHTML()
     <div class="coordinate-display" id="coords">Lat: 0, Lon: 0</div>
     <script>
         function __wrapLon(lon){ while(lon>180) lon-=360; while(lon<-180) lon+=360; return lon; }
+
+        // Kare birleştirilmiş konum güncellemeleri (MapWidget::flushPendingUpdates).
+        // Tüm target'lar tek 'targets', tüm radarlar tek 'radars' FeatureCollection
+        // kaynağındadır; stil veri güdümlüdür (tek layer). Her karede yalnızca değişen
+        // feature'lar id ile updateData'ya verilir. Durum harita hazır olmadan da
+        // tutulur; 'load' anında tek setData ile uygulanır.
+        // p.n / p.rn: {id: isim}, p.t / p.r: [id, lon, lat, alt, ...], p.x / p.rx: [silinen id],
+        // p.i: [lon, lat, alt] initial position, p.ct / p.cr: önce tümünü temizle,
+        // p.d: {id: 0/1} target tespit durumu (renk)
+        function __newStore(kind){ return { kind: kind, names: {}, features: {}, live: {}, reset: true }; }
+        window.__targets = __newStore('target');
+        window.__radars = __newStore('radar');
+        function __collection(store){ return { 'type':'FeatureCollection', 'features': Object.values(store.features) }; }
+        function __ensureEntityLayers(){
+            if (!map.getSource('targets')) {
+                map.addSource('targets', { 'type':'geojson', 'data': __collection(window.__targets) });
+                map.addLayer({ 'id':'targets-layer', 'type':'circle', 'source':'targets', 'paint':{
+                    'circle-radius': ['case', ['boolean', ['feature-state', 'hover'], false], 10, 8],
+                    'circle-color': ['case', ['boolean', ['feature-state', 'hover'], false], '#ffcc00',
+                                     ['boolean', ['get', 'detected'], false], '#ff3333', '#0066ff'],
+                    'circle-opacity': 0.9, 'circle-stroke-width': 2, 'circle-stroke-color': '#ffffff' } });
+                window.__targets.reset = true;
+            }
+            if (!map.getSource('radars')) {
+                map.addSource('radars', { 'type':'geojson', 'data': __collection(window.__radars) });
+                map.addLayer({ 'id':'radars-layer', 'type':'symbol', 'source':'radars', 'layout':{
+                    'text-field':'✦', 'text-font':['Open Sans Regular','Arial Unicode MS Regular'], 'text-size': 20,
+                    'text-anchor':'center', 'text-allow-overlap': true, 'text-ignore-placement': true },
+                    'paint':{ 'text-color': ['coalesce', ['get', 'color'], '#ff0000'], 'text-halo-color':'#ffffff', 'text-halo-width':1 } });
+                window.__radars.reset = true;
+            }
+        }
+        // Store'a konum yazar; değişen id'leri döndürür
+        function __stage(store, flat, removed){
+            const changed = [];
+            for (let i = 0; i + 3 < flat.length; i += 4) {
+                const id = flat[i];
+                const f = store.features[id];
+                if (f) {
+                    f.geometry.coordinates[0] = flat[i+1]; f.geometry.coordinates[1] = flat[i+2];
+                    f.properties.altitude = flat[i+3];
+                } else {
+                    store.features[id] = { 'type':'Feature', 'id':id, 'geometry':{ 'type':'Point', 'coordinates':[flat[i+1], flat[i+2]] },
+                                           'properties':{ 'name':store.names[id], 'altitude':flat[i+3], 'type':store.kind, 'detected':false } };
+                }
+                changed.push(id);
+            }
+            (removed || []).forEach(id => { delete store.features[id]; delete store.names[id]; });
+            return changed;
+        }
+        // Yalnızca değişenleri kaynağa uygula (updateData yoksa setData)
+        function __commit(sourceId, store, changed, removed){
+            if (!window.__mapReady) { store.reset = true; return; }
+            const src = map.getSource(sourceId);
+            if (!src) return;
+            if (store.reset || typeof src.updateData !== 'function') {
+                src.setData(__collection(store));
+                store.live = {};
+                for (const id in store.features) store.live[id] = true;
+                store.reset = false;
+                return;
+            }
+            if (changed.length === 0 && (!removed || removed.length === 0)) return;
+            const diff = { add: [], update: [], remove: [] };
+            changed.forEach(id => {
+                const f = store.features[id];
+                if (!f) return;
+                if (store.live[id]) diff.update.push({ id: id, newGeometry: f.geometry, addOrUpdateProperties: [{ key: 'altitude', value: f.properties.altitude },
+                                                                                                                 { key: 'detected', value: f.properties.detected }] });
+                else { diff.add.push(f); store.live[id] = true; }
+            });
+            (removed || []).forEach(id => { if (store.live[id]) { diff.remove.push(id); delete store.live[id]; } });
+            src.updateData(diff);
+        }
+        window.__applyFrame = function(p){
+            if (p.ct) window.__clearEntities('target');
+            if (p.cr) window.__clearEntities('radar');
+            if (p.n) for (const id in p.n) window.__targets.names[id] = p.n[id];
+            if (p.rn) for (const id in p.rn) window.__radars.names[id] = p.rn[id];
+            const ct = __stage(window.__targets, p.t || [], p.x);
+            const cr = __stage(window.__radars, p.r || [], p.rx);
+            if (p.d) {
+                // Aşamalanmış id'ler (tespit değişenler tekrar eklenmez)
+                const staged = new Set(ct);
+                for (const id in p.d) {
+                    const f = window.__targets.features[id];
+                    if (!f) continue;
+                    f.properties.detected = p.d[id] === 1;
+                    const n = Number(id);
+                    if (!staged.has(n)) { staged.add(n); ct.push(n); }
+                }
+            }
+            if (!window.__mapReady) { window.__targets.reset = true; window.__radars.reset = true; return; }
+            try {
+                __ensureEntityLayers();
+                __commit('targets', window.__targets, ct, p.x);
+                __commit('radars', window.__radars, cr, p.rx);
+            } catch (e) { console.warn('frame flush failed', e); }
+            if (p.i) {
+                const src = map.getSource('initial-pos');
+                if (src) src.setData({ 'type':'Feature', 'geometry':{ 'type':'Point', 'coordinates':[p.i[0], p.i[1]] },
+                                       'properties':{ 'name':'Initial Position', 'altitude':p.i[2], 'type':'initial_position' } });
+            }
+        };
+        window.__flushAll = function(){
+            if (!window.__mapReady) return;
+            try {
+                __ensureEntityLayers();
+                __commit('targets', window.__targets, [], []);
+                __commit('radars', window.__radars, [], []);
+            } catch (e) { console.warn('initial flush failed', e); }
+        };
+
+        // QWebChannel köprüsü (MapBridge): paketlenmiş Float64 kareleri metin
+        // ayrıştırmadan okunur ve __applyFrame'e verilir.
+        window.__applyPacked = function(b64, meta){
+            const m = meta ? JSON.parse(meta) : {};
+            const bin = atob(b64);
+            const bytes = new Uint8Array(bin.length);
+            for (let i = 0; i < bin.length; ++i) bytes[i] = bin.charCodeAt(i);
+            const f = new Float64Array(bytes.buffer);
+            const nt = f[0], nr = f[1];
+            let o = 3;
+            const p = { ct: m.ct, cr: m.cr, n: m.n, x: m.x, rn: m.rn, rx: m.rx, d: m.d, t: f.subarray(o, o + 4 * nt) };
+            o += 4 * nt;
+            p.r = f.subarray(o, o + 4 * nr);
+            o += 4 * nr;
+            if (f[2]) p.i = [f[o], f[o+1], f[o+2]];
+            window.__applyFrame(p);
+        };
+        if (typeof qt !== 'undefined' && qt.webChannelTransport) {
+            new QWebChannel(qt.webChannelTransport, function(channel){
+                const bridge = channel.objects.mapBridge;
+                bridge.framePushed.connect(window.__applyPacked);
+                bridge.notifyReady();
+            });
+        }
+
+        window.__clearEntities = function(kind){
+            const key = (kind === 'radar') ? '__radars' : '__targets';
+            window[key] = __newStore(kind);
+            const src = window.__mapReady ? map.getSource(kind === 'radar' ? 'radars' : 'targets') : null;
+            if (src) { src.setData(__collection(window[key])); window[key].reset = false; }
+        };
+
         const map = new maplibregl.Map({
             container: 'map',
-            style: 'https://api.maptiler.com/maps/01988441-8731-71a1-a587-039aeb5bfab4/style.json?key=4GG7QQD4WbEvrdaLs9UX',
+            style: '@STYLE_URL@',
             renderWorldCopies: true,
             center: [)";
     
@@ -181,6 +396,7 @@ QString MapWidget::generateMapHTML()
         map.on('load', function() {
             console.log('Map loaded successfully');
             window.__mapReady = true;
+            window.__flushAll();
             )";
 
     for (int i = 0; i < markers.size(); ++i) {
@@ -249,6 +465,21 @@ QString MapWidget::generateMapHTML()
 </body>
 </html>
 )";
+
+    const bool localMapLibre = QFile::exists(QDir(TileSchemeHandler::assetsDir()).filePath("maplibre-gl.min.js"));
+    html.replace(QStringLiteral("@MAPLIBRE_BASE@"),
+                 localMapLibre ? QString("%1://assets").arg(TileSchemeHandler::schemeName())
+                               : QStringLiteral("https://cdn.jsdelivr.net/npm/maplibre-gl@3.6.2/dist"));
+    html.replace(QStringLiteral("@STYLE_URL@"), offlineTiles ? mapStyleUrl : mapStyleUrl + "?key=" + mapKey);
+
+    // qwebchannel.js Qt kaynaklarından satır içi eklenir (setHtml sayfası qrc'ye erişemez)
+    QFile channelJs(QStringLiteral(":/qtwebchannel/qwebchannel.js"));
+    if (channelJs.open(QIODevice::ReadOnly)) {
+        html.replace(QStringLiteral("</head>"),
+                     QStringLiteral("<script>") + QString::fromUtf8(channelJs.readAll()) + QStringLiteral("</script>\n</head>"));
+    } else {
+        qDebug() << "qwebchannel.js not found; map position updates disabled";
+    }
     
     return html;
 }
@@ -338,7 +569,10 @@ void MapWidget::onLoadFinished(bool success)
                 " if (window.__hoverInited) return;\n"
                 " function safe(){ if(!(window.__mapReady && typeof map!=='undefined')){ setTimeout(safe,150); return;}\n"
                 "  try{ const hoverPopup = new maplibregl.Popup({ closeButton:false, closeOnClick:false });\n"
-                "   map.on('mousemove', function(e){ try{ const feats = map.queryRenderedFeatures(e.point); const tf = feats.find(f=>f.layer && f.layer.id && f.layer.id.indexOf('target-layer-')===0); if(tf && tf.properties && tf.properties.name){ hoverPopup.setLngLat(e.lngLat).setText(tf.properties.name).addTo(map); } else { try{ hoverPopup.remove(); }catch(err){} } }catch(err){} });\n"
+                "   let hoverId = null;\n"
+                "   function setHover(id){ if (hoverId === id) return; if (hoverId !== null) map.setFeatureState({ source:'targets', id:hoverId }, { hover:false }); hoverId = id; if (id !== null) map.setFeatureState({ source:'targets', id:id }, { hover:true }); }\n"
+                "   map.on('mousemove', function(e){ try{ const feats = map.getLayer('targets-layer') ? map.queryRenderedFeatures(e.point, { layers: ['targets-layer'] }) : []; const tf = feats[0]; if(tf && tf.properties && tf.properties.name){ setHover(tf.id); hoverPopup.setLngLat(e.lngLat).setText(tf.properties.name).addTo(map); } else { setHover(null); try{ hoverPopup.remove(); }catch(err){} } }catch(err){} });\n"
+
                 "   window.__hoverInited = true; }catch(err){ console.warn('hover init failed', err);} }\n"
                 " safe();\n"
                 "})();";
@@ -634,119 +868,131 @@ void MapWidget::clearTrajectories()
 // Target fonksiyonları
 void MapWidget::addTarget(const Target &target)
 {
-    if (!webView || !webView->page()) return;
-    
-    // WGS84 koordinatları - MapLibre GL JS [longitude, latitude] formatı bekler
-    double wgs84Lon = Geo::wrapLon(target.initLongitude);
-    double wgs84Lat = target.initLatitude;
-    
-    QString script = QString(
-        "(function(){"
-        "try{ if(map.getLayer('target-layer-%1')) map.removeLayer('target-layer-%1'); }catch(e){}"
-        "try{ if(map.getSource('target-%1')) map.removeSource('target-%1'); }catch(e){}"
-        "map.addSource('target-%1', {"
-        "    'type': 'geojson',"
-        "    'data': {"
-        "        'type': 'Feature',"
-        "        'geometry': {"
-        "            'type': 'Point',"
-        "            'coordinates': [%2, %3]"
-        "        },"
-        "        'properties': {"
-        "            'name': '%4',"
-        "            'altitude': %5,"
-        "            'type': 'target'"
-        "        }"
-        "    }"
-        "});"
-        "map.addLayer({"
-        "    'id': 'target-layer-%1',"
-        "    'type': 'circle',"
-        "    'source': 'target-%1',"
-        "    'paint': {"
-        "        'circle-radius': 8,"
-        "        'circle-color': '#0066ff',"
-        "        'circle-opacity': 0.6,"
-        "        'circle-stroke-width': 1,"
-        "        'circle-stroke-color': '#ffffff'"
-        "    }"
-        "});"
-        "})();"
-    ).arg(target.name)
-     .arg(wgs84Lon, 0, 'f', 6)
-     .arg(wgs84Lat, 0, 'f', 6)
-     .arg(target.name)
-     .arg(target.initAltitude);
-    
-    webView->page()->runJavaScript(script);
+    // Tek 'targets' FeatureCollection'a bir sonraki karede eklenir
+    pendingTargets.insert(target.name, NamedPoint{ target.initLatitude, target.initLongitude, target.initAltitude });
+    scheduleFlush();
 }
 
 void MapWidget::removeTarget(const QString &targetName)
 {
-    if (!webView || !webView->page()) return;
-    
-    QString script = QString(
-        "if (map.getLayer('target-layer-%1')) {"
-        "    map.removeLayer('target-layer-%1');"
-        "}"
-        "if (map.getSource('target-%1')) {"
-        "    map.removeSource('target-%1');"
-        "}"
-    ).arg(targetName);
-    
-    webView->page()->runJavaScript(script);
+    pendingTargets.remove(targetName);
+    pendingDetected.remove(targetName);
+    auto it = targetFeatureIds.find(targetName);
+    if (it == targetFeatureIds.end()) return;
+    removedTargetIds.append(it.value());
+    targetFeatureIds.erase(it);
+    scheduleFlush();
 }
 
 void MapWidget::updateTargetPosition(const QString &targetName, double lat, double lon, double alt)
 {
-    if (!webView || !webView->page()) return;
-    
-    // WGS84 koordinatları - MapLibre GL JS [longitude, latitude] formatı bekler
-    double wgs84Lon = Geo::wrapLon(lon);
-    double wgs84Lat = lat;
-    
-    QString script = QString(
-        "(function(){"
-        "var src = map.getSource('target-%1');"
-        "if (!src) {"
-        "    try{ if(map.getLayer('target-layer-%1')) map.removeLayer('target-layer-%1'); }catch(e){}"
-        "    try{ if(map.getSource('target-%1')) map.removeSource('target-%1'); }catch(e){}"
-        "    map.addSource('target-%1', {"
-        "        'type': 'geojson',"
-        "        'data': {"
-        "            'type': 'Feature',"
-        "            'geometry': { 'type': 'Point', 'coordinates': [%2, %3] },"
-        "            'properties': { 'name': '%1', 'altitude': %4, 'type': 'target' }"
-        "        }"
-        "    });"
-        "    map.addLayer({ 'id': 'target-layer-%1', 'type': 'circle', 'source': 'target-%1', 'paint': {"
-        "        'circle-radius': 8, 'circle-color': '#0066ff', 'circle-opacity': 0.9, 'circle-stroke-width': 2, 'circle-stroke-color': '#ffffff' } });"
-        "    src = map.getSource('target-%1');"
-        "}"
-        "if (src) {"
-        "    src.setData({ 'type': 'Feature', 'geometry': { 'type': 'Point', 'coordinates': [%2, %3] }, 'properties': { 'name': '%1', 'altitude': %4, 'type': 'target' } });"
-        "}"
-        "})();"
-    ).arg(targetName)
-     .arg(wgs84Lon, 0, 'f', 6)
-     .arg(wgs84Lat, 0, 'f', 6)
-     .arg(alt);
-    
-    webView->page()->runJavaScript(script);
+    // Yalnızca kirli olarak işaretle; kare içindeki ara konumlar üzerine yazılır
+    pendingTargets.insert(targetName, NamedPoint{ lat, lon, alt });
+    scheduleFlush();
+}
+
+void MapWidget::setTargetDetected(const QString &targetName, bool detected)
+{
+    pendingDetected.insert(targetName, detected);
+    scheduleFlush();
 }
 
 void MapWidget::clearTargets()
+{
+    pendingTargets.clear();
+    pendingDetected.clear();
+    removedTargetIds.clear();
+    targetFeatureIds.clear();
+    // Kareyle aynı kanaldan gitsin ki önceki karelerle sırası bozulmasın
+    clearTargetsPending = true;
+    scheduleFlush();
+}
+
+void MapWidget::scheduleFlush()
+{
+    if (flushTimer && !flushTimer->isActive()) flushTimer->start();
+}
+
+void MapWidget::flushPendingUpdates()
 {
     if (!webView || !webView->page()) return;
-    
-    webView->page()->runJavaScript(
-        "(function(){"
-        "const layers = map.getStyle().layers;"
-        "layers.forEach(layer => { if (layer.id.startsWith('target-layer-') || layer.id.startsWith('target-label-')) { map.removeLayer(layer.id); } });"
-        "const sources = Object.keys(map.getStyle().sources);"
-        "sources.forEach(src => { if (src.startsWith('target-')) { map.removeSource(src); } });"
-        "})();"
-    );
+    // Kanal hazır değilse bekleyenler birikmeye devam eder (readyChanged ile gelinir)
+    if (!bridge || !bridge->isReady()) return;
+    if (pendingTargets.isEmpty() && pendingRadars.isEmpty() && removedTargetIds.isEmpty() && pendingDetected.isEmpty()
+        && removedRadarIds.isEmpty() && !hasPendingInitial && !clearTargetsPending && !clearRadarsPending) return;
+
+    // Paket: [nT, nR, hasInitial, nT x (id,lon,lat,alt), nR x (id,lon,lat,alt), (lon,lat,alt)]
+    // İsimler ve silinen id'ler yalnızca gerektiğinde meta JSON'da gider.
+    QJsonObject newNames;
+    QJsonObject newRadarNames;
+    frameBuffer.resize(3 + 4 * (pendingTargets.size() + pendingRadars.size()) + (hasPendingInitial ? 3 : 0));
+    double *f = frameBuffer.data();
+    *f++ = pendingTargets.size();
+    *f++ = pendingRadars.size();
+    *f++ = hasPendingInitial ? 1.0 : 0.0;
+
+    auto idFor = [](QHash<QString, int> &ids, int &next, const QString &name, QJsonObject &fresh) {
+        auto it = ids.constFind(name);
+        if (it != ids.constEnd()) return it.value();
+        const int id = next++;
+        ids.insert(name, id);
+        fresh.insert(QString::number(id), name);
+        return id;
+    };
+    for (auto it = pendingTargets.constBegin(); it != pendingTargets.constEnd(); ++it) {
+        *f++ = idFor(targetFeatureIds, nextTargetFeatureId, it.key(), newNames);
+        *f++ = Geo::wrapLon(it.value().lon);
+        *f++ = it.value().lat;
+        *f++ = it.value().alt;
+    }
+    for (auto it = pendingRadars.constBegin(); it != pendingRadars.constEnd(); ++it) {
+        *f++ = idFor(radarFeatureIds, nextRadarFeatureId, it.key(), newRadarNames);
+        *f++ = Geo::wrapLon(it.value().lon);
+        *f++ = it.value().lat;
+        *f++ = it.value().alt;
+    }
+    if (hasPendingInitial) {
+        *f++ = pendingInitial.lon;
+        *f++ = pendingInitial.lat;
+        *f++ = pendingInitial.alt;
+    }
+
+    QJsonObject meta;
+    if (clearTargetsPending) meta.insert("ct", 1);
+    if (clearRadarsPending) meta.insert("cr", 1);
+    if (!newNames.isEmpty()) meta.insert("n", newNames);
+    if (!newRadarNames.isEmpty()) meta.insert("rn", newRadarNames);
+    if (!removedTargetIds.isEmpty()) {
+        QJsonArray removed;
+        for (int id : removedTargetIds) removed.append(id);
+        meta.insert("x", removed);
+    }
+    if (!removedRadarIds.isEmpty()) {
+        QJsonArray removed;
+        for (int id : removedRadarIds) removed.append(id);
+        meta.insert("rx", removed);
+    }
+    // Tespit durumu yalnızca id'si olan (haritaya gönderilmiş) target'lar için; diğerleri bekler
+    QJsonObject detected;
+    for (auto it = pendingDetected.begin(); it != pendingDetected.end();) {
+        auto id = targetFeatureIds.constFind(it.key());
+        if (id == targetFeatureIds.constEnd()) { ++it; continue; }
+        detected.insert(QString::number(id.value()), it.value() ? 1 : 0);
+        it = pendingDetected.erase(it);
+    }
+    if (!detected.isEmpty()) meta.insert("d", detected);
+
+    pendingTargets.clear();
+    pendingRadars.clear();
+    removedTargetIds.clear();
+    removedRadarIds.clear();
+    hasPendingInitial = false;
+    clearTargetsPending = false;
+    clearRadarsPending = false;
+
+    const QByteArray packed(reinterpret_cast<const char *>(frameBuffer.constData()),
+                            static_cast<int>(frameBuffer.size() * sizeof(double)));
+    bridge->pushFrame(packed, meta.isEmpty() ? QString() : QString::fromUtf8(QJsonDocument(meta).toJson(QJsonDocument::Compact)));
 }
 
 // Initial Position fonksiyonları
@@ -819,28 +1065,9 @@ void MapWidget::addInitialPosition(double lat, double lon, double alt, const QSt
 
 void MapWidget::updateInitialPosition(double lat, double lon, double alt)
 {
-    if (!webView || !webView->page()) return;
-    
-    // WGS84 koordinatları - MapLibre GL JS [longitude, latitude] formatı bekler
-    double wgs84Lon = lon;
-    double wgs84Lat = lat;
-    
-    QString script = QString(
-        "(function(){"
-        "var source = map.getSource('initial-pos');"
-        "if (source) {"
-        "    source.setData({"
-        "        'type': 'Feature',"
-        "        'geometry': { 'type': 'Point', 'coordinates': [%1, %2] },"
-        "        'properties': { 'name': 'Initial Position', 'altitude': %3, 'type': 'initial_position' }"
-        "    });"
-        "}"
-        "})();"
-    ).arg(wgs84Lon, 0, 'f', 6)
-     .arg(wgs84Lat, 0, 'f', 6)
-     .arg(alt);
-    
-    webView->page()->runJavaScript(wrapWithMapReady(script));
+    pendingInitial = NamedPoint{ lat, lon, alt };
+    hasPendingInitial = true;
+    scheduleFlush();
 }
 
 void MapWidget::clearInitialPosition()
@@ -862,62 +1089,25 @@ void MapWidget::clearInitialPosition()
 
 void MapWidget::addRadar(const QString &radarName, double lat, double lon, double alt)
 {
-    if (!webView || !webView->page()) return;
-    double wgs84Lon = Geo::wrapLon(lon);
-    double wgs84Lat = lat;
-    QString src = QString("radar-%1").arg(radarName);
-    QString layer = QString("radar-layer-%1").arg(radarName);
-    QString js = QString(
-        "(function(){"
-        "try{ if(map.getLayer('%1')) map.removeLayer('%1'); }catch(e){}"
-        "try{ if(map.getSource('%2')) map.removeSource('%2'); }catch(e){}"
-        "map.addSource('%2', { 'type':'geojson','data':{ 'type':'Feature','geometry':{ 'type':'Point','coordinates':[%3,%4]}, 'properties':{ 'name':'%5','alt':%6 }}});"
-        "map.addLayer({ 'id':'%1', 'type':'symbol', 'source':'%2', 'layout':{ 'text-field':'\\u2726', 'text-font':['Open Sans Regular','Arial Unicode MS Regular'], 'text-size': 20, 'text-anchor':'center' }, 'paint':{ 'text-color':'#ff0000', 'text-halo-color':'#ffffff', 'text-halo-width':1 }});"
-        "})();"
-    ).arg(layer, src)
-     .arg(wgs84Lon, 0, 'f', 6)
-     .arg(wgs84Lat, 0, 'f', 6)
-     .arg(radarName)
-     .arg(alt);
-    webView->page()->runJavaScript(wrapWithMapReady(js));
+    // Tek 'radars' FeatureCollection'a bir sonraki karede eklenir
+    pendingRadars.insert(radarName, NamedPoint{ lat, lon, alt });
+    scheduleFlush();
 }
 
 void MapWidget::updateRadar(const QString &radarName, double lat, double lon, double alt)
 {
-    if (!webView || !webView->page()) return;
-    double wgs84Lon = Geo::wrapLon(lon);
-    double wgs84Lat = lat;
-    QString src = QString("radar-%1").arg(radarName);
-    QString layer = QString("radar-layer-%1").arg(radarName);
-    QString js = QString(
-        "(function(){"
-        "var s = map.getSource('%1');"
-        "if (!s) {"
-        "    try{ if(map.getLayer('%2')) map.removeLayer('%2'); }catch(e){}"
-        "    try{ if(map.getSource('%1')) map.removeSource('%1'); }catch(e){}"
-        "    map.addSource('%1', { 'type':'geojson','data':{ 'type':'Feature','geometry':{ 'type':'Point','coordinates':[%3,%4]}, 'properties':{ 'name':'%1','alt':%5 }}});"
-        "    map.addLayer({ 'id':'%2', 'type':'symbol', 'source':'%1', 'layout':{ 'text-field':'\\u2726', 'text-font':['Open Sans Regular','Arial Unicode MS Regular'], 'text-size': 20, 'text-anchor':'center' }, 'paint':{ 'text-color':'#ff0000', 'text-halo-color':'#ffffff', 'text-halo-width':1 }});"
-        "    s = map.getSource('%1');"
-        "}"
-        "if (s) { s.setData({ 'type':'Feature','geometry':{ 'type':'Point','coordinates':[%3,%4]}, 'properties':{ 'name':'%1','alt':%5 }}); }"
-        "})();"
-    ).arg(src, layer)
-     .arg(wgs84Lon, 0, 'f', 6)
-     .arg(wgs84Lat, 0, 'f', 6)
-     .arg(alt);
-    webView->page()->runJavaScript(wrapWithMapReady(js));
+    pendingRadars.insert(radarName, NamedPoint{ lat, lon, alt });
+    scheduleFlush();
 }
 
 void MapWidget::removeRadar(const QString &radarName)
 {
-    if (!webView || !webView->page()) return;
-    QString src = QString("radar-%1").arg(radarName);
-    QString layer = QString("radar-layer-%1").arg(radarName);
-    QString js = QString(
-        "try{ if(map.getLayer('%1')) map.removeLayer('%1'); }catch(e){}"
-        "try{ if(map.getSource('%2')) map.removeSource('%2'); }catch(e){}"
-    ).arg(layer, src);
-    webView->page()->runJavaScript(js);
+    pendingRadars.remove(radarName);
+    auto it = radarFeatureIds.find(radarName);
+    if (it == radarFeatureIds.end()) return;
+    removedRadarIds.append(it.value());
+    radarFeatureIds.erase(it);
+    scheduleFlush();
 }
 
 QString MapWidget::wrapWithMapReady(const QString &body) const
@@ -929,8 +1119,9 @@ QString MapWidget::wrapWithMapReady(const QString &body) const
 
 void MapWidget::clearRadars()
 {
-    if (!webView || !webView->page()) return;
-    QString js =
-        "(function tryClean(){ if(window.__mapReady && typeof map!=='undefined'){ const layers = map.getStyle().layers; layers.forEach(l=>{ if(l.id && l.id.startsWith('radar-layer-')){ try{ map.removeLayer(l.id);}catch(e){} } }); const srcs = Object.keys(map.getStyle().sources); srcs.forEach(s=>{ if(s.startsWith('radar-')){ try{ map.removeSource(s);}catch(e){} } }); } else { setTimeout(tryClean, 150);} })();";
-    webView->page()->runJavaScript(js);
+    pendingRadars.clear();
+    removedRadarIds.clear();
+    radarFeatureIds.clear();
+    clearRadarsPending = true;
+    scheduleFlush();
 }
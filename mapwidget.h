@@ -12,6 +12,14 @@
 #include <QList>
 #include <QVector>
 #include <QPair>
+#include <QMap>
+#include <QHash>
+#include <memory>
+#include "simtypes.h"
+
+class QWebChannel;
+class MapBridge;
+class TileProvider;
 
 // Weather condition struct
 struct WeatherCondition {
@@ -37,40 +45,6 @@ struct DTEDFile {
     bool isVisible; // visibility flag
 };
 
-// Target struct
-struct Target {
-    QString name;
-    // Initial Position
-    double initLatitude;
-    double initLongitude;
-    double initAltitude; // m
-    double initRCS; // dBsm
-    double initVelocityN; // mps
-    double initVelocityE; // mps
-    double initVelocityD; // mps
-    // Trajectory
-    double trajLatitude;
-    double trajLongitude;
-    double trajAltitude; // m
-    double trajVelocityN; // mps
-    double trajVelocityE; // mps
-    double trajVelocityD; // mps
-    // Waypoints
-    QStringList waypoints;
-};
-
-// Radar route waypoint (for simulation)
-struct RadarRouteWaypoint {
-    double lat{0.0};
-    double lon{0.0};
-    double alt{0.0};
-    double velN{0.0};
-    double velE{0.0};
-    double velD{0.0};
-};
-
-Q_DECLARE_METATYPE(RadarRouteWaypoint)
-
 class MapWidget : public QWidget
 {
     Q_OBJECT
@@ -109,6 +83,8 @@ public:
     void addTarget(const Target &target);
     void removeTarget(const QString &targetName);
     void updateTargetPosition(const QString &targetName, double lat, double lon, double alt);
+    // Radar denklemi tespiti: target kırmızı çizilir (bir sonraki karede)
+    void setTargetDetected(const QString &targetName, bool detected);
     void clearTargets();
     
     // Initial Position fonksiyonları (General tab'dan)
@@ -121,12 +97,21 @@ public:
     void updateRadar(const QString &radarName, double lat, double lon, double alt);
     void removeRadar(const QString &radarName);
 
+    // Çevrimdışı tile arşivi (MBTiles/PMTiles) açıksa true
+    bool hasOfflineTiles() const { return offlineTiles; }
+    // Sınır kutusundaki tile'ları arka planda bellek önbelleğine alır
+    void prefetchTiles(double minLon, double minLat, double maxLon, double maxLat,
+                       int minZoom, int maxZoom);
+
 private slots:
     void onLoadFinished(bool success);
     void onLoadProgress(int progress);
+    void flushPendingUpdates();
 
 private:
     void setupWebView();
+    void setupOfflineTiles();
+    QString findTileArchive() const;
     void createMapHTML();
     QString generateMapHTML();
     QString generateWeatherConditionsJS();
@@ -135,7 +120,7 @@ private:
     void drawDTEDArea(const DTEDFile &dtedFile);
     QString wrapWithMapReady(const QString &body) const;
     void clearRadars();
-    void reapplyPendingMarkers();
+    void scheduleFlush();
 
     QWebEngineView *webView;
     QWebEnginePage *webPage;
@@ -147,6 +132,10 @@ private:
     int zoomLevel;
     QString mapStyleUrl;
     QString mapKey;
+
+    // radartiles:// şemasından sunulan yerel tile arşivi (tileprovider.h)
+    std::shared_ptr<TileProvider> tileProvider;
+    bool offlineTiles{false};
     
     // Marker'lar için
     QList<QPair<double, double>> markers;
@@ -160,9 +149,33 @@ private:
     QList<DTEDFile> dtedFiles;
     bool showDTEDAreas;
 
+    // Kare birleştirme: konum güncellemeleri burada biriktirilir ve kare başına
+    // (kFrameIntervalMs) tek runJavaScript ile uygulanır. Aynı varlığın kare içindeki
+    // ara konumları üzerine yazılır; gecikme en fazla bir karedir.
+    static constexpr int kFrameIntervalMs = 16;
     struct NamedPoint { double lat{0.0}; double lon{0.0}; double alt{0.0}; };
     QMap<QString, NamedPoint> pendingRadars;
     QMap<QString, NamedPoint> pendingTargets;
+    QHash<QString, bool> pendingDetected;
+    NamedPoint pendingInitial;
+    bool hasPendingInitial{false};
+    QTimer *flushTimer{nullptr};
+
+    // Target'lar ve radarlar ayrı birer FeatureCollection'da; isim JS'e yalnızca
+    // ilk kez gönderilir, sonrasında yalnızca sayısal feature id kullanılır.
+    QHash<QString, int> targetFeatureIds;
+    int nextTargetFeatureId{0};
+    QList<int> removedTargetIds;
+    QHash<QString, int> radarFeatureIds;
+    int nextRadarFeatureId{0};
+    QList<int> removedRadarIds;
+    bool clearTargetsPending{false};
+    bool clearRadarsPending{false};
+
+    // Konumlar QWebChannel köprüsüyle paketlenmiş Float64 olarak gider (mapbridge.h)
+    QWebChannel *webChannel{nullptr};
+    MapBridge *bridge{nullptr};
+    QVector<double> frameBuffer;
 };
 
 #endif // MAPWIDGET_H
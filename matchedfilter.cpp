@@ -0,0 +1,113 @@
+#include "matchedfilter.h"
+#include "fft.h"
+#include "workstealingpool.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+#if defined(_MSC_VER)
+#define MF_RESTRICT __restrict
+#else
+#define MF_RESTRICT __restrict__
+#endif
+
+namespace {
+
+std::size_t nextPow2(std::size_t v)
+{
+    std::size_t p = 1;
+    while (p < v) p <<= 1;
+    return p;
+}
+
+// En ucuz blok: çıktı örneği başına N log2 N / (N - M + 1). Radix-2 aşamaları
+// tüm diziyi dolaştığından 8192'nin üstü önbellekten taşar ve yavaşlar; 2M'den
+// büyük boylar yalnızca bu sınıra kadar denenir.
+std::size_t chooseFftSize(std::size_t m)
+{
+    const std::size_t first = nextPow2(std::max<std::size_t>(2 * m, 64));
+    const std::size_t last = std::max<std::size_t>(first, 8192);
+    std::size_t best = first;
+    double bestCost = 1e300;
+    for (std::size_t size = first; size <= last; size <<= 1) {
+        const double cost = double(size) * std::log2(double(size)) / double(size - m + 1);
+        if (cost < bestCost) {
+            bestCost = cost;
+            best = size;
+        }
+    }
+    return best;
+}
+
+} // namespace
+
+MatchedFilter::MatchedFilter(std::shared_ptr<const Wf::Waveform> waveform, std::size_t fftSize)
+    : wf(std::move(waveform))
+{
+    if (!wf || wf->samples == 0) throw std::invalid_argument("MatchedFilter: empty waveform");
+    m = wf->samples;
+    n = fftSize ? fftSize : chooseFftSize(m);
+    if (n < m) throw std::invalid_argument("MatchedFilter: FFT shorter than the waveform");
+    step = n - m + 1;
+    plan = FftPlan::get(n);
+
+    // R = FFT(r), saklanan conj(R) / N: ilinti X · conj(R), ters FFT ölçeği dahil
+    specRe.assign(n, 0.0f);
+    specIm.assign(n, 0.0f);
+    std::copy(wf->refRe.begin(), wf->refRe.end(), specRe.begin());
+    std::copy(wf->refIm.begin(), wf->refIm.end(), specIm.begin());
+    plan->forward(specRe.data(), specIm.data());
+    const float scale = 1.0f / float(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        specRe[i] *= scale;
+        specIm[i] *= -scale;
+    }
+}
+
+MatchedFilter::~MatchedFilter() = default;
+
+void MatchedFilter::compress(const float *inRe, const float *inIm, std::size_t length,
+                             float *outRe, float *outIm, Workspace &ws) const
+{
+    ws.re.resize(n);
+    ws.im.resize(n);
+    float *MF_RESTRICT re = ws.re.data();
+    float *MF_RESTRICT im = ws.im.data();
+    const float *MF_RESTRICT hr = specRe.data();
+    const float *MF_RESTRICT hi = specIm.data();
+
+    for (std::size_t s = 0; s < length; s += step) {
+        const std::size_t valid = std::min(n, length - s);
+        std::copy_n(inRe + s, valid, re);
+        std::copy_n(inIm + s, valid, im);
+        std::fill(re + valid, re + n, 0.0f);
+        std::fill(im + valid, im + n, 0.0f);
+
+        plan->forward(re, im);
+        for (std::size_t i = 0; i < n; ++i) {
+            const float a = re[i], b = im[i];
+            re[i] = a * hr[i] - b * hi[i];
+            im[i] = a * hi[i] + b * hr[i];
+        }
+        plan->inverse(re, im);
+
+        // Dairesel sarma yalnızca son M - 1 örnekte; ilk step örnek doğrusal ilinti
+        const std::size_t keep = std::min(step, length - s);
+        std::copy_n(re, keep, outRe + s);
+        std::copy_n(im, keep, outIm + s);
+    }
+}
+
+void MatchedFilter::compressBatch(const float *inRe, const float *inIm, std::size_t pulses, std::size_t length,
+                                  float *outRe, float *outIm, WorkStealingPool *pool)
+{
+    const std::size_t workers = pool ? std::size_t(pool->workerCount()) : 1;
+    if (workspaces.size() < workers) workspaces.resize(workers);
+    auto run = [&](std::size_t begin, std::size_t end, int worker) {
+        Workspace &ws = workspaces[std::size_t(worker)];
+        for (std::size_t p = begin; p < end; ++p)
+            compress(inRe + p * length, inIm + p * length, length, outRe + p * length, outIm + p * length, ws);
+    };
+    if (pool && pulses > 1) pool->parallelFor(pulses, 1, run);
+    else run(0, pulses, 0);
+}
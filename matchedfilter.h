@@ -0,0 +1,57 @@
+#ifndef MATCHEDFILTER_H
+#define MATCHEDFILTER_H
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+#include "alignedbuffer.h"
+#include "waveform.h"
+
+class FftPlan;
+class WorkStealingPool;
+
+// Darbe sıkıştırma: alınan menzil satırının dalga biçiminin pencereli
+// referansıyla ilintisi, y[k] = Σ_j x[k + j] r*[j] (hedef gecikmesinde tepe).
+//
+// Hızlı evrişim overlap-save ile yapılır: N noktalı bloklar N - M + 1 adımla
+// ilerler (M referans uzunluğu), her blok FFT'lenip referans spektrumunun
+// eşleniğiyle çarpılır ve ters FFT'nin ilk N - M + 1 örneği saklanır.
+// Referans spektrumu (1/N ölçeği katlanmış) kurulumda bir kez hesaplanır.
+// Tüm darbeler tek FftPlan'ı paylaşır; bir CPI'nin darbeleri compressBatch()
+// ile iş çalan havuzda paralel sıkıştırılır (worker başına çalışma alanı).
+class MatchedFilter
+{
+public:
+    struct Workspace {
+        AlignedVector<float> re, im;    // N
+    };
+
+    // fftSize 0: blok maliyetine (N log N / (N - M + 1)) göre seçilir
+    explicit MatchedFilter(std::shared_ptr<const Wf::Waveform> waveform, std::size_t fftSize = 0);
+    ~MatchedFilter();
+
+    const Wf::Waveform &waveform() const { return *wf; }
+    std::size_t fftSize() const { return n; }
+    std::size_t blockStep() const { return step; }
+
+    // Tek satır: out[k], k < length (satır sonrası sıfır kabul edilir). in ve
+    // out aynı olamaz.
+    void compress(const float *inRe, const float *inIm, std::size_t length,
+                  float *outRe, float *outIm, Workspace &ws) const;
+
+    // pulses x length satır (satır satır bitişik). pool yoksa tek thread.
+    // Çalışma alanları üyede tutulur: aynı nesnede eşzamanlı çağrılmaz.
+    void compressBatch(const float *inRe, const float *inIm, std::size_t pulses, std::size_t length,
+                       float *outRe, float *outIm, WorkStealingPool *pool);
+
+private:
+    std::shared_ptr<const Wf::Waveform> wf;
+    std::size_t m{0};
+    std::size_t n{0};
+    std::size_t step{0};
+    std::shared_ptr<const FftPlan> plan;
+    AlignedVector<float> specRe, specIm;    // conj(FFT(r)) / N
+    std::vector<Workspace> workspaces;
+};
+
+#endif // MATCHEDFILTER_H
@@ -0,0 +1,265 @@
+#include "parabolicequation.h"
+#include "fft.h"
+#include <algorithm>
+#include <cmath>
+#if defined(__SSE__) || defined(_M_X64)
+#include <xmmintrin.h>
+#endif
+
+namespace Pe {
+
+namespace {
+
+constexpr double kPi = 3.14159265358979323846;
+constexpr double kLightSpeed = 299792458.0;
+constexpr double kEarthRadius = 6371008.8;
+constexpr float kFloorDb = -200.0f;      // engel altı / sıfır alan
+
+// Soğurucu pencere ve sönümlenen modlar alanın üst kısmını denormal sayılara
+// indirir; x86'da bunlar mikrokodla işlenir ve adımı belirgin yavaşlatır.
+// Koşu süresince FTZ/DAZ açılır, çıkışta eski durum geri yüklenir.
+struct FlushDenormals {
+#if defined(__SSE__) || defined(_M_X64)
+    unsigned int saved;
+    FlushDenormals() : saved(_mm_getcsr()) { _mm_setcsr(saved | 0x8040u); }
+    ~FlushDenormals() { _mm_setcsr(saved); }
+#endif
+};
+
+std::size_t nextPow2(std::size_t v)
+{
+    std::size_t p = 1;
+    while (p < v) p <<= 1;
+    return p;
+}
+
+} // namespace
+
+Solver::Solver(const Settings &settings)
+    : cfg(settings)
+{
+    const double lambda = kLightSpeed / cfg.frequencyHz;
+    k0 = 2.0 * kPi / lambda;
+
+    // Nyquist: dz <= λ / (2 sin θmax); alan çıktının 1.5 katı (üst üçte bir soğurucu)
+    const double domain = 1.5 * cfg.height;
+    const double dzMax = lambda / (2.0 * std::sin(cfg.maxAngleDeg * kPi / 180.0));
+    n = static_cast<int>(std::min<std::size_t>(nextPow2(std::size_t(std::ceil(domain / dzMax))),
+                                               nextPow2(std::size_t(std::max(16, cfg.maxPoints)))));
+    n = std::max(n, 16);
+    dz = domain / n;
+    outBins = static_cast<int>(std::floor(cfg.height / cfg.outputStep)) + 1;
+    plan = FftPlan::get(std::size_t(2 * n));
+
+    // Sinüs modları: p_j = jπ / (N dz); 2N FFT gidiş-dönüşünün 1/(2N)'i buraya katlanır
+    const double dx = cfg.rangeStep;
+    propRe.assign(std::size_t(n), 0.0f);
+    propIm.assign(std::size_t(n), 0.0f);
+    for (int j = 1; j < n; ++j) {
+        const double p = j * kPi / (n * dz);
+        const std::complex<double> kz = std::sqrt(std::complex<double>(k0 * k0 - p * p, 0.0));
+        const std::complex<double> prop = std::exp(std::complex<double>(0.0, 1.0) * dx * (kz - k0)) / double(2 * n);
+        propRe[j] = static_cast<float>(prop.real());
+        propIm[j] = static_cast<float>(prop.imag());
+    }
+
+    // Kırılma fazı ve üst üçte birde Hann soğurucu
+    envRe.assign(std::size_t(n) + 1, 0.0f);
+    envIm.assign(std::size_t(n) + 1, 0.0f);
+    const double invRe = 1.0 / (cfg.kFactor * kEarthRadius);
+    for (int m = 0; m <= n; ++m) {
+        const double z = m * dz;
+        double w = 1.0;
+        const double start = 2.0 * domain / 3.0;
+        if (z > start) w = 0.5 * (1.0 + std::cos(kPi * (z - start) / (domain - start)));
+        const double phase = k0 * dx * z * invRe;
+        envRe[m] = static_cast<float>(w * std::cos(phase));
+        envIm[m] = static_cast<float>(w * std::sin(phase));
+    }
+
+    // Gauss kaynak (Levy): a = (k0 θbw)^2 / (8 ln 2); serbest uzay uzak alanda |u| sqrt(x) -> sqrt(k0 / 2a)
+    const double bw = cfg.beamwidthDeg * kPi / 180.0;
+    const double a = (k0 * bw) * (k0 * bw) / (8.0 * std::log(2.0));
+    norm = std::sqrt(k0 / (2.0 * a));
+
+    if (cfg.ground == Ground::Impedance) {
+        // Leontovich: du/dz + α u = 0; εc = εr + i 60 λ σ
+        const std::complex<double> epsC(cfg.permittivity, 60.0 * lambda * cfg.conductivity);
+        const std::complex<double> i(0.0, 1.0);
+        alpha = i * k0 * std::sqrt(epsC - 1.0);
+        if (cfg.polarization == Polarization::Vertical) alpha /= epsC;
+        const std::complex<double> ad = alpha * dz;
+        const std::complex<double> s = std::sqrt(1.0 + ad * ad);
+        const std::complex<double> r1 = -ad + s, r2 = -ad - s;
+        root = std::abs(r1) < std::abs(r2) ? r1 : r2;
+
+        rPow.resize(std::size_t(n) + 1);
+        std::complex<double> rp(1.0, 0.0);
+        rPowSum = 0.0;
+        for (int m = 0; m <= n; ++m) {
+            rPow[m] = rp;
+            const double wgt = (m == 0 || m == n) ? 0.5 : 1.0;
+            rPowSum += wgt * rp * rp;
+            rp *= root;
+        }
+        // Yüzey modu r^m ayrık Laplasyenin özvektörü: -p^2 = (r - 2 + 1/r) / dz^2
+        const std::complex<double> p2 = (2.0 - root - 1.0 / root) / (dz * dz);
+        const std::complex<double> kz = std::sqrt(k0 * k0 - p2);
+        surfaceProp = std::exp(i * dx * (kz - k0));
+        // Kayıpsız yüzeyde |r| -> 1; sayısal büyümeye izin verme
+        if (std::abs(surfaceProp) > 1.0) surfaceProp /= std::abs(surfaceProp);
+    }
+}
+
+Solver::~Solver() = default;
+
+void Solver::sineTransform(Workspace &ws) const
+{
+    // Tek uzantı: x = [0, f_1..f_{N-1}, 0, -f_{N-1}..-f_1]; X_k = -2i S_k
+    float *re = ws.re.data(), *im = ws.im.data();
+    const float *fr = ws.fieldRe.data(), *fi = ws.fieldIm.data();
+    const int n2 = 2 * n;
+    re[0] = im[0] = re[n] = im[n] = 0.0f;
+    for (int m = 1; m < n; ++m) {
+        re[m] = fr[m];
+        im[m] = fi[m];
+        re[n2 - m] = -fr[m];
+        im[n2 - m] = -fi[m];
+    }
+    plan->forward(re, im);
+    // Mod çarpımı tek yapıyı korur: k ve 2N - k aynı çarpanı alır
+    const float *pr = propRe.data(), *pi = propIm.data();
+    re[0] = im[0] = re[n] = im[n] = 0.0f;
+    for (int k = 1; k < n; ++k) {
+        const float xr = re[k], xi = im[k];
+        re[k] = xr * pr[k] - xi * pi[k];
+        im[k] = xr * pi[k] + xi * pr[k];
+        const float yr = re[n2 - k], yi = im[n2 - k];
+        re[n2 - k] = yr * pr[k] - yi * pi[k];
+        im[n2 - k] = yr * pi[k] + yi * pr[k];
+    }
+    plan->inverse(re, im);
+    float *outR = ws.fieldRe.data(), *outI = ws.fieldIm.data();
+    for (int m = 1; m < n; ++m) {
+        outR[m] = re[m];
+        outI[m] = im[m];
+    }
+}
+
+void Solver::stepPec(Workspace &ws) const
+{
+    ws.fieldRe[0] = ws.fieldIm[0] = 0.0f;
+    ws.fieldRe[n] = ws.fieldIm[n] = 0.0f;
+    sineTransform(ws);
+}
+
+void Solver::stepImpedance(Workspace &ws) const
+{
+    float *fr = ws.fieldRe.data(), *fi = ws.fieldIm.data();
+    fr[n] = fi[n] = 0.0f;
+
+    // Yüzey modu katsayısı A = S(u) / S(r^m)
+    std::complex<double> su(0.0, 0.0);
+    for (int m = 0; m <= n; ++m) {
+        const double wgt = (m == 0 || m == n) ? 0.5 : 1.0;
+        su += wgt * rPow[m] * std::complex<double>(fr[m], fi[m]);
+    }
+    const std::complex<double> amp = su / rPowSum * surfaceProp;
+
+    // w_m = (u_{m+1} - u_{m-1}) / 2dz + α u_m, m = 1..N-1 (w Dirichlet'tir)
+    const double inv2dz = 0.5 / dz;
+    std::vector<std::complex<double>> &y = ws.y;
+    y.resize(std::size_t(n) + 1);
+    for (int m = 1; m < n; ++m) {
+        const std::complex<double> um(fr[m], fi[m]);
+        y[m] = std::complex<double>(fr[m + 1] - fr[m - 1], fi[m + 1] - fi[m - 1]) * inv2dz + alpha * um;
+    }
+    for (int m = 1; m < n; ++m) {
+        fr[m] = static_cast<float>(y[m].real());
+        fi[m] = static_cast<float>(y[m].imag());
+    }
+    sineTransform(ws);
+
+    // u_{m+1} + 2αdz u_m - u_{m-1} = 2dz w_m'in özel çözümü: g_m = y_{m+1} - r y_m,
+    // g_{m-1} = r (2dz w_m - g_m) geriye, y_{m+1} = r y_m + g_m ileriye (ikisi de kararlı)
+    std::vector<std::complex<double>> &g = ws.g;
+    g.resize(std::size_t(n));
+    g[n - 1] = 0.0;
+    for (int m = n - 1; m >= 1; --m)
+        g[m - 1] = root * (2.0 * dz * std::complex<double>(fr[m], fi[m]) - g[m]);
+    y[0] = 0.0;
+    std::complex<double> sy(0.0, 0.0);
+    for (int m = 0; m < n; ++m) {
+        y[m + 1] = root * y[m] + g[m];
+        sy += ((m == 0) ? 0.5 : 1.0) * rPow[m] * y[m];
+    }
+    sy += 0.5 * rPow[n] * y[n];
+
+    // Özel çözümün yüzey modu bileşenini ayıkla, yayılmış A'yı ekle
+    const std::complex<double> b = amp - sy / rPowSum;
+    for (int m = 0; m <= n; ++m) {
+        const std::complex<double> u = y[m] + b * rPow[m];
+        fr[m] = static_cast<float>(u.real());
+        fi[m] = static_cast<float>(u.imag());
+    }
+}
+
+void Solver::run(double antennaHeight, const float *terrain, float *outDb, Workspace &ws) const
+{
+    const FlushDenormals ftz;
+    ws.re.resize(std::size_t(2 * n));
+    ws.im.resize(std::size_t(2 * n));
+    ws.fieldRe.assign(std::size_t(n) + 1, 0.0f);
+    ws.fieldIm.assign(std::size_t(n) + 1, 0.0f);
+
+    // Kaynak ve görüntüsü (yerde yansıma katsayısı sıyırma açısında ~ -1)
+    const double bw = cfg.beamwidthDeg * kPi / 180.0;
+    const double a = (k0 * bw) * (k0 * bw) / (8.0 * std::log(2.0));
+    const double ks = k0 * std::sin(cfg.elevationDeg * kPi / 180.0);
+    const double za = antennaHeight;
+    for (int m = 0; m <= n; ++m) {
+        const double z = m * dz;
+        const std::complex<double> direct = std::exp(-a * (z - za) * (z - za)) * std::exp(std::complex<double>(0.0, ks * z));
+        const std::complex<double> image = std::exp(-a * (z + za) * (z + za)) * std::exp(std::complex<double>(0.0, -ks * z));
+        const std::complex<double> u = direct - image;
+        ws.fieldRe[m] = static_cast<float>(u.real());
+        ws.fieldIm[m] = static_cast<float>(u.imag());
+    }
+
+    const double invDz = 1.0 / dz;
+    for (int s = 0; s < cfg.rangeSteps; ++s) {
+        if (cfg.ground == Ground::Impedance) stepImpedance(ws);
+        else stepPec(ws);
+
+        float *fr = ws.fieldRe.data(), *fi = ws.fieldIm.data();
+        const float *er = envRe.data(), *ei = envIm.data();
+        for (int m = 0; m <= n; ++m) {
+            const float xr = fr[m], xi = fi[m];
+            fr[m] = xr * er[m] - xi * ei[m];
+            fi[m] = xr * ei[m] + xi * er[m];
+        }
+        // Merdiven arazi: engel altındaki alan sıfır
+        const int below = std::min(n, static_cast<int>(std::floor(terrain[s] * invDz)));
+        for (int m = 0; m <= below; ++m) fr[m] = fi[m] = 0.0f;
+
+        // F = |u| sqrt(x) / C, çıktı yüksekliklerinde doğrusal enterpolasyon
+        const double x = (s + 1) * cfg.rangeStep;
+        const double scale = std::sqrt(x) / norm;
+        float *row = outDb + std::size_t(s) * outBins;
+        for (int k = 0; k < outBins; ++k) {
+            const double z = k * cfg.outputStep;
+            if (z <= terrain[s]) {
+                row[k] = kFloorDb;
+                continue;
+            }
+            const double pos = z * invDz;
+            const int m = std::min(n - 1, static_cast<int>(pos));
+            const double t = pos - m;
+            const double a0 = std::hypot(fr[m], fi[m]), a1 = std::hypot(fr[m + 1], fi[m + 1]);
+            const double f = ((1.0 - t) * a0 + t * a1) * scale;
+            row[k] = f > 1e-10 ? static_cast<float>(20.0 * std::log10(f)) : kFloorDb;
+        }
+    }
+}
+
+} // namespace Pe
@@ -0,0 +1,93 @@
+#ifndef PARABOLICEQUATION_H
+#define PARABOLICEQUATION_H
+
+#include <complex>
+#include <cstddef>
+#include <memory>
+#include <vector>
+#include "alignedbuffer.h"
+
+class FftPlan;
+
+// Split-step Fourier parabolik denklem (PE) yayılım çözücüsü (yalnızca std).
+//
+// Geniş açılı PE, yükseklik ekseninde ayrık sinüs (PEC, yatay pol.) ya da ayrık
+// karma Fourier dönüşümüyle (empedans yüzeyi, Dockery-Kuttler DMFT) adım adım
+// ilerletilir. Kırılma, etkin dünya yarıçapı (k*R) ile düzeltilmiş kırılma
+// indisi m(z) - 1 = z / (kR) olarak faz ekranına girer; arazi merdiven
+// yaklaşımıyla (engel altındaki alan sıfırlanır) uygulanır. Alanın üst üçte biri
+// Hann penceresiyle soğurulur.
+//
+// Sonuç yayılım faktörüdür: F = |u| sqrt(x) / C, C kaynağın serbest uzay
+// normalizasyonu (ana hüzme ekseninde uzak alanda F = 1). Çıktı 20 log10 F (dB).
+namespace Pe {
+
+enum class Ground { Pec, Impedance };
+enum class Polarization { Horizontal, Vertical };
+
+struct Settings {
+    double frequencyHz{3.0e9};
+    double beamwidthDeg{2.0};        // tam 3 dB hüzme genişliği
+    double elevationDeg{0.0};
+    Polarization polarization{Polarization::Horizontal};
+    Ground ground{Ground::Pec};
+    double conductivity{0.005};      // S/m
+    double permittivity{15.0};       // bağıl dielektrik sabiti
+    double kFactor{4.0 / 3.0};
+    double maxAngleDeg{2.0};         // yükseklik adımını belirleyen en büyük yayılım açısı
+    double height{3000.0};           // çıktının kapsadığı yükseklik (m), alan 1.5 katıdır
+    double rangeStep{1000.0};        // m
+    int rangeSteps{100};
+    double outputStep{100.0};        // çıktı yükseklik adımı (m)
+    int maxPoints{1 << 15};          // yükseklik nokta sayısı üst sınırı
+};
+
+// Worker başına çalışma alanı (hizalı tamponlar, yeniden kullanılır)
+struct Workspace {
+    AlignedVector<float> re, im;     // 2N (tek uzantılı sinüs dönüşümü)
+    AlignedVector<float> fieldRe, fieldIm;   // N + 1 nokta, z_m = m * dz
+    std::vector<std::complex<double>> y, g;  // DMFT geri dönüşümü
+};
+
+class Solver
+{
+public:
+    explicit Solver(const Settings &settings);
+    ~Solver();
+
+    const Settings &settings() const { return cfg; }
+    int points() const { return n; }            // N (yükseklik aralığı sayısı)
+    double heightStep() const { return dz; }
+    int outputBins() const { return outBins; }  // 0, outputStep, ... height
+
+    // antennaHeight: kaynak yüksekliği (m, alan tabanının z = 0 üstünde).
+    // terrain[s]: s. adımın (x = (s+1) * rangeStep) sonundaki zemin yüksekliği (m,
+    // alan tabanına göre; <= 0 düz). outDb[s * outputBins() + k] = 20 log10 F.
+    void run(double antennaHeight, const float *terrain, float *outDb, Workspace &ws) const;
+
+private:
+    void sineTransform(Workspace &ws) const;     // fieldRe/Im[1..N-1] yerinde, 2N FFT ile
+    void stepPec(Workspace &ws) const;
+    void stepImpedance(Workspace &ws) const;
+
+    Settings cfg;
+    int n{0};
+    double dz{0.0};
+    double k0{0.0};
+    int outBins{0};
+    double norm{1.0};                            // C
+    std::shared_ptr<const FftPlan> plan;         // 2N
+
+    AlignedVector<float> propRe, propIm;         // sinüs modu j için exp(i dx (sqrt(k0^2 - p^2) - k0)), 1/(2N) ölçekli
+    AlignedVector<float> envRe, envIm;           // kırılma fazı * soğurucu pencere, z_m
+    // DMFT
+    std::complex<double> alpha{0.0, 0.0};
+    std::complex<double> root{0.0, 0.0};         // r^2 + 2 alpha dz r - 1 = 0, |r| < 1
+    std::complex<double> surfaceProp{1.0, 0.0};
+    std::vector<std::complex<double>> rPow;      // r^m
+    std::complex<double> rPowSum{0.0, 0.0};      // S(r^m)
+};
+
+} // namespace Pe
+
+#endif // PARABOLICEQUATION_H
@@ -0,0 +1,237 @@
+#include "propagationfield.h"
+#include "terraincache.h"
+#include "terrainmodel.h"
+#include "workstealingpool.h"
+#include "geo.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <limits>
+
+namespace {
+
+// Menzil adımı sayısı üst sınırı (çok küçük Distance Step girişine karşı)
+constexpr int kMaxRangeBins = 20000;
+// Gauss örüntüsü ana hüzme dışında gerçekçi olmayan derinliğe iner; serbest uzay
+// bölgesinde yan lob seviyesinde kesilir
+constexpr double kSidelobeDb = -40.0;
+
+} // namespace
+
+PropagationField::PropagationField(const Settings &settings)
+    : cfg(settings)
+{
+    cfg.azimuthBins = std::max(1, cfg.azimuthBins);
+    cfg.altitudeStep = std::max(1.0, cfg.altitudeStep);
+    cfg.distanceStep = std::max(1.0, cfg.distanceStep);
+    rBins = std::clamp(static_cast<int>(std::ceil(cfg.maxDistance / cfg.distanceStep - 1e-6)), 1, kMaxRangeBins);
+    radials.resize(std::size_t(cfg.azimuthBins));
+}
+
+PropagationField::~PropagationField() = default;
+
+void PropagationField::rebuildSolver(double antennaAlt)
+{
+    // Düşük açı bölgesi: θmax üstündeki ışınlar serbest uzay sayılır
+    const double reach = std::max(0.0, antennaAlt) + cfg.maxDistance * std::tan(cfg.pe.maxAngleDeg * Geo::deg2rad);
+    top = std::min(cfg.maxAltitude, std::ceil(reach / cfg.altitudeStep) * cfg.altitudeStep);
+    top = std::max(top, cfg.altitudeStep);
+
+    Pe::Settings pe = cfg.pe;
+    pe.height = top;
+    pe.rangeStep = cfg.distanceStep;
+    pe.rangeSteps = rBins;
+    pe.outputStep = cfg.altitudeStep;
+    solver = std::make_unique<Pe::Solver>(pe);
+    aBins = solver->outputBins();
+
+    values.assign(std::size_t(cfg.azimuthBins) * rBins * aBins, 0.0f);
+    for (Radial &r : radials) r.solved = false;
+}
+
+void PropagationField::setRadar(const Los::Endpoint &position, double time)
+{
+    radar = position;
+    now = time;
+    radarSet = true;
+    const double reach = std::max(0.0, radar.alt) + cfg.maxDistance * std::tan(cfg.pe.maxAngleDeg * Geo::deg2rad);
+    // Tepe yetmiyorsa ya da gereğinin iki katından büyükse (boşa N) yeniden kur
+    if (!solver || (reach > top && top < cfg.maxAltitude) || reach < 0.5 * top) rebuildSolver(radar.alt);
+}
+
+double PropagationField::displacement(const Radial &r) const
+{
+    if (!r.solved) return std::numeric_limits<double>::infinity();
+    double x0, y0, z0, x1, y1, z1;
+    Geo::geodeticToECEF(r.origin.lat, r.origin.lon, r.origin.alt, x0, y0, z0);
+    Geo::geodeticToECEF(radar.lat, radar.lon, radar.alt, x1, y1, z1);
+    return std::sqrt((x1 - x0) * (x1 - x0) + (y1 - y0) * (y1 - y0) + (z1 - z0) * (z1 - z0));
+}
+
+int PropagationField::staleRadials() const
+{
+    int n = 0;
+    for (const Radial &r : radials) n += displacement(r) > cfg.moveThreshold ? 1 : 0;
+    return n;
+}
+
+int PropagationField::refresh(TerrainTileCache &terrain, WorkStealingPool &pool, int budget,
+                              const std::vector<int> *only)
+{
+    using Clock = std::chrono::steady_clock;
+    const auto t0 = Clock::now();
+    stats = Stats{};
+    if (!radarSet) return 0;
+
+    // En bayat (hiç çözülmemiş, sonra en çok kaymış) radyaller önce
+    std::vector<std::pair<double, int>> stale;
+    auto consider = [&](int a) {
+        const double d = displacement(radials[a]);
+        if (d > cfg.moveThreshold) stale.push_back({d, a});
+    };
+    if (only) {
+        for (int a : *only)
+            if (a >= 0 && a < cfg.azimuthBins) consider(a);
+    } else {
+        for (int a = 0; a < cfg.azimuthBins; ++a) consider(a);
+    }
+    std::stable_sort(stale.begin(), stale.end(), [](const auto &x, const auto &y) { return x.first > y.first; });
+    const std::size_t count = budget > 0 ? std::min(stale.size(), std::size_t(budget)) : stale.size();
+
+    const int workers = pool.workerCount();
+    std::vector<std::unique_ptr<Los::Scratch>> scratch(workers);
+    std::vector<std::unique_ptr<Pe::Workspace>> spaces(workers);
+
+    const Los::Endpoint origin = radar;
+    const std::size_t stride = std::size_t(rBins) * aBins;
+    const int perStep = std::max(1, static_cast<int>(std::ceil(cfg.distanceStep / cfg.sampleSpacing)));
+    const double dx = cfg.distanceStep / perStep;
+    const long total = long(rBins) * perStep;
+
+    // Profil yeniden kullanımı yalnızca yatay kaymaya bakar (irtifa değişimi profili bozmaz)
+    double ox, oy, oz;
+    Geo::geodeticToECEF(origin.lat, origin.lon, 0.0, ox, oy, oz);
+    const double reuse2 = cfg.profileReuseDistance * cfg.profileReuseDistance;
+    std::atomic<int> reused{0};
+
+    pool.parallelFor(count, 1, [&](std::size_t begin, std::size_t end, int worker) {
+        if (!spaces[worker]) {
+            scratch[worker] = std::make_unique<Los::Scratch>();
+            spaces[worker] = std::make_unique<Pe::Workspace>();
+        }
+        Los::Scratch &s = *scratch[worker];
+
+        for (std::size_t i = begin; i < end; ++i) {
+            const int a = stale[i].second;
+            Radial &radial = radials[a];
+            float *profile = radial.profile.data();
+            if (!radial.profile.empty()) {
+                double px, py, pz;
+                Geo::geodeticToECEF(radial.profileOrigin.lat, radial.profileOrigin.lon, 0.0, px, py, pz);
+                const double d2 = (px - ox) * (px - ox) + (py - oy) * (py - oy) + (pz - oz) * (pz - oz);
+                if (d2 <= reuse2) {
+                    solver->run(std::max(origin.alt, radial.ground + cfg.minAntennaAgl), profile,
+                                values.data() + std::size_t(a) * stride, *spaces[worker]);
+                    radial.origin = origin;
+                    radial.solvedAt = now;
+                    radial.solved = true;
+                    reused.fetch_add(1, std::memory_order_relaxed);
+                    continue;
+                }
+            }
+
+            radial.profile.assign(std::size_t(rBins), 0.0f);
+            profile = radial.profile.data();
+            const double az = 360.0 * a / cfg.azimuthBins;
+            double ground = 0.0;
+            if (!cfg.flatTerrain) {
+                // Reader yalnızca profil örneklemesi boyunca açık; PE çözümü epoch'u tutmaz
+                TerrainTileCache::Reader reader(terrain);
+                ground = std::max(0.0, TerrainModel::heightAt(reader, origin.lat, origin.lon));
+                // Merdiven profili: her PE adımı kendi aralığındaki en yüksek örneği alır
+                for (long j0 = 1; j0 <= total; j0 += long(Los::Scratch::kChunk)) {
+                    const int m = static_cast<int>(std::min(long(Los::Scratch::kChunk), total - j0 + 1));
+                    const Los::Endpoint pa = Los::destination(origin.lat, origin.lon, az, j0 * dx);
+                    const Los::Endpoint pb = Los::destination(origin.lat, origin.lon, az, (j0 + m - 1) * dx);
+                    const Los::Path path(pa, pb);
+                    TerrainModel::heightsOnArc(reader, path.arc(0.0, m > 1 ? 1.0 / (m - 1) : 0.0), s.h, std::size_t(m));
+                    for (int j = 0; j < m; ++j) {
+                        float &h = profile[(j0 + j - 1) / perStep];
+                        h = std::max(h, s.h[j]);
+                    }
+                }
+            }
+            radial.profileOrigin = origin;
+            radial.ground = ground;
+            const double antenna = std::max(origin.alt, ground + cfg.minAntennaAgl);
+            solver->run(antenna, profile, values.data() + std::size_t(a) * stride, *spaces[worker]);
+            radial.origin = origin;
+            radial.solvedAt = now;
+            radial.solved = true;
+        }
+    });
+
+    stats.solved = static_cast<int>(count);
+    stats.profilesReused = reused.load();
+    stats.stale = static_cast<int>(stale.size() - count);
+    // Bayat kalıp yine de kullanılan (çözülmüş) radyallerin en eskisi
+    for (std::size_t i = count; i < stale.size(); ++i) {
+        const Radial &radial = radials[stale[i].second];
+        if (radial.solved) stats.oldestAge = std::max(stats.oldestAge, now - radial.solvedAt);
+    }
+    stats.milliseconds = std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+    return stats.solved;
+}
+
+bool PropagationField::locate(const Los::Endpoint &target, int &a, int &r, double &dist) const
+{
+    if (!radarSet) return false;
+    const double la0 = radar.lat * Geo::deg2rad, lo0 = radar.lon * Geo::deg2rad;
+    const double la1 = target.lat * Geo::deg2rad, lo1 = target.lon * Geo::deg2rad;
+    const double dLon = lo1 - lo0;
+    // Haversine menzil ve başlangıç azimutu
+    const double sLa = std::sin(0.5 * (la1 - la0)), sLo = std::sin(0.5 * dLon);
+    const double h = sLa * sLa + std::cos(la0) * std::cos(la1) * sLo * sLo;
+    dist = 2.0 * Los::earthRadius * std::asin(std::min(1.0, std::sqrt(h)));
+
+    r = std::max(0, static_cast<int>(std::lround(dist / cfg.distanceStep)) - 1);
+    if (r >= rBins) return false;
+
+    double az = std::atan2(std::sin(dLon) * std::cos(la1),
+                           std::cos(la0) * std::sin(la1) - std::sin(la0) * std::cos(la1) * std::cos(dLon)) * Geo::rad2deg;
+    if (az < 0.0) az += 360.0;
+    a = static_cast<int>(std::lround(az * cfg.azimuthBins / 360.0)) % cfg.azimuthBins;
+    return true;
+}
+
+int PropagationField::azimuthBin(const Los::Endpoint &target) const
+{
+    int a, r;
+    double dist;
+    if (target.alt > cfg.maxAltitude || !locate(target, a, r, dist)) return -1;
+    return a;
+}
+
+float PropagationField::factorDb(const Los::Endpoint &target) const
+{
+    constexpr float kNoData = std::numeric_limits<float>::quiet_NaN();
+    if (!solver || target.alt > cfg.maxAltitude) return kNoData;
+    int a, r;
+    double dist;
+    if (!locate(target, a, r, dist) || !radials[a].solved) return kNoData;
+    // PE tepesinin üstü serbest uzay: yalnızca kaynak hüzmesinin örüntüsü (PE'deki Gauss)
+    if (target.alt > top) {
+        const double elev = std::atan2(target.alt - radar.alt, std::max(dist, 1.0)) * Geo::rad2deg - cfg.pe.elevationDeg;
+        const double bw = std::max(1e-6, cfg.pe.beamwidthDeg);
+        const double patternDb = -20.0 * 2.0 * std::log(2.0) * elev * elev / (bw * bw) / std::log(10.0);
+        return static_cast<float>(std::max(patternDb, kSidelobeDb));
+    }
+
+    const float *row = values.data() + (std::size_t(a) * rBins + r) * aBins;
+    const double pos = std::max(0.0, target.alt) / cfg.altitudeStep;
+    const int k = std::min(aBins - 1, static_cast<int>(pos));
+    if (k == aBins - 1) return row[k];
+    const float t = static_cast<float>(pos - k);
+    return row[k] + t * (row[k + 1] - row[k]);
+}
@@ -0,0 +1,119 @@
+#ifndef PROPAGATIONFIELD_H
+#define PROPAGATIONFIELD_H
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+#include "lineofsight.h"
+#include "parabolicequation.h"
+
+class TerrainTileCache;
+class WorkStealingPool;
+
+// Bir radarın yayılım faktörü alanı: azimut x menzil x irtifa ızgarasında F (dB).
+//
+// Her azimut radyali için DTED'den arazi profili çıkarılır ve Pe::Solver ile
+// split-step PE çözülür; radyaller iş çalan havuzda paralel yürür (worker başına
+// bir Workspace, planlar paylaşılır). PE yalnızca düşük açı bölgesini kapsar:
+// tepe yüksekliği radar irtifası + maxDistance * tan(θmax)'tır, üstü serbest uzay
+// sayılır ve yalnızca kaynak hüzme örüntüsü uygulanır (APM benzeri melez).
+// İrtifalar deniz seviyesine göredir.
+//
+// Hareketli radar için radyaller artımlı tazelenir: her radyal çözüldüğü radar
+// konumunu saklar; radar moveThreshold'dan fazla kayınca radyal bayatlar ve
+// refresh() en bayat radyallerden bütçe kadarını yeniden çözer. Radyalin arazi
+// profili de saklanır; radar yatayda profileReuseDistance'tan az kaydıysa (ör.
+// yalnızca irtifa değişimi) yeniden örneklenmeden kullanılır. Tazeleme bütçeyle
+// sınırlı olduğundan tam tur 360 / budget refresh() sürer; radyaller çözüldükleri
+// simülasyon zamanını tutar; Stats::oldestAge bayat olduğu hâlde kullanılan en
+// eski radyalin yaşıdır (sabit radarda 0).
+//
+// Yalnızca hedef yönü modunda refresh() radyal listesiyle çağrılır: azimut
+// kovası (azimuthBin) aynı olan hedefler tek çözümü paylaşır, adım maliyeti
+// farklı hedef yönü sayısıyla ölçeklenir.
+class PropagationField
+{
+public:
+    struct Settings {
+        double maxAltitude{10000.0};    // m
+        double maxDistance{100000.0};   // m
+        double altitudeStep{100.0};     // m
+        double distanceStep{1000.0};    // m (PE menzil adımı)
+        int azimuthBins{360};
+        bool flatTerrain{false};        // DTED kullanma (deniz seviyesi)
+        double moveThreshold{200.0};    // m
+        double profileReuseDistance{30.0};  // m, yatay
+        double minAntennaAgl{2.0};      // araziye gömülü anten en az bu kadar yukarı alınır
+        double sampleSpacing{60.0};     // arazi profili örnek aralığı (m), adım başına en yüksek alınır
+        // Frekans, zemin, polarizasyon, hüzme ve kırılma; ızgara alanları
+        // (height, rangeStep, rangeSteps, outputStep) yukarıdakilerden doldurulur
+        Pe::Settings pe;
+    };
+
+    struct Stats {
+        int solved{0};                  // son refresh()'te çözülen radyal
+        int stale{0};                   // refresh() sonrası hâlâ bayat olan
+        int profilesReused{0};          // çözülenlerden arazi profili yeniden kullanılan
+        double oldestAge{0.0};          // s, bayat kalıp kullanılan radyallerin en eskisi
+        double milliseconds{0.0};
+    };
+
+    explicit PropagationField(const Settings &settings);
+    ~PropagationField();
+
+    const Settings &settings() const { return cfg; }
+
+    // Radarın güncel konumu ve simülasyon zamanı (s, radyal yaşı için). İrtifa
+    // PE tepesini aşarsa çözücü yeniden kurulur ve tüm radyaller bayatlar.
+    void setRadar(const Los::Endpoint &radar, double time = 0.0);
+
+    // Bayat radyallerden en fazla budget tanesini (<= 0: hepsini) en eskiden
+    // başlayarak paralel çözer; çözülen sayısını döndürür. only verilirse yalnızca
+    // o azimut kovalarına bakılır.
+    int refresh(TerrainTileCache &terrain, WorkStealingPool &pool, int budget,
+                const std::vector<int> *only = nullptr);
+
+    // Hedefin düştüğü azimut kovası; menzil/irtifa dışındaysa -1
+    int azimuthBin(const Los::Endpoint &target) const;
+
+    // Hedef yönündeki radyalin değeri (dB, menzilde en yakın düğüm, irtifada
+    // doğrusal). Radyal henüz çözülmediyse ya da hedef menzil/irtifa dışındaysa NaN.
+    float factorDb(const Los::Endpoint &target) const;
+
+    int azimuthBins() const { return cfg.azimuthBins; }
+    int rangeBins() const { return rBins; }
+    int altitudeBins() const { return aBins; }
+    double peTop() const { return top; }
+    int staleRadials() const;
+    const Stats &lastStats() const { return stats; }
+
+private:
+    struct Radial {
+        bool solved{false};
+        Los::Endpoint origin;           // çözüldüğü radar konumu
+        double solvedAt{0.0};           // çözüldüğü simülasyon zamanı (s)
+        std::vector<float> profile;     // adım başına zemin (m); boş: örneklenmedi
+        Los::Endpoint profileOrigin;
+        double ground{0.0};             // radar altındaki zemin
+    };
+
+    void rebuildSolver(double antennaAlt);
+    bool locate(const Los::Endpoint &target, int &azimuth, int &range, double &dist) const;
+    double displacement(const Radial &r) const;
+
+    Settings cfg;
+    Los::Endpoint radar;
+    double now{0.0};
+    bool radarSet{false};
+    int rBins{0};
+    int aBins{0};                       // 0, altitudeStep, ... top
+    double top{0.0};
+    std::unique_ptr<Pe::Solver> solver;
+
+    std::vector<Radial> radials;
+    // [(az * rBins + r) * aBins + k] = F (dB)
+    std::vector<float> values;
+    Stats stats;
+};
+
+#endif // PROPAGATIONFIELD_H
@@ -0,0 +1,91 @@
+#include "pulsescheduler.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+// splitmix64 sonlandırıcısı: (seed, tarama, tür, indeks) -> bağımsız 64 bit
+std::uint64_t mix64(std::uint64_t x)
+{
+    x += 0x9e3779b97f4a7c15ull;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ull;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebull;
+    return x ^ (x >> 31);
+}
+
+std::uint64_t draw(std::uint64_t seed, std::uint64_t scan, std::uint64_t stream, std::uint64_t index)
+{
+    return mix64(mix64(mix64(seed ^ mix64(scan)) + stream) + index);
+}
+
+// [0, n) içine taşınabilir indirgeme (dağılım gerçeklemesine bağlı değil)
+std::uint32_t below(std::uint64_t r, std::uint32_t n)
+{
+    return std::uint32_t(((r >> 32) * std::uint64_t(n)) >> 32);
+}
+
+enum Stream : std::uint64_t { PrfOrder = 1, CpiChannel = 2, PulseChannel = 3 };
+
+} // namespace
+
+PulseScheduler::PulseScheduler(const Settings &settings, std::uint64_t scan)
+    : cfg(settings)
+    , scanIndex(scan)
+{
+    if (cfg.prfHz.empty()) cfg.prfHz.push_back(750.0);
+    if (cfg.prfHz.size() > 255) cfg.prfHz.resize(255);
+    for (double &p : cfg.prfHz) p = std::max(p, 1.0);
+    cfg.pulsesPerCpi = std::max(cfg.pulsesPerCpi, 1);
+    cfg.cpisPerScan = std::max(cfg.cpisPerScan, 1);
+    // Tarama içi darbe indeksi 32 bit
+    cfg.cpisPerScan = int(std::min<std::int64_t>(cfg.cpisPerScan, (std::int64_t(1) << 31) / cfg.pulsesPerCpi));
+    cfg.channelSpacingHz = std::max(cfg.channelSpacingHz, 1.0);
+
+    if (cfg.freqHop) {
+        lowHz = std::min(cfg.lowerFrequencyHz, cfg.upperFrequencyHz);
+        const double span = std::max(cfg.lowerFrequencyHz, cfg.upperFrequencyHz) - lowHz;
+        channelCount = int(std::min(std::floor(span / cfg.channelSpacingHz) + 1.0, 65535.0));
+    } else {
+        lowHz = cfg.frequencyHz;
+        channelCount = 1;
+        cfg.everyPulse = false;
+    }
+
+    // PRF sırası: gruplar halinde, hopPrfs ile grup içi Fisher-Yates
+    const std::size_t cpis = std::size_t(cfg.cpisPerScan), n = cfg.prfHz.size();
+    cpiPrf.resize(cpis);
+    std::vector<std::uint8_t> group(n);
+    for (std::size_t g = 0; g * n < cpis; ++g) {
+        for (std::size_t i = 0; i < n; ++i) group[i] = std::uint8_t(i);
+        if (cfg.hopPrfs) {
+            for (std::size_t i = n - 1; i > 0; --i)
+                std::swap(group[i], group[below(draw(cfg.seed, scan, PrfOrder, g * n + i), std::uint32_t(i + 1))]);
+        }
+        for (std::size_t i = 0; i < n && g * n + i < cpis; ++i) cpiPrf[g * n + i] = group[i];
+    }
+
+    cpiChannel.resize(cpis);
+    for (std::size_t c = 0; c < cpis; ++c)
+        cpiChannel[c] = channelCount > 1 ? std::uint16_t(below(draw(cfg.seed, scan, CpiChannel, c), std::uint32_t(channelCount))) : 0;
+    if (cfg.everyPulse) {
+        pulseChannel.resize(pulsesPerScan());
+        for (std::size_t k = 0; k < pulseChannel.size(); ++k)
+            pulseChannel[k] = std::uint16_t(below(draw(cfg.seed, scan, PulseChannel, k), std::uint32_t(channelCount)));
+    }
+
+    priSec.resize(n);
+    for (std::size_t i = 0; i < n; ++i) priSec[i] = 1.0 / cfg.prfHz[i];
+    cpiStart.resize(cpis);
+    double t = 0.0;
+    for (std::size_t c = 0; c < cpis; ++c) {
+        cpiStart[c] = t;
+        t += double(cfg.pulsesPerCpi) * priSec[cpiPrf[c]];
+    }
+    duration = t;
+}
+
+std::size_t PulseScheduler::tableBytes() const
+{
+    return cpiPrf.size() * sizeof(std::uint8_t) + cpiChannel.size() * sizeof(std::uint16_t)
+           + pulseChannel.size() * sizeof(std::uint16_t) + (cpiStart.size() + priSec.size()) * sizeof(double);
+}
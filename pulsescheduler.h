@@ -0,0 +1,87 @@
+#ifndef PULSESCHEDULER_H
+#define PULSESCHEDULER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Darbe çizelgesi: darbe başına taşıyıcı frekans ve PRI, bir tarama için
+// kurulumda tabloya dökülür. İşleme zinciri (EchoGenerator, menzil-Doppler
+// kanalı seçimi) darbe indeksiyle bakar; sıcak yolda RNG çağrılmaz.
+//
+// PRI CPI boyunca sabittir (Doppler FFT'si için). PRF'ler sırayla ya da
+// hopPrfs ile her prfHz.size() CPI'lik grupta karışık sırada (her PRF grupta
+// bir kez, M-of-N belirsizlik çözümü için) kullanılır. Frekans atlamada
+// taşıyıcı [lower, upper] aralığındaki channelSpacing adımlı kanallardan CPI
+// başına (ya da everyPulse ile darbe başına) seçilir.
+//
+// Rastgelelik (seed, tarama, CPI / darbe) sayacından karıştırılarak üretilir:
+// tablo kuruluş sırasından, platformun dağılım gerçeklemelerinden ve thread
+// sayısından bağımsızdır; aynı ayarlar her çalıştırmada aynı diziyi verir.
+// Tarama sonrası indeksler çizelgeyi periyodik tekrarlar (zaman ilerler).
+class PulseScheduler
+{
+public:
+    struct Settings {
+        std::vector<double> prfHz{750.0};
+        bool hopPrfs{false};
+        int pulsesPerCpi{64};
+        int cpisPerScan{64};
+        double frequencyHz{3.0e9};          // atlama kapalıyken taşıyıcı
+        bool freqHop{false};
+        double lowerFrequencyHz{2.0e9};
+        double upperFrequencyHz{4.0e9};
+        double channelSpacingHz{10.0e6};
+        bool everyPulse{false};             // frekans darbe başına (Doppler uyumsuz)
+        std::uint64_t seed{1};
+    };
+
+    struct Pulse {
+        int prf;                            // Settings::prfHz indeksi
+        int cpi;                            // tarama içi CPI
+        int pulseInCpi;
+        double prfHz;
+        double frequencyHz;
+        double time;                        // s, çizelge başından gönderim anı
+    };
+
+    explicit PulseScheduler(const Settings &settings, std::uint64_t scan = 0);
+
+    const Settings &settings() const { return cfg; }
+    std::uint64_t scan() const { return scanIndex; }
+    std::size_t pulsesPerScan() const { return std::size_t(cfg.pulsesPerCpi) * cpiPrf.size(); }
+    double scanDuration() const { return duration; }
+    int channels() const { return channelCount; }
+    double channelFrequency(int channel) const { return lowHz + channel * cfg.channelSpacingHz; }
+
+    // Darbe k'nın parametreleri (k >= pulsesPerScan: sonraki taramalar, aynı dizi)
+    Pulse pulse(std::uint64_t k) const
+    {
+        // Tarama içi indeks 32 bit: bölmeler 64 bitten belirgin ucuz
+        const std::uint64_t n = pulsesPerScan(), repeat = k < n ? 0 : k / n;
+        const std::uint32_t i = std::uint32_t(k - repeat * n), ppc = std::uint32_t(cfg.pulsesPerCpi);
+        const std::size_t c = i / ppc;
+        const int inCpi = int(i - std::uint32_t(c) * ppc);
+        const int prf = cpiPrf[c];
+        const int channel = cfg.everyPulse ? pulseChannel[std::size_t(i)] : cpiChannel[c];
+        return Pulse{prf, int(c), inCpi, cfg.prfHz[std::size_t(prf)], channelFrequency(channel),
+                     double(repeat) * duration + cpiStart[c] + double(inCpi) * priSec[std::size_t(prf)]};
+    }
+
+    // Tablo boyu (bayt): CPI başına PRF + kanal + başlangıç, gerekirse darbe başına kanal
+    std::size_t tableBytes() const;
+
+private:
+    Settings cfg;
+    std::uint64_t scanIndex{0};
+    double lowHz{0.0};
+    int channelCount{1};
+    double duration{0.0};
+    std::vector<std::uint8_t> cpiPrf;
+    std::vector<std::uint16_t> cpiChannel;
+    std::vector<std::uint16_t> pulseChannel;    // yalnızca everyPulse
+    std::vector<double> cpiStart;
+    std::vector<double> priSec;                 // PRF başına 1 / PRF
+};
+
+#endif // PULSESCHEDULER_H
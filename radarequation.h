@@ -0,0 +1,162 @@
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include "geo.h"
+
+// Qt'siz radar denklemi çekirdeği (SoA). Tek radarın bir hedef satırı için
+// SNR (dB) döngüleri dallanmasız yazılmıştır ve derleyicide vektörleşir:
+//
+//   SNR = C + σ(dBsm) - 40 log10 R + 2 F(dB) - 2 Σ γ_c L_c
+//
+// C menzilden bağımsız terimdir (constantDb), F tek yönlü yayılım faktörü
+// (PE), γ_c hava hücresinin özgül zayıflaması (dB/m), L_c yolun hücre
+// içindeki uzunluğu. Konumlar ECEF (m).
+namespace RadarEq {
+
+    static constexpr double kBoltzmann = 1.380649e-23;
+    static constexpr double kLightSpeed = 299792458.0;
+    static constexpr double kPi = 3.14159265358979323846;
+
+    // Pt G² λ² τ n / ((4π)³ k T F L), dB (σ = 1 m², R = 1 m). n darbe uyumlu
+    // toplanır (10 log10 n kazanç).
+    inline double constantDb(double txPeakW, double frequencyHz, double pulseWidthS, double gainDbi,
+                             double noiseFigureDb, double temperatureK, double lossDb, double pulses)
+    {
+        const double lambda = kLightSpeed / std::max(frequencyHz, 1.0);
+        return 10.0 * std::log10(std::max(txPeakW, 1e-12)) + 2.0 * gainDbi + 20.0 * std::log10(lambda)
+               + 10.0 * std::log10(std::max(pulseWidthS, 1e-15)) + 10.0 * std::log10(std::max(pulses, 1.0))
+               - 30.0 * std::log10(4.0 * kPi) - 10.0 * std::log10(kBoltzmann * std::max(temperatureK, 1.0))
+               - noiseFigureDb - lossDb;
+    }
+
+    // Vektörleşen log2 (|hata| < 2e-5): üs bitlerden, mantis m ∈ [1, 2) için
+    // ln m = 2 atanh((m-1)/(m+1)) serisi
+    inline float fastLog2(float x)
+    {
+        std::uint32_t bits;
+        std::memcpy(&bits, &x, sizeof bits);
+        const float e = static_cast<float>(static_cast<int>(bits >> 23) - 127);
+        bits = (bits & 0x007fffffu) | 0x3f800000u;
+        float m;
+        std::memcpy(&m, &bits, sizeof m);
+        const float y = (m - 1.0f) / (m + 1.0f), y2 = y * y;
+        const float ln = 2.0f * y * (1.0f + y2 * (1.0f / 3.0f + y2 * (1.0f / 5.0f + y2 * (1.0f / 7.0f + y2 * (1.0f / 9.0f)))));
+        return e + ln * 1.44269504f;
+    }
+
+    // Düşey silindir hava hücresi. γ radar frekansına bağlıdır (dbPerKm).
+    struct Cell {
+        double cx, cy, cz;          // taban merkezi (ECEF)
+        double ux, uy, uz;          // yerel düşey birim vektör
+        double radius;              // m
+        double height;              // taban üstü tepe (m)
+        bool fog;
+        double rainRate;            // mm/h
+        double visibility;          // m
+        double temperatureK;
+    };
+
+    // Yağmur tepesi donma seviyesi (6.5 K/km), sis tabakası sabit
+    inline Cell makeCell(double lat, double lon, double radiusM, bool fog, double rainRate,
+                         double visibility, double temperatureK)
+    {
+        Cell c{};
+        Geo::geodeticToECEF(lat, lon, 0.0, c.cx, c.cy, c.cz);
+        const double la = lat * Geo::deg2rad, lo = lon * Geo::deg2rad;
+        c.ux = std::cos(la) * std::cos(lo);
+        c.uy = std::cos(la) * std::sin(lo);
+        c.uz = std::sin(la);
+        c.radius = std::max(radiusM, 0.0);
+        c.height = fog ? 500.0 : std::max(1000.0, (temperatureK - 273.15) / 0.0065);
+        c.fog = fog;
+        c.rainRate = std::max(rainRate, 0.0);
+        c.visibility = std::max(visibility, 1.0);
+        c.temperatureK = temperatureK;
+        return c;
+    }
+
+    // Tek yönlü özgül zayıflama (dB/km). Yağmur: γ = k R^α (Olsen, ITU-R P.838
+    // yaklaşımı). Sis: ITU-R P.840 Rayleigh modeli, sıvı su yoğunluğu görüş
+    // mesafesinden M = (0.024 / V_km)^1.54 g/m³.
+    inline double dbPerKm(const Cell &c, double frequencyGHz)
+    {
+        const double f = std::max(frequencyGHz, 0.1);
+        if (!c.fog) {
+            if (c.rainRate <= 0.0) return 0.0;
+            const double k = 4.21e-5 * std::pow(f, 2.42);
+            const double alpha = f < 8.5 ? 0.851 * std::pow(f, 0.158) : 1.41 * std::pow(f, -0.0779);
+            return k * std::pow(c.rainRate, alpha);
+        }
+        const double M = std::pow(0.024 / (c.visibility * 1e-3), 1.54);
+        const double th = 300.0 / std::max(c.temperatureK, 200.0) - 1.0;
+        const double e0 = 77.66 + 103.3 * th, e1 = 0.0671 * e0, e2 = 3.52;
+        const double fp = 20.20 - 146.0 * th + 316.0 * th * th, fs = 39.8 * fp;
+        const double ap = 1.0 + (f / fp) * (f / fp), as = 1.0 + (f / fs) * (f / fs);
+        const double eIm = f * (e0 - e1) / (fp * ap) + f * (e1 - e2) / (fs * as);
+        const double eRe = (e0 - e1) / ap + (e1 - e2) / as + e2;
+        const double eta = (2.0 + eRe) / eIm;
+        return 0.819 * f / (eIm * (1.0 + eta * eta)) * M;
+    }
+
+    // snr[t] = C + rcsDb[t] - 40 log10 R (R en az 1 m)
+    inline void rangeRow(double rx, double ry, double rz, float constant,
+                         const double *tx, const double *ty, const double *tz,
+                         const float *rcsDb, std::size_t n, float *snr)
+    {
+        // -40 log10 R = -20 log10(2) log2(R²)
+        constexpr float k = 6.0205999f;
+        for (std::size_t i = 0; i < n; ++i) {
+            const double dx = tx[i] - rx, dy = ty[i] - ry, dz = tz[i] - rz;
+            const float r2 = std::max(static_cast<float>(dx * dx + dy * dy + dz * dz), 1.0f);
+            snr[i] = constant + rcsDb[i] - k * fastLog2(r2);
+        }
+    }
+
+    // İki yönlü yayılım: snr[t] += 2 F[t]; NaN (veri yok) serbest uzay sayılır
+    inline void propagationRow(const float *propDb, std::size_t n, float *snr)
+    {
+        for (std::size_t i = 0; i < n; ++i) {
+            const float f = propDb[i];
+            snr[i] += (f == f) ? 2.0f * f : 0.0f;
+        }
+    }
+
+    // İki yönlü hava kaybı: snr[t] -= 2 γ L. L, radardan hedefe doğru parçasının
+    // silindir (yarıçap ve [0, height] düşey aralığı) içindeki uzunluğu. Fark
+    // vektörleri double alınır, kesişim float'ta (m altı hassasiyet yeter).
+    inline void cellRow(const Cell &c, double dbPerMeter, double rx, double ry, double rz,
+                        const double *tx, const double *ty, const double *tz, std::size_t n, float *snr)
+    {
+        const double fxd = rx - c.cx, fyd = ry - c.cy, fzd = rz - c.cz;
+        const double fad = fxd * c.ux + fyd * c.uy + fzd * c.uz;
+        const float ux = float(c.ux), uy = float(c.uy), uz = float(c.uz);
+        const float fa = float(fad);
+        const float px = float(fxd - fad * c.ux), py = float(fyd - fad * c.uy), pz = float(fzd - fad * c.uz);
+        const float cc = float(double(px) * px + double(py) * py + double(pz) * pz - c.radius * c.radius);
+        const float top = float(c.height);
+        const float loss2 = float(2.0 * dbPerMeter);
+        for (std::size_t i = 0; i < n; ++i) {
+            const float dx = float(tx[i] - rx), dy = float(ty[i] - ry), dz = float(tz[i] - rz);
+            const float da = dx * ux + dy * uy + dz * uz;
+            const float qx = dx - da * ux, qy = dy - da * uy, qz = dz - da * uz;
+            // Yatay: |p + t q|² = ρ²; düşey yol (A ~ 0) içerideyse tüm aralık
+            const float A = std::max(qx * qx + qy * qy + qz * qz, 1e-6f);
+            const float B = px * qx + py * qy + pz * qz;
+            const float disc = B * B - A * cc;
+            const float root = std::sqrt(std::max(disc, 0.0f));
+            const float invA = 1.0f / A;
+            float lo = (-B - root) * invA, hi = (-B + root) * invA;
+            // Düşey: 0 <= fa + t da <= height
+            const float invDa = 1.0f / (std::fabs(da) < 1e-3f ? 1e-3f : da);
+            const float a0 = -fa * invDa, a1 = (top - fa) * invDa;
+            lo = std::max(std::max(lo, std::min(a0, a1)), 0.0f);
+            hi = std::min(std::min(hi, std::max(a0, a1)), 1.0f);
+            const float len = disc >= 0.0f ? std::max(hi - lo, 0.0f) * std::sqrt(dx * dx + dy * dy + dz * dz) : 0.0f;
+            snr[i] -= loss2 * len;
+        }
+    }
+
+} // namespace RadarEq
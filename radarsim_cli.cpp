@@ -0,0 +1,165 @@
+// radarsim_cli: senaryo JSON'unu (MainWindow::saveFile formatı) GUI olmadan,
+// duvar saatine bağlı kalmadan CPU'nun izin verdiği hızda koşturur ve
+// yörüngeleri CSV'ye yazar. Yalnızca QtCore'a bağlıdır; X/GPU gerekmez.
+//
+//   radarsim_cli scenario.json -o traj.csv --duration 600 [--hz 100] [--every 10] [--los] [--events det.csv]
+//
+// Çıktı: time,kind,name,lat,lon,alt   (kind: radar | profile | target)
+// --los ile her adımda görüş hattı hesaplanır ve visible sütunu eklenir
+// (target: en az bir radardan görünürse 1; radar/profile satırlarında boş).
+// --events ile radar denklemi tespit olayları ayrı CSV'ye yazılır:
+// time,radar,target,event,snr_db   (event: detected | lost)
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QElapsedTimer>
+#include <cstdio>
+#include <cmath>
+#include <algorithm>
+#include "scenario.h"
+#include "simengine.h"
+
+namespace {
+
+void writeSnapshot(std::FILE *out, const SimSnapshot &snap, const QByteArray &radarName, bool los)
+{
+    const char *empty = los ? "," : "";
+    if (snap.radarValid) {
+        std::fprintf(out, "%.6f,radar,%s,%.9f,%.9f,%.3f%s\n", snap.simTime, radarName.constData(),
+                     snap.radar.lat, snap.radar.lon, snap.radar.alt, empty);
+    }
+    for (const auto &r : snap.radars) {
+        std::fprintf(out, "%.6f,profile,%s,%.9f,%.9f,%.3f%s\n", snap.simTime, r.name.toUtf8().constData(),
+                     r.lat, r.lon, r.alt, empty);
+    }
+    for (const auto &t : snap.targets) {
+        std::fprintf(out, "%.6f,target,%s,%.9f,%.9f,%.3f%s\n", snap.simTime, t.name.toUtf8().constData(),
+                     t.lat, t.lon, t.alt, los ? (t.visible ? ",1" : ",0") : "");
+    }
+}
+
+// Tekil radar adı boş gelir (SimDetectionEvent::radarName)
+void writeEvents(std::FILE *out, const QVector<SimDetectionEvent> &events, const QByteArray &radarName)
+{
+    for (const auto &e : events) {
+        std::fprintf(out, "%.6f,%s,%s,%s,%.2f\n", e.simTime,
+                     e.radarName.isEmpty() ? radarName.constData() : e.radarName.toUtf8().constData(),
+                     e.targetName.toUtf8().constData(), e.detected ? "detected" : "lost", double(e.snrDb));
+    }
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("radarsim_cli");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Headless radar scenario runner");
+    parser.addHelpOption();
+    parser.addPositionalArgument("scenario", "Scenario JSON written by File > Save");
+    QCommandLineOption outOpt({"o", "output"}, "Trajectory CSV file (default: stdout)", "file");
+    QCommandLineOption durOpt({"d", "duration"}, "Simulated duration in seconds (default: 60)", "seconds", "60");
+    QCommandLineOption hzOpt("hz", "Override physics rate from the scenario", "hz");
+    QCommandLineOption everyOpt("every", "Write one sample every N physics ticks (default: 1)", "ticks", "1");
+    QCommandLineOption quietOpt({"q", "quiet"}, "Do not print the run summary");
+    QCommandLineOption losOpt("los", "Compute radar-target line of sight every tick (adds a visible column)");
+    QCommandLineOption eventsOpt("events", "Detection event CSV (radar equation, every tick)", "file");
+    parser.addOptions({outOpt, durOpt, hzOpt, everyOpt, quietOpt, losOpt, eventsOpt});
+    parser.process(app);
+
+    const QStringList args = parser.positionalArguments();
+    if (args.size() != 1) {
+        std::fprintf(stderr, "usage: radarsim_cli <scenario.json> [-o traj.csv] [-d seconds] [--hz N] [--every N] [--los] [--events det.csv]\n");
+        return 2;
+    }
+
+    Scenario scenario;
+    QString error;
+    if (!loadScenarioFile(args.first(), scenario, &error)) {
+        std::fprintf(stderr, "%s\n", qPrintable(error));
+        return 1;
+    }
+    if (parser.isSet(hzOpt)) scenario.hz = parser.value(hzOpt).toInt();
+    if (scenario.hz < 1) {
+        std::fprintf(stderr, "invalid physics rate: %d\n", scenario.hz);
+        return 2;
+    }
+    const double duration = parser.value(durOpt).toDouble();
+    const int every = std::max(1, parser.value(everyOpt).toInt());
+
+    std::FILE *out = stdout;
+    if (parser.isSet(outOpt)) {
+        out = std::fopen(qPrintable(parser.value(outOpt)), "w");
+        if (!out) {
+            std::fprintf(stderr, "cannot open %s for writing\n", qPrintable(parser.value(outOpt)));
+            return 1;
+        }
+    }
+    static char outBuffer[1 << 20];
+    std::setvbuf(out, outBuffer, _IOFBF, sizeof(outBuffer));
+
+    // Motor thread'e taşınmaz: step() doğrudan bu thread'de, beklemesiz çağrılır
+    SimEngine engine;
+    applyScenario(scenario, engine);
+    const bool los = parser.isSet(losOpt);
+    engine.setLineOfSightEnabled(los);
+
+    std::FILE *events = nullptr;
+    if (parser.isSet(eventsOpt)) {
+        events = std::fopen(qPrintable(parser.value(eventsOpt)), "w");
+        if (!events) {
+            std::fprintf(stderr, "cannot open %s for writing\n", qPrintable(parser.value(eventsOpt)));
+            return 1;
+        }
+        std::fprintf(events, "time,radar,target,event,snr_db\n");
+    }
+    long long eventCount = 0, droppedCount = 0;
+
+    const QByteArray radarName = scenario.radarName.toUtf8();
+    const quint64 ticks = static_cast<quint64>(std::llround(duration * scenario.hz));
+
+    QElapsedTimer wall;
+    wall.start();
+    std::fprintf(out, los ? "time,kind,name,lat,lon,alt,visible\n" : "time,kind,name,lat,lon,alt\n");
+    writeSnapshot(out, engine.snapshot(), radarName, los);
+    for (quint64 n = 1; n <= ticks; ++n) {
+        engine.step();
+        // Olaylar snapshot'tan önce alınır (snapshot da bekleyenleri boşaltır)
+        if (events) {
+            int dropped = 0;
+            const QVector<SimDetectionEvent> ev = engine.takeDetectionEvents(&dropped);
+            writeEvents(events, ev, radarName);
+            eventCount += ev.size();
+            droppedCount += dropped;
+        }
+        if (n % static_cast<quint64>(every) == 0 || n == ticks) writeSnapshot(out, engine.snapshot(), radarName, los);
+    }
+    if (events) std::fclose(events);
+    const double wallSeconds = wall.nsecsElapsed() * 1e-9;
+
+    if (out != stdout) std::fclose(out);
+    else std::fflush(out);
+
+    if (!parser.isSet(quietOpt)) {
+        std::fprintf(stderr, "radarsim_cli: %llu ticks @ %d Hz, %d target(s), %.1f s simulated in %.3f s wall (x%.0f)\n",
+                     static_cast<unsigned long long>(ticks), scenario.hz, int(scenario.targets.size()),
+                     engine.simulationTime(), wallSeconds, wallSeconds > 0.0 ? engine.simulationTime() / wallSeconds : 0.0);
+        if (los) {
+            const LosEngine::Stats st = engine.lineOfSightStats();
+            std::fprintf(stderr, "radarsim_cli: last LOS tick %zu pair(s), %zu recomputed in %.2f ms\n",
+                         st.pairs, st.recomputed, st.milliseconds);
+            const PropagationField::Stats pe = engine.propagationStats();
+            if (pe.solved > 0 || pe.stale > 0)
+                std::fprintf(stderr, "radarsim_cli: last PE tick %d radial(s) solved (%d reused terrain), %d stale "
+                             "(oldest in use %.1f s) in %.2f ms\n",
+                             pe.solved, pe.profilesReused, pe.stale, pe.oldestAge, pe.milliseconds);
+        }
+        const DetectionEngine::Stats det = engine.detectionStats();
+        std::fprintf(stderr, "radarsim_cli: last detection tick %zu pair(s), %zu detected in %.3f ms",
+                     det.pairs, det.detected, det.milliseconds);
+        if (events) std::fprintf(stderr, "; %lld event(s) written, %lld dropped", eventCount, droppedCount);
+        std::fprintf(stderr, "\n");
+    }
+    return 0;
+}
@@ -0,0 +1,182 @@
+#include "rangedoppler.h"
+#include "fft.h"
+#include "workstealingpool.h"
+#include <algorithm>
+#include <chrono>
+
+#if defined(_MSC_VER)
+#define RD_RESTRICT __restrict
+#else
+#define RD_RESTRICT __restrict__
+#endif
+
+namespace {
+
+std::size_t nextPow2(std::size_t v)
+{
+    std::size_t p = 1;
+    while (p < v) p <<= 1;
+    return p;
+}
+
+} // namespace
+
+RangeDopplerProcessor::RangeDopplerProcessor(const Settings &settings, WorkStealingPool *workerPool, Sink output)
+    : cfg(settings)
+    , pool(workerPool)
+    , sink(std::move(output))
+{
+    if (cfg.prfHz.empty()) cfg.prfHz.push_back(750.0);
+    cfg.rangeBins = std::max<std::size_t>(cfg.rangeBins, 1);
+    cfg.pulsesPerCpi = std::max(cfg.pulsesPerCpi, 2);
+    cfg.rangeBlock = std::max<std::size_t>(cfg.rangeBlock, 1);
+    if (cfg.rangeGain && cfg.rangeGain->size() < cfg.rangeBins) cfg.rangeGain.reset();
+    fftSize = nextPow2(std::size_t(cfg.pulsesPerCpi));
+    plan = FftPlan::get(fftSize);
+    slowWindow = Wf::window(cfg.window, std::size_t(cfg.pulsesPerCpi));
+
+    const std::size_t cpiSamples = std::size_t(cfg.pulsesPerCpi) * cfg.rangeBins;
+    channels.resize(cfg.prfHz.size());
+    for (Channel &c : channels) {
+        for (Buffer &b : c.buffers) {
+            b.re.assign(cpiSamples, 0.0f);
+            b.im.assign(cpiSamples, 0.0f);
+        }
+        c.power.assign(fftSize * cfg.rangeBins, 0.0f);
+    }
+    tiles.resize(pool ? std::size_t(pool->workerCount()) : 1);
+    for (Tile &t : tiles) {
+        t.re.assign(cfg.rangeBlock * fftSize, 0.0f);
+        t.im.assign(cfg.rangeBlock * fftSize, 0.0f);
+    }
+    worker = std::thread([this] { processLoop(); });
+}
+
+RangeDopplerProcessor::~RangeDopplerProcessor()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    worker.join();
+}
+
+void RangeDopplerProcessor::pushPulse(int prf, const float *re, const float *im)
+{
+    if (prf < 0 || std::size_t(prf) >= channels.size()) return;
+    Channel &c = channels[std::size_t(prf)];
+    Buffer &b = c.buffers[c.active];
+    const std::size_t off = std::size_t(c.filled) * cfg.rangeBins;
+    std::copy_n(re, cfg.rangeBins, b.re.begin() + std::ptrdiff_t(off));
+    std::copy_n(im, cfg.rangeBins, b.im.begin() + std::ptrdiff_t(off));
+
+    std::unique_lock<std::mutex> lock(mutex);
+    ++counters.pulses;
+    if (++c.filled < cfg.pulsesPerCpi) return;
+
+    // CPI doldu: işleme kuyruğuna ver, diğer tampona geç (işleniyorsa bekle)
+    b.busy = true;
+    jobs.emplace_back(prf, c.active);
+    ++inFlight;
+    wake.notify_one();
+    c.active ^= 1;
+    c.filled = 0;
+    if (c.buffers[c.active].busy) {
+        const auto t0 = std::chrono::steady_clock::now();
+        done.wait(lock, [&] { return !c.buffers[c.active].busy; });
+        counters.waitMs += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+    }
+}
+
+void RangeDopplerProcessor::discardPartial(int prf)
+{
+    if (prf < 0 || std::size_t(prf) >= channels.size()) return;
+    channels[std::size_t(prf)].filled = 0;
+}
+
+void RangeDopplerProcessor::flush()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    done.wait(lock, [&] { return inFlight == 0; });
+}
+
+RangeDopplerProcessor::Stats RangeDopplerProcessor::stats() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return counters;
+}
+
+void RangeDopplerProcessor::processLoop()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    for (;;) {
+        wake.wait(lock, [&] { return stopping || !jobs.empty(); });
+        if (jobs.empty()) return;   // stopping, kuyruk boş
+        const std::pair<int, int> job = jobs.front();
+        jobs.pop_front();
+        lock.unlock();
+
+        const auto t0 = std::chrono::steady_clock::now();
+        process(job.first, job.second);
+        const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+
+        lock.lock();
+        channels[std::size_t(job.first)].buffers[job.second].busy = false;
+        --inFlight;
+        ++counters.cpis;
+        counters.processingMs += ms;
+        done.notify_all();
+    }
+}
+
+void RangeDopplerProcessor::process(int prf, int buffer)
+{
+    Channel &c = channels[std::size_t(prf)];
+    const Buffer &in = c.buffers[buffer];
+    const std::size_t R = cfg.rangeBins, P = std::size_t(cfg.pulsesPerCpi), F = fftSize, half = F / 2;
+    const float *RD_RESTRICT w = slowWindow->data();
+    float *RD_RESTRICT out = c.power.data();
+    const float *RD_RESTRICT gain = cfg.rangeGain ? cfg.rangeGain->data() : nullptr;
+
+    auto run = [&](std::size_t begin, std::size_t end, int workerIndex) {
+        Tile &t = tiles[std::size_t(workerIndex)];
+        float *RD_RESTRICT tr = t.re.data();
+        float *RD_RESTRICT ti = t.im.data();
+        for (std::size_t block = begin; block < end; ++block) {
+            const std::size_t r0 = block * cfg.rangeBlock, nr = std::min(cfg.rangeBlock, R - r0);
+            // Köşe dönüşü: darbe satırlarından (bitişik) karo sütunlarına, pencereyle
+            for (std::size_t p = 0; p < P; ++p) {
+                const float *RD_RESTRICT sr = in.re.data() + p * R + r0;
+                const float *RD_RESTRICT si = in.im.data() + p * R + r0;
+                const float wp = w[p];
+                for (std::size_t r = 0; r < nr; ++r) {
+                    tr[r * F + p] = sr[r] * wp;
+                    ti[r * F + p] = si[r] * wp;
+                }
+            }
+            // Satır FFT'si ve güç karoda (bitişik); STC kazancı satır başına
+            // sabit olduğundan aynı döngüde çarpılır, ayrı geçiş yok
+            for (std::size_t r = 0; r < nr; ++r) {
+                float *RD_RESTRICT rr = tr + r * F;
+                float *RD_RESTRICT ri = ti + r * F;
+                std::fill(rr + P, rr + F, 0.0f);
+                std::fill(ri + P, ri + F, 0.0f);
+                plan->forward(rr, ri);
+                const float g = gain ? gain[r0 + r] : 1.0f;
+                for (std::size_t d = 0; d < F; ++d) rr[d] = (rr[d] * rr[d] + ri[d] * ri[d]) * g;
+            }
+            // Geri dönüş: Doppler satırlarına, sıfır Doppler ortada
+            for (std::size_t d = 0; d < F; ++d) {
+                float *RD_RESTRICT dst = out + ((d + half) & (F - 1)) * R + r0;
+                for (std::size_t r = 0; r < nr; ++r) dst[r] = tr[r * F + d];
+            }
+        }
+    };
+    const std::size_t blocks = (R + cfg.rangeBlock - 1) / cfg.rangeBlock;
+    if (pool && blocks > 1) pool->parallelFor(blocks, 1, run);
+    else run(0, blocks, 0);
+
+    if (sink) sink(Map{prf, cfg.prfHz[std::size_t(prf)], c.cpis, F, R, out});
+    ++c.cpis;
+}
@@ -0,0 +1,123 @@
+#ifndef RANGEDOPPLER_H
+#define RANGEDOPPLER_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "alignedbuffer.h"
+#include "waveform.h"
+
+class FftPlan;
+class WorkStealingPool;
+
+// Menzil-Doppler işleme: (sıkıştırılmış) darbeler PRF başına CPI'lerde toplanır,
+// her menzil hücresinin yavaş zaman dizisi pencerelenip FFT'lenir ve güç
+// haritası [doppler * rangeBins + r] olarak üretilir (sıfır Doppler ortada,
+// satır d ↔ (d - F/2) · PRF / F Hz).
+//
+// Köşe dönüşü (darbe-ana → menzil-ana) menzil blokları halinde yapılır: bir
+// blok (rangeBlock x F) L1'e sığan bir karoya aktarılır, karoda FFT'lenir ve
+// güç olarak haritaya geri aktarılır; tam matris hiç transpoze edilmez. Bloklar
+// iş çalan havuzda paralel işlenir.
+//
+// Girdi çift tamponludur: her PRF'nin iki CPI tamponu vardır; biri dolarken
+// diğeri arka plandaki işleme thread'inde işlenir. pushPulse() yalnızca aynı
+// PRF'nin önceki CPI'si hâlâ işleniyorsa bekler. Tüm tamponlar kurulumda
+// ayrılır, darbe yolunda bellek ayırma yoktur.
+class RangeDopplerProcessor
+{
+public:
+    struct Settings {
+        std::vector<double> prfHz{750.0};  // CPI kanalı başına bir PRF
+        std::size_t rangeBins{4096};        // darbe başına örnek
+        int pulsesPerCpi{64};               // Doppler FFT'si ikinin kuvvetine sıfırla tamamlanır
+        Wf::Window window{Wf::Window::Hamming};  // yavaş zaman penceresi
+        std::size_t rangeBlock{32};         // köşe dönüşü karo yüksekliği
+        // Menzil hücresi başına güç kazancı (STC, Stc::table); güç yazılırken
+        // çarpılır, nullptr ya da rangeBins'ten kısaysa uygulanmaz
+        std::shared_ptr<const AlignedVector<float>> rangeGain;
+    };
+
+    struct Map {
+        int prf;                            // Settings::prfHz indeksi
+        double prfHz;
+        std::uint64_t cpi;                  // o PRF'nin CPI sayacı
+        std::size_t dopplerBins;
+        std::size_t rangeBins;
+        const float *power;                 // geçerliliği sink çağrısı süresince
+    };
+
+    struct Stats {
+        std::uint64_t pulses{0};
+        std::uint64_t cpis{0};
+        double processingMs{0.0};           // işleme thread'inde toplam
+        double waitMs{0.0};                 // pushPulse'ın tampon beklediği toplam
+    };
+
+    using Sink = std::function<void(const Map &)>;
+
+    // sink işleme thread'inden çağrılır. pool nullptr ise bloklar o thread'de sırayla.
+    RangeDopplerProcessor(const Settings &settings, WorkStealingPool *pool, Sink sink);
+    ~RangeDopplerProcessor();
+
+    RangeDopplerProcessor(const RangeDopplerProcessor &) = delete;
+    RangeDopplerProcessor &operator=(const RangeDopplerProcessor &) = delete;
+
+    const Settings &settings() const { return cfg; }
+    std::size_t dopplerBins() const { return fftSize; }
+
+    // prf kanalına bir darbe (rangeBins örnek) ekler. Tek üretici thread'den çağrılır.
+    void pushPulse(int prf, const float *re, const float *im);
+    // Kanalın yarım CPI'sini atar (ör. PRF değişiminde)
+    void discardPartial(int prf);
+    // Kuyruktaki tüm CPI'ler işlenene kadar bekler
+    void flush();
+
+    Stats stats() const;
+
+private:
+    struct Buffer {
+        AlignedVector<float> re, im;        // [pulse * rangeBins + r]
+        bool busy{false};
+    };
+    struct Channel {
+        Buffer buffers[2];
+        int active{0};
+        int filled{0};
+        std::uint64_t cpis{0};
+        AlignedVector<float> power;         // [doppler * rangeBins + r]
+    };
+    struct Tile {
+        AlignedVector<float> re, im;        // [r * F + pulse]
+    };
+
+    void processLoop();
+    void process(int prf, int buffer);
+
+    Settings cfg;
+    std::size_t fftSize{0};
+    std::shared_ptr<const FftPlan> plan;
+    std::shared_ptr<const AlignedVector<float>> slowWindow;
+    WorkStealingPool *pool{nullptr};
+    Sink sink;
+    std::vector<Channel> channels;
+    std::vector<Tile> tiles;                // worker başına
+
+    mutable std::mutex mutex;
+    std::condition_variable wake;           // işleme thread'i
+    std::condition_variable done;           // üretici / flush
+    std::deque<std::pair<int, int>> jobs;   // (prf, buffer)
+    int inFlight{0};
+    bool stopping{false};
+    Stats counters;
+    std::thread worker;
+};
+
+#endif // RANGEDOPPLER_H
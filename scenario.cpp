@@ -0,0 +1,192 @@
+#include "scenario.h"
+#include "simengine.h"
+#include <QFile>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonArray>
+#include <QJsonParseError>
+#include <QDebug>
+#include <algorithm>
+
+namespace {
+
+RadarRouteWaypoint readWaypoint(const QJsonObject &o)
+{
+    RadarRouteWaypoint w;
+    w.lat = o.value("lat").toDouble();
+    w.lon = o.value("lon").toDouble();
+    w.alt = o.value("alt").toDouble();
+    w.velN = o.value("velN").toDouble();
+    w.velE = o.value("velE").toDouble();
+    w.velD = o.value("velD").toDouble();
+    return w;
+}
+
+QVector<RadarRouteWaypoint> readRoute(const QJsonArray &arr)
+{
+    QVector<RadarRouteWaypoint> route;
+    route.reserve(arr.size());
+    for (const auto &v : arr) route.push_back(readWaypoint(v.toObject()));
+    return route;
+}
+
+} // namespace
+
+QJsonObject radarParametersToJson(const RadarParameters &p)
+{
+    QJsonObject o;
+    o["txPeakW"] = p.txPeakW;
+    o["frequencyGHz"] = p.frequencyGHz;
+    o["pulseWidthUs"] = p.pulseWidthUs;
+    o["gainDbi"] = p.gainDbi;
+    o["noiseFigureDb"] = p.noiseFigureDb;
+    o["temperatureK"] = p.temperatureK;
+    o["systemLossDb"] = p.systemLossDb;
+    o["dwellSec"] = p.dwellSec;
+    o["prfHz"] = p.prfHz;
+    o["snrThresholdDb"] = p.snrThresholdDb;
+    return o;
+}
+
+RadarParameters radarParametersFromJson(const QJsonObject &o)
+{
+    RadarParameters p;
+    p.txPeakW = o.value("txPeakW").toDouble(p.txPeakW);
+    p.frequencyGHz = o.value("frequencyGHz").toDouble(p.frequencyGHz);
+    p.pulseWidthUs = o.value("pulseWidthUs").toDouble(p.pulseWidthUs);
+    p.gainDbi = o.value("gainDbi").toDouble(p.gainDbi);
+    p.noiseFigureDb = o.value("noiseFigureDb").toDouble(p.noiseFigureDb);
+    p.temperatureK = o.value("temperatureK").toDouble(p.temperatureK);
+    p.systemLossDb = o.value("systemLossDb").toDouble(p.systemLossDb);
+    p.dwellSec = o.value("dwellSec").toDouble(p.dwellSec);
+    p.prfHz = o.value("prfHz").toDouble(p.prfHz);
+    p.snrThresholdDb = o.value("snrThresholdDb").toDouble(p.snrThresholdDb);
+    return p;
+}
+
+bool loadScenarioFile(const QString &path, Scenario &out, QString *errorString)
+{
+    QFile f(path);
+    if (!f.open(QIODevice::ReadOnly)) {
+        if (errorString) *errorString = QString("Cannot open %1: %2").arg(path, f.errorString());
+        return false;
+    }
+    QJsonParseError perr;
+    const QJsonDocument doc = QJsonDocument::fromJson(f.readAll(), &perr);
+    if (perr.error != QJsonParseError::NoError || !doc.isObject()) {
+        if (errorString) *errorString = QString("Invalid scenario JSON %1: %2").arg(path, perr.errorString());
+        return false;
+    }
+    const QJsonObject root = doc.object();
+
+    Scenario s;
+    s.hz = root.value("hz").toInt(10);
+
+    const QJsonObject radarInit = root.value("radarInitial").toObject();
+    s.radarName = radarInit.value("name").toString("Radar");
+    s.radarInitial = readWaypoint(radarInit);
+    s.radarRoute = readRoute(root.value("radarRoute").toArray());
+    s.radarParameters = radarParametersFromJson(radarInit.value("parameters").toObject());
+
+    for (const auto &v : root.value("targets").toArray()) {
+        const QJsonObject to = v.toObject();
+        const QJsonObject init = to.value("initial").toObject();
+        const QJsonObject traj = to.value("trajectory").toObject();
+        Target t;
+        t.name = to.value("name").toString();
+        t.initLatitude = init.value("lat").toDouble();
+        t.initLongitude = init.value("lon").toDouble();
+        t.initAltitude = init.value("alt").toDouble();
+        t.initRCS = init.value("rcs").toDouble();
+        t.initVelocityN = init.value("velN").toDouble();
+        t.initVelocityE = init.value("velE").toDouble();
+        t.initVelocityD = init.value("velD").toDouble();
+        t.trajLatitude = traj.value("lat").toDouble();
+        t.trajLongitude = traj.value("lon").toDouble();
+        t.trajAltitude = traj.value("alt").toDouble();
+        t.trajVelocityN = traj.value("velN").toDouble();
+        t.trajVelocityE = traj.value("velE").toDouble();
+        t.trajVelocityD = traj.value("velD").toDouble();
+        const QJsonArray wps = to.value("waypoints").toArray();
+        if (!wps.isEmpty()) s.targetRoutes.insert(t.name, readRoute(wps));
+        s.targets.append(t);
+    }
+
+    for (const auto &v : root.value("radars").toArray()) {
+        const QJsonObject ro = v.toObject();
+        ScenarioRadarProfile rp;
+        rp.name = ro.value("name").toString();
+        rp.lat = ro.value("lat").toDouble();
+        rp.lon = ro.value("lon").toDouble();
+        rp.alt = ro.value("alt").toDouble();
+        rp.velN = ro.value("velN").toDouble();
+        rp.velE = ro.value("velE").toDouble();
+        rp.velD = ro.value("velD").toDouble();
+        rp.route = readRoute(ro.value("route").toArray());
+        rp.parameters = radarParametersFromJson(ro.value("parameters").toObject());
+        s.radars.append(rp);
+    }
+
+    for (const auto &v : root.value("terrain").toArray()) s.terrain.append(v.toString());
+
+    // MainWindow::saveFile'daki WeatherCondition alanları
+    if (root.value("calculateWeather").toBool(false)) {
+        for (const auto &v : root.value("weather").toArray()) {
+            const QJsonObject wo = v.toObject();
+            WeatherCell c;
+            c.type = wo.value("type").toString() == "Rain" ? WeatherType::Rain : WeatherType::Fog;
+            c.lat = wo.value("lat").toDouble();
+            c.lon = wo.value("lon").toDouble();
+            c.radiusKm = wo.value("radiusKm").toDouble(c.radiusKm);
+            c.rainRate = wo.value("rainRate").toDouble(c.rainRate);
+            c.fogVisibility = wo.value("fogVisibility").toDouble(c.fogVisibility);
+            c.temperatureK = wo.value(c.type == WeatherType::Rain ? "rainTemp" : "fogTemp").toDouble(c.temperatureK);
+            s.weather.append(c);
+        }
+    }
+
+    const QJsonObject po = root.value("propagation").toObject();
+    const PropagationSettings defaults;
+    s.propagation.mode = static_cast<PropagationMode>(std::clamp(po.value("mode").toInt(0), 0,
+                                                                 int(PropagationMode::SkipPpfAndTerrain)));
+    s.propagation.maxAltitude = po.value("maxAltitude").toDouble(defaults.maxAltitude);
+    s.propagation.maxDistanceKm = po.value("maxDistanceKm").toDouble(defaults.maxDistanceKm);
+    s.propagation.altitudeStep = po.value("altitudeStep").toDouble(defaults.altitudeStep);
+    s.propagation.distanceStep = po.value("distanceStep").toDouble(defaults.distanceStep);
+    s.propagation.ground = po.value("ground").toInt(0) == 1 ? GroundProfile::Impedance : GroundProfile::Pec;
+    s.propagation.conductivity = po.value("conductivity").toDouble(defaults.conductivity);
+    s.propagation.permittivity = po.value("permittivity").toDouble(defaults.permittivity);
+    s.propagation.flatTerrain = po.value("flatTerrain").toBool(defaults.flatTerrain);
+    s.propagation.halfBeamWidthDeg = po.value("halfBeamWidthDeg").toDouble(defaults.halfBeamWidthDeg);
+    s.propagation.frequencyGHz = po.value("frequencyGHz").toDouble(defaults.frequencyGHz);
+    s.propagation.verticalPolarization = po.value("verticalPolarization").toBool(defaults.verticalPolarization);
+
+    out = s;
+    return true;
+}
+
+void applyScenario(const Scenario &scenario, SimEngine &engine)
+{
+    const RadarRouteWaypoint &r = scenario.radarInitial;
+    engine.setPhysicsHz(scenario.hz);
+    engine.setRadarInitialKinematics(r.lat, r.lon, r.alt, r.velN, r.velE, r.velD);
+    engine.setRadarRoute(scenario.radarRoute);
+    engine.setPropagationSettings(scenario.propagation);
+    engine.setRadarParameters(scenario.radarParameters);
+    engine.setWeatherCells(scenario.weather);
+
+    for (const auto &rp : scenario.radars) {
+        engine.addRadarProfile(rp.name, rp.lat, rp.lon, rp.alt, rp.velN, rp.velE, rp.velD, rp.route, rp.parameters);
+    }
+
+    engine.clearTargets();
+    for (const auto &t : scenario.targets) engine.addTarget(t);
+    for (auto it = scenario.targetRoutes.constBegin(); it != scenario.targetRoutes.constEnd(); ++it) {
+        engine.setTargetRoute(it.key(), it.value());
+    }
+
+    for (const QString &path : scenario.terrain) {
+        QString error;
+        if (!engine.addTerrainFile(path, &error)) qWarning() << error;
+    }
+}
@@ -0,0 +1,52 @@
+#ifndef SCENARIO_H
+#define SCENARIO_H
+
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <QList>
+#include <QMap>
+#include "simtypes.h"
+
+class SimEngine;
+class QJsonObject;
+
+// MainWindow::saveFile'ın yazdığı senaryo JSON'unun kinematik kısmı.
+// Yalnızca QtCore kullanır (radarsim_cli ve GUI ortak).
+struct ScenarioRadarProfile {
+    QString name;
+    double lat{0.0};
+    double lon{0.0};
+    double alt{0.0};
+    double velN{0.0};
+    double velE{0.0};
+    double velD{0.0};
+    QVector<RadarRouteWaypoint> route;
+    RadarParameters parameters;
+};
+
+struct Scenario {
+    int hz{10};
+    QString radarName{"Radar"};
+    RadarRouteWaypoint radarInitial;            // konum + hız
+    QVector<RadarRouteWaypoint> radarRoute;
+    QList<Target> targets;
+    QMap<QString, QVector<RadarRouteWaypoint>> targetRoutes;
+    QList<ScenarioRadarProfile> radars;
+    QStringList terrain;                        // DTED yolları (arazi önbelleğine kaydedilir)
+    PropagationSettings propagation;
+    RadarParameters radarParameters;            // tekil radar
+    QVector<WeatherCell> weather;               // yalnızca "calculateWeather" açıksa
+};
+
+// Radar denklemi girdileri: kaydedilen "parameters" nesnesi (eksik alan varsayılan)
+QJsonObject radarParametersToJson(const RadarParameters &p);
+RadarParameters radarParametersFromJson(const QJsonObject &o);
+
+// Dosyayı okur; hata durumunda false döner ve errorString doldurulur
+bool loadScenarioFile(const QString &path, Scenario &out, QString *errorString = nullptr);
+
+// MainWindow::startSimulation ile aynı sırayla motoru kurar
+void applyScenario(const Scenario &scenario, SimEngine &engine);
+
+#endif // SCENARIO_H
@@ -23,6 +23,9 @@
 #include <QRegularExpression>
 #include <QHeaderView>
 #include <QTabBar>
+#include <QThread>
+#include <cmath>
+#include <algorithm>
 
 static QList<Sidebar::RadarProfile> s_radarProfiles;
 
@@ -257,6 +260,105 @@ void Sidebar::createGeneralTab()
     });
 }
 
+PropagationSettings Sidebar::propagationSettings() const
+{
+    PropagationSettings p;
+    if (advancedPropagationCombo) p.mode = static_cast<PropagationMode>(advancedPropagationCombo->currentIndex());
+    if (maxAltitudeSpin) p.maxAltitude = maxAltitudeSpin->value();
+    if (maxDistanceSpin) p.maxDistanceKm = maxDistanceSpin->value();
+    if (altitudeStepSpin) p.altitudeStep = altitudeStepSpin->value();
+    if (distanceStepSpin) p.distanceStep = distanceStepSpin->value();
+    if (groundProfileCombo) p.ground = static_cast<GroundProfile>(groundProfileCombo->currentIndex());
+    if (groundConductivitySpin) p.conductivity = groundConductivitySpin->value();
+    if (dielectricConstantSpin) p.permittivity = dielectricConstantSpin->value();
+    if (terrainProfileCombo) p.flatTerrain = terrainProfileCombo->currentIndex() == 1;
+    if (halfBeamWidthSpin) p.halfBeamWidthDeg = halfBeamWidthSpin->value();
+    if (centerFreqSpin) p.frequencyGHz = centerFreqSpin->value();
+    if (antennaPolarizationCombo) p.verticalPolarization = antennaPolarizationCombo->currentIndex() == 1;
+    return p;
+}
+
+RadarParameters Sidebar::radarParameters() const
+{
+    RadarParameters p;
+    if (txPeakPowerSpin) p.txPeakW = txPeakPowerSpin->value();
+    if (centerFreqSpin) p.frequencyGHz = centerFreqSpin->value();
+    if (pulseWidthSpin) p.pulseWidthUs = pulseWidthSpin->value();
+    if (fixedGainCheck && fixedGainCheck->isChecked() && fixedGainDbiSpin) {
+        p.gainDbi = fixedGainDbiSpin->value();
+    } else if (halfBeamWidthSpin) {
+        // Örüntü dosyası yok: kalem hüzme G ~ 26000 / θ² (θ: tam hüzme genişliği, derece)
+        const double beam = std::max(0.1, 2.0 * halfBeamWidthSpin->value());
+        p.gainDbi = 10.0 * std::log10(26000.0 / (beam * beam));
+    }
+    if (noiseFigureDbSpin) p.noiseFigureDb = noiseFigureDbSpin->value();
+    if (effectiveTempKSpin) p.temperatureK = effectiveTempKSpin->value();
+    if (totalSystemLossDbSpin) p.systemLossDb = totalSystemLossDbSpin->value();
+    if (timeDwellSecSpin) p.dwellSec = timeDwellSecSpin->value();
+    if (!prfValues.isEmpty()) p.prfHz = prfValues.first();
+    if (radarSnrThresholdDbSpin) p.snrThresholdDb = radarSnrThresholdDbSpin->value();
+    return p;
+}
+
+Wf::Settings Sidebar::waveformSettings() const
+{
+    Wf::Settings s;
+    if (pulseWidthSpin) s.pulseWidthUs = pulseWidthSpin->value();
+    if (bandwidthSpin) s.bandwidthMHz = bandwidthSpin->value();
+    if (waveformTypeCombo) s.type = Wf::typeFromName(waveformTypeCombo->currentText().toStdString());
+    if (barkerLengthCombo) s.barkerLength = barkerLengthCombo->currentText().toInt();
+    if (frankCodeSizeSpin) s.frankSize = qRound(frankCodeSizeSpin->value());
+    if (pCodeSizeSpin) s.pCodeSize = qRound(pCodeSizeSpin->value());
+    if (zcRootSpin) s.zcRoot = qRound(zcRootSpin->value());
+    if (windowingTypeCombo) s.window = Wf::windowFromName(windowingTypeCombo->currentText().toStdString());
+    return s;
+}
+
+Cfar::Settings Sidebar::cfarSettings() const
+{
+    Cfar::Settings s;
+    if (cfarTypeCombo) s.type = static_cast<Cfar::Type>(qBound(0, cfarTypeCombo->currentIndex(), 3));
+    if (numTrainingCellsSpin) s.trainingCells = numTrainingCellsSpin->value();
+    if (numGuardCellsSpin) s.guardCells = numGuardCellsSpin->value();
+    if (osRankSpin) s.osRank = osRankSpin->value();
+    if (pfaSpin) s.pfa = pfaSpin->value();
+    return s;
+}
+
+Stc::Settings Sidebar::stcSettings() const
+{
+    Stc::Settings s;
+    s.enabled = stcGroup && !stcGroup->isHidden() && useSTCCheck && useSTCCheck->isChecked();
+    if (stcCutoffRangeSpin) s.cutoffRange = stcCutoffRangeSpin->value();
+    if (stcFactorSpin) s.factor = stcFactorSpin->value();
+    return s;
+}
+
+PulseScheduler::Settings Sidebar::scheduleSettings() const
+{
+    PulseScheduler::Settings s;
+    if (!prfValues.isEmpty()) s.prfHz.assign(prfValues.begin(), prfValues.end());
+    s.hopPrfs = prfGroup && !prfGroup->isHidden() && hopPrfsRandomlyCheck && hopPrfsRandomlyCheck->isChecked();
+    if (centerFreqSpin) s.frequencyHz = centerFreqSpin->value() * 1e9;
+    s.freqHop = freqAgileGroup && !freqAgileGroup->isHidden() && useFreqHopCheck && useFreqHopCheck->isChecked();
+    if (lowerFreqMHzSpin) s.lowerFrequencyHz = lowerFreqMHzSpin->value() * 1e6;
+    if (upperFreqMHzSpin) s.upperFrequencyHz = upperFreqMHzSpin->value() * 1e6;
+    // Kanal aralığı dalga biçimi bant genişliği (bitişik kanallar örtüşmez)
+    if (bandwidthSpin) s.channelSpacingHz = std::max(bandwidthSpin->value(), 0.1) * 1e6;
+    return s;
+}
+
+AmbiguityResolver::Settings Sidebar::ambiguitySettings() const
+{
+    AmbiguityResolver::Settings s;
+    if (!prfValues.isEmpty()) s.prfHz.assign(prfValues.begin(), prfValues.end());
+    if (centerFreqSpin) s.frequencyHz = centerFreqSpin->value() * 1e9;
+    // Tek PRF'de çözüm yok. İki PRF'de ikisi de uyuşmalı; üç ve fazlasında 3-of-N:
+    // iki PRF'lik rastlantısal çakışmalar (hayaletler) aday sayısıyla hızla artar
+    s.minPrfs = s.prfHz.size() > 2 ? 3 : int(s.prfHz.size());
+    return s;
+}
+
 void Sidebar::createAdvancedPropertiesTab()
 {
     advancedPropertiesTab = new QWidget();
@@ -266,13 +368,21 @@ void Sidebar::createAdvancedPropertiesTab()
     QGroupBox *propagationGroup = new QGroupBox("Advanced Propagation");
     QFormLayout *propagationLayout = new QFormLayout(propagationGroup);
     
-    QComboBox *advancedPropagation = new QComboBox();
-    advancedPropagation->addItem("Radar is not moving: Calculate Propagation Factor (PPF) 360 degrees for once");
-    advancedPropagation->addItem("Radar is moving: Calculate Propagation Factor (PPF) 360 degree for step");
-    advancedPropagation->addItem("Radar is moving: Calculate Propagation Factor (PPF) only target direction");
-    advancedPropagation->addItem("Skip: Path Propagation Factor (PPF) calculation");
-    advancedPropagation->addItem("Skip: Path Propagation Factor (PPF) and Terrain calculation");
-    propagationLayout->addRow("Advanced Propagation:", advancedPropagation);
+    advancedPropagationCombo = new QComboBox();
+    advancedPropagationCombo->addItem("Radar is not moving: Calculate Propagation Factor (PPF) 360 degrees for once");
+    advancedPropagationCombo->addItem("Radar is moving: Refresh Propagation Factor (PPF) 360 degrees progressively (stalest directions each step)");
+    advancedPropagationCombo->addItem("Radar is moving: Calculate Propagation Factor (PPF) only target direction");
+    advancedPropagationCombo->addItem("Skip: Path Propagation Factor (PPF) calculation");
+    advancedPropagationCombo->addItem("Skip: Path Propagation Factor (PPF) and Terrain calculation");
+    // Hareketli 360°: adım başına worker sayısı kadar radyal (~65 ms, bench_pe)
+    const int peWorkers = std::max(1, QThread::idealThreadCount());
+    advancedPropagationCombo->setItemData(1, QString(
+        "Each physics step re-solves the %1 stalest of 360 one-degree radials (~65 ms each).\n"
+        "A full 360 degree refresh takes ~%2 steps, about %3 s of wall time on this machine;\n"
+        "directions not yet refreshed keep their older field (snapshot: propagation age).")
+        .arg(peWorkers).arg((360 + peWorkers - 1) / peWorkers).arg(360 * 0.065 / peWorkers, 0, 'f', 1),
+        Qt::ToolTipRole);
+    propagationLayout->addRow("Advanced Propagation:", advancedPropagationCombo);
     
     layout->addWidget(propagationGroup);
     
@@ -280,29 +390,29 @@ void Sidebar::createAdvancedPropertiesTab()
     QGroupBox *calcGroup = new QGroupBox("Calculation Parameters");
     QFormLayout *calcLayout = new QFormLayout(calcGroup);
     
-    QDoubleSpinBox *maxAltitude = new QDoubleSpinBox();
-    maxAltitude->setRange(0.0, 50000.0);
-    maxAltitude->setValue(10000.0);
-    maxAltitude->setSuffix(" m");
-    calcLayout->addRow("Max Altitude:", maxAltitude);
-    
-    QDoubleSpinBox *maxDistance = new QDoubleSpinBox();
-    maxDistance->setRange(0.1, 1000.0);
-    maxDistance->setValue(100.0);
-    maxDistance->setSuffix(" km");
-    calcLayout->addRow("Max Distance:", maxDistance);
-    
-    QDoubleSpinBox *altitudeStepSize = new QDoubleSpinBox();
-    altitudeStepSize->setRange(1.0, 1000.0);
-    altitudeStepSize->setValue(100.0);
-    altitudeStepSize->setSuffix(" m");
-    calcLayout->addRow("Altitude Step Size:", altitudeStepSize);
-    
-    QDoubleSpinBox *distanceStepSize = new QDoubleSpinBox();
-    distanceStepSize->setRange(1.0, 10000.0);
-    distanceStepSize->setValue(1000.0);
-    distanceStepSize->setSuffix(" m");
-    calcLayout->addRow("Distance Step Size:", distanceStepSize);
+    maxAltitudeSpin = new QDoubleSpinBox();
+    maxAltitudeSpin->setRange(0.0, 50000.0);
+    maxAltitudeSpin->setValue(10000.0);
+    maxAltitudeSpin->setSuffix(" m");
+    calcLayout->addRow("Max Altitude:", maxAltitudeSpin);
+    
+    maxDistanceSpin = new QDoubleSpinBox();
+    maxDistanceSpin->setRange(0.1, 1000.0);
+    maxDistanceSpin->setValue(100.0);
+    maxDistanceSpin->setSuffix(" km");
+    calcLayout->addRow("Max Distance:", maxDistanceSpin);
+    
+    altitudeStepSpin = new QDoubleSpinBox();
+    altitudeStepSpin->setRange(1.0, 1000.0);
+    altitudeStepSpin->setValue(100.0);
+    altitudeStepSpin->setSuffix(" m");
+    calcLayout->addRow("Altitude Step Size:", altitudeStepSpin);
+    
+    distanceStepSpin = new QDoubleSpinBox();
+    distanceStepSpin->setRange(1.0, 10000.0);
+    distanceStepSpin->setValue(1000.0);
+    distanceStepSpin->setSuffix(" m");
+    calcLayout->addRow("Distance Step Size:", distanceStepSpin);
     
     layout->addWidget(calcGroup);
     
@@ -310,22 +420,23 @@ void Sidebar::createAdvancedPropertiesTab()
     QGroupBox *groundGroup = new QGroupBox("Ground Profile");
     QFormLayout *groundLayout = new QFormLayout(groundGroup);
     
-    QComboBox *groundProfile = new QComboBox();
-    groundProfile->addItem("PEC Surface");
-    groundProfile->addItem("Impedance Surface");
-    groundLayout->addRow("Ground Profile:", groundProfile);
+    groundProfileCombo = new QComboBox();
+    groundProfileCombo->addItem("PEC Surface");
+    groundProfileCombo->addItem("Impedance Surface");
+    groundLayout->addRow("Ground Profile:", groundProfileCombo);
     
-    QDoubleSpinBox *groundConductivity = new QDoubleSpinBox();
-    groundConductivity->setRange(0.001, 100.0);
-    groundConductivity->setValue(0.005);
-    groundConductivity->setSuffix(" S/m");
-    groundLayout->addRow("Ground Conductivity:", groundConductivity);
+    groundConductivitySpin = new QDoubleSpinBox();
+    groundConductivitySpin->setRange(0.001, 100.0);
+    groundConductivitySpin->setDecimals(3);
+    groundConductivitySpin->setValue(0.005);
+    groundConductivitySpin->setSuffix(" S/m");
+    groundLayout->addRow("Ground Conductivity:", groundConductivitySpin);
     
-    QDoubleSpinBox *dielectricConstant = new QDoubleSpinBox();
-    dielectricConstant->setRange(1.0, 100.0);
-    dielectricConstant->setValue(15.0);
-    dielectricConstant->setDecimals(2);
-    groundLayout->addRow("Dielectric Constant:", dielectricConstant);
+    dielectricConstantSpin = new QDoubleSpinBox();
+    dielectricConstantSpin->setRange(1.0, 100.0);
+    dielectricConstantSpin->setValue(15.0);
+    dielectricConstantSpin->setDecimals(2);
+    groundLayout->addRow("Dielectric Constant:", dielectricConstantSpin);
     
     layout->addWidget(groundGroup);
     
@@ -333,17 +444,17 @@ void Sidebar::createAdvancedPropertiesTab()
     QGroupBox *terrainProfileGroup = new QGroupBox("Terrain Profile");
     QFormLayout *terrainProfileLayout = new QFormLayout(terrainProfileGroup);
     
-    QComboBox *terrainProfile = new QComboBox();
-    terrainProfile->addItem("Rough Terrain");
-    terrainProfile->addItem("Flat Terrain: not use DTED data");
-    terrainProfileLayout->addRow("Terrain Profile:", terrainProfile);
+    terrainProfileCombo = new QComboBox();
+    terrainProfileCombo->addItem("Rough Terrain");
+    terrainProfileCombo->addItem("Flat Terrain: not use DTED data");
+    terrainProfileLayout->addRow("Terrain Profile:", terrainProfileCombo);
     
-    QDoubleSpinBox *halfBeamWidth = new QDoubleSpinBox();
-    halfBeamWidth->setRange(0.1, 90.0);
-    halfBeamWidth->setValue(1.0);
-    halfBeamWidth->setDecimals(1);
-    halfBeamWidth->setSuffix(" deg");
-    terrainProfileLayout->addRow("Half Beam Width:", halfBeamWidth);
+    halfBeamWidthSpin = new QDoubleSpinBox();
+    halfBeamWidthSpin->setRange(0.1, 90.0);
+    halfBeamWidthSpin->setValue(1.0);
+    halfBeamWidthSpin->setDecimals(1);
+    halfBeamWidthSpin->setSuffix(" deg");
+    terrainProfileLayout->addRow("Half Beam Width:", halfBeamWidthSpin);
     
     layout->addWidget(terrainProfileGroup);
     
@@ -557,9 +668,11 @@ void Sidebar::createRadarTab()
     radarCfgLayout->addRow("Radar Mode:", radarModeCombo);
 
     centerFreqSpin = new QDoubleSpinBox();
+    // RadarConfig::centerFreqGHz ile aynı birim
     centerFreqSpin->setRange(0.1, 100.0);
-    centerFreqSpin->setValue(3000.0);
-    centerFreqSpin->setSuffix(" MHz");
+    centerFreqSpin->setDecimals(3);
+    centerFreqSpin->setValue(3.0);
+    centerFreqSpin->setSuffix(" GHz");
     radarCfgLayout->addRow("Center Frequency:", centerFreqSpin);
 
     txPeakPowerSpin = new QDoubleSpinBox();
@@ -1856,6 +1969,7 @@ void Sidebar::snapshotActiveRadarInto(RadarProfile &out) const
     out.velD = radarInitVelD();
     out.route = radarWaypointsData;
     out.cfg = currentRadarConfig;
+    out.parameters = radarParameters();
 }
 
 QList<Sidebar::RadarProfile> Sidebar::getAllRadarProfiles() const
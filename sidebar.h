@@ -21,6 +21,11 @@
 #include <QVector>
 #include <QStackedWidget>
 #include "mapwidget.h"
+#include "waveform.h"
+#include "cfar.h"
+#include "ambiguity.h"
+#include "stc.h"
+#include "pulsescheduler.h"
 
 class Sidebar : public QWidget
 {
@@ -127,6 +132,18 @@ private:
     QWidget *radarPage2;
     QWidget *targetTab;
     
+    // Advanced Propagations tab için değişkenler
+    QComboBox *advancedPropagationCombo{nullptr};
+    QDoubleSpinBox *maxAltitudeSpin{nullptr};
+    QDoubleSpinBox *maxDistanceSpin{nullptr};
+    QDoubleSpinBox *altitudeStepSpin{nullptr};
+    QDoubleSpinBox *distanceStepSpin{nullptr};
+    QComboBox *groundProfileCombo{nullptr};
+    QDoubleSpinBox *groundConductivitySpin{nullptr};
+    QDoubleSpinBox *dielectricConstantSpin{nullptr};
+    QComboBox *terrainProfileCombo{nullptr};
+    QDoubleSpinBox *halfBeamWidthSpin{nullptr};
+
     // Atmosphere tab için değişkenler
     QListWidget *weatherConditionList;
     QDoubleSpinBox *latitudeSpinBox;
@@ -147,14 +164,14 @@ private:
     // Radar Page 1 (Monostatic) bileşenleri ve durum
     QGroupBox *radarConfigGroup;
     QComboBox *radarModeCombo;        
-    QDoubleSpinBox *centerFreqSpin;   
-    QDoubleSpinBox *txPeakPowerSpin;  
-    QDoubleSpinBox *pulseWidthSpin;   
-    QDoubleSpinBox *bandwidthSpin;    
+    QDoubleSpinBox *centerFreqSpin{nullptr};
+    QDoubleSpinBox *txPeakPowerSpin{nullptr};  
+    QDoubleSpinBox *pulseWidthSpin{nullptr};   
+    QDoubleSpinBox *bandwidthSpin{nullptr};    
 
     // PRF Section
-    QGroupBox *prfGroup;
-    QCheckBox *hopPrfsRandomlyCheck;
+    QGroupBox *prfGroup{nullptr};
+    QCheckBox *hopPrfsRandomlyCheck{nullptr};
     QComboBox *prfCountCombo;         
     QComboBox *prfIndexCombo;         
     QDoubleSpinBox *prfValueSpin;     
@@ -162,50 +179,50 @@ private:
 
     // Waveform Section
     QGroupBox *waveformGroup;
-    QComboBox *waveformTypeCombo;     
-    QComboBox *barkerLengthCombo;     
-    QDoubleSpinBox *frankCodeSizeSpin;
-    QDoubleSpinBox *pCodeSizeSpin;    
-    QDoubleSpinBox *zcRootSpin;       
-    QComboBox *windowingTypeCombo;
+    QComboBox *waveformTypeCombo{nullptr};     
+    QComboBox *barkerLengthCombo{nullptr};     
+    QDoubleSpinBox *frankCodeSizeSpin{nullptr};
+    QDoubleSpinBox *pCodeSizeSpin{nullptr};    
+    QDoubleSpinBox *zcRootSpin{nullptr};       
+    QComboBox *windowingTypeCombo{nullptr};
 
     // CFAR Section
     QGroupBox *cfarGroup;
-    QCheckBox *useCFARCheck;
-    QComboBox *cfarTypeCombo;         
-    QSpinBox *numTrainingCellsSpin;
-    QSpinBox *numGuardCellsSpin;
-    QSpinBox *osRankSpin;
-    QDoubleSpinBox *pfaSpin;
+    QCheckBox *useCFARCheck{nullptr};
+    QComboBox *cfarTypeCombo{nullptr};         
+    QSpinBox *numTrainingCellsSpin{nullptr};
+    QSpinBox *numGuardCellsSpin{nullptr};
+    QSpinBox *osRankSpin{nullptr};
+    QDoubleSpinBox *pfaSpin{nullptr};
     QLabel *pfaFormattedLabel;
 
     // STC Section
-    QGroupBox *stcGroup;
-    QCheckBox *useSTCCheck;
-    QDoubleSpinBox *stcCutoffRangeSpin;     
-    QDoubleSpinBox *stcFactorSpin;
+    QGroupBox *stcGroup{nullptr};
+    QCheckBox *useSTCCheck{nullptr};
+    QDoubleSpinBox *stcCutoffRangeSpin{nullptr};
+    QDoubleSpinBox *stcFactorSpin{nullptr};
 
     // Frequency Agile Section
-    QGroupBox *freqAgileGroup;
-    QCheckBox *useFreqHopCheck;
-    QDoubleSpinBox *lowerFreqMHzSpin;       
-    QDoubleSpinBox *upperFreqMHzSpin;       
+    QGroupBox *freqAgileGroup{nullptr};
+    QCheckBox *useFreqHopCheck{nullptr};
+    QDoubleSpinBox *lowerFreqMHzSpin{nullptr};
+    QDoubleSpinBox *upperFreqMHzSpin{nullptr};
 
     // Radar Page 2 (Antenna Configuration)
     QGroupBox *antennaConfigGroup;
-    QComboBox *antennaPolarizationCombo;    
-    QCheckBox *fixedGainCheck;
+    QComboBox *antennaPolarizationCombo{nullptr};
+    QCheckBox *fixedGainCheck{nullptr};
     QCheckBox *beamPatternCheck;
-    QDoubleSpinBox *fixedGainDbiSpin;
+    QDoubleSpinBox *fixedGainDbiSpin{nullptr};
     QLineEdit *azPatternLine;
     QPushButton *azPatternBrowseBtn;
     QLineEdit *elPatternLine;
     QPushButton *elPatternBrowseBtn;
-    QDoubleSpinBox *timeDwellSecSpin;
-    QDoubleSpinBox *noiseFigureDbSpin;
-    QDoubleSpinBox *effectiveTempKSpin;
-    QDoubleSpinBox *totalSystemLossDbSpin;
-    QDoubleSpinBox *radarSnrThresholdDbSpin;
+    QDoubleSpinBox *timeDwellSecSpin{nullptr};
+    QDoubleSpinBox *noiseFigureDbSpin{nullptr};
+    QDoubleSpinBox *effectiveTempKSpin{nullptr};
+    QDoubleSpinBox *totalSystemLossDbSpin{nullptr};
+    QDoubleSpinBox *radarSnrThresholdDbSpin{nullptr};
     QDoubleSpinBox *timeScanSecSpin;
     QPushButton *showRadarConfigsBtn;
 
@@ -336,6 +353,20 @@ public:
     QList<WeatherCondition> getWeatherConditions() const { return weatherStore; }
     QStringList getDTEDFiles() const { return dtedStore; }
     bool sidebarCalculateWeatherEnabled() const { return calculateWeatherCheckSB ? calculateWeatherCheckSB->isChecked() : false; }
+    PropagationSettings propagationSettings() const;
+    // Etkin radarın radar denklemi girdileri (radar sekmesi, sayfa 1-2)
+    RadarParameters radarParameters() const;
+    // Etkin radarın dalga biçimi (Waveform grubu; Wf::get ile önbellekten alınır)
+    Wf::Settings waveformSettings() const;
+    // CFAR grubu ("Use CFAR Process" işaretli değilse cfarEnabled() false)
+    bool cfarEnabled() const { return useCFARCheck && useCFARCheck->isChecked(); }
+    Cfar::Settings cfarSettings() const;
+    // STC grubu (radar tipi grubu gizliyorsa kapalı); tablo Stc::table ile
+    Stc::Settings stcSettings() const;
+    // PRF ve Frequency Agile gruplarından darbe çizelgesi (PRF değerleri, atlama aralığı)
+    PulseScheduler::Settings scheduleSettings() const;
+    // Çoklu PRF belirsizlik çözümü (PRF değerleri ve merkez frekans)
+    AmbiguityResolver::Settings ambiguitySettings() const;
 
     struct RadarProfile {
         QString name;
@@ -347,6 +378,7 @@ public:
         double velD{0.0};
         QVector<RadarWaypoint> route;
         RadarConfig cfg;
+        RadarParameters parameters;
     };
 
     QList<RadarProfile> getAllRadarProfiles() const;
@@ -0,0 +1,688 @@
+#include "simengine.h"
+#include "workstealingpool.h"
+#include <QMutexLocker>
+#include <QDebug>
+#include <QDir>
+#include <chrono>
+#include <thread>
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+bool solvesPropagation(PropagationMode mode)
+{
+    return mode == PropagationMode::StationaryOnce360 || mode == PropagationMode::MovingRolling360
+           || mode == PropagationMode::MovingTargetDirection;
+}
+
+PropagationField::Settings fieldSettings(const PropagationSettings &p, const Los::Params &los)
+{
+    PropagationField::Settings fs;
+    fs.maxAltitude = p.maxAltitude;
+    fs.maxDistance = p.maxDistanceKm * 1000.0;
+    fs.altitudeStep = p.altitudeStep;
+    fs.distanceStep = p.distanceStep;
+    fs.flatTerrain = p.flatTerrain;
+    fs.minAntennaAgl = los.minAntennaAgl;
+    fs.sampleSpacing = los.sampleSpacing;
+    fs.pe.frequencyHz = p.frequencyGHz * 1e9;
+    // PE açısı hüzmeyi kapsasın; geniş hüzmelerde N patlamasın diye 10° ile sınırlı
+    const double beam = 2.0 * p.halfBeamWidthDeg;
+    fs.pe.maxAngleDeg = std::clamp(beam, 1.0, 10.0);
+    fs.pe.beamwidthDeg = std::min(beam, fs.pe.maxAngleDeg);
+    fs.pe.ground = p.ground == GroundProfile::Impedance ? Pe::Ground::Impedance : Pe::Ground::Pec;
+    fs.pe.polarization = p.verticalPolarization ? Pe::Polarization::Vertical : Pe::Polarization::Horizontal;
+    fs.pe.conductivity = p.conductivity;
+    fs.pe.permittivity = p.permittivity;
+    fs.pe.kFactor = los.kFactor;
+    return fs;
+}
+
+DetectionEngine::Radar detectionRadar(const EntityStore &s, int i, const RadarParameters &p)
+{
+    DetectionEngine::Radar r;
+    r.X = s.X[i];
+    r.Y = s.Y[i];
+    r.Z = s.Z[i];
+    r.frequencyGHz = p.frequencyGHz;
+    r.constantDb = RadarEq::constantDb(p.txPeakW, p.frequencyGHz * 1e9, p.pulseWidthUs * 1e-6, p.gainDbi,
+                                       p.noiseFigureDb, p.temperatureK, p.systemLossDb, p.dwellSec * p.prfHz);
+    r.thresholdDb = p.snrThresholdDb;
+    return r;
+}
+
+} // namespace
+
+SimEngine::SimEngine(QObject *parent)
+    : QObject(parent)
+    , terrain(std::make_shared<TerrainTileCache>())
+    , los(terrain)
+{
+    qRegisterMetaType<SimSnapshot>("SimSnapshot");
+}
+
+SimEngine::~SimEngine()
+{
+}
+
+bool SimEngine::addTerrainFile(const QString &path, QString *errorString)
+{
+    // Önbelleğin kendi kilidi var; motor kilidi gerekmez
+    if (!terrain->addFile(path, errorString)) return false;
+    los.invalidate();
+    // DTED kümesi değişti: haritalar yeni anahtarla yeniden kurulur
+    QMutexLocker locker(&mutex);
+    radarCoverage.clear();
+    radarFields.clear();
+    propagationDb.clear();
+    return true;
+}
+
+void SimEngine::setPropagationSettings(const PropagationSettings &settings)
+{
+    QMutexLocker locker(&mutex);
+    propagation = settings;
+    radarCoverage.clear();
+    radarFields.clear();
+    propagationDb.clear();
+}
+
+PropagationSettings SimEngine::propagationSettings() const
+{
+    QMutexLocker locker(&mutex);
+    return propagation;
+}
+
+void SimEngine::setLineOfSightEnabled(bool enabled)
+{
+    QMutexLocker locker(&mutex);
+    m_losEnabled = enabled;
+    if (!enabled) {
+        losVisible.clear();
+        propagationDb.clear();
+    }
+    los.invalidate();
+}
+
+void SimEngine::setLineOfSightMoveThreshold(double meters)
+{
+    QMutexLocker locker(&mutex);
+    los.setMoveThreshold(std::max(0.0, meters));
+}
+
+PropagationField::Stats SimEngine::propagationStats() const
+{
+    QMutexLocker locker(&mutex);
+    return propagationTick;
+}
+
+void SimEngine::setRadarParameters(const RadarParameters &parameters)
+{
+    QMutexLocker locker(&mutex);
+    primaryParameters = parameters;
+}
+
+void SimEngine::setWeatherCells(const QVector<WeatherCell> &cells)
+{
+    std::vector<RadarEq::Cell> out;
+    out.reserve(std::size_t(cells.size()));
+    for (const WeatherCell &w : cells) {
+        out.push_back(RadarEq::makeCell(w.lat, w.lon, w.radiusKm * 1000.0, w.type == WeatherType::Fog,
+                                        w.rainRate, w.fogVisibility, w.temperatureK));
+    }
+    QMutexLocker locker(&mutex);
+    detection.setWeather(out);
+}
+
+DetectionEngine::Stats SimEngine::detectionStats() const
+{
+    QMutexLocker locker(&mutex);
+    return detection.lastStats();
+}
+
+std::vector<EchoGenerator::Target> SimEngine::echoTargets(int radar)
+{
+    QMutexLocker locker(&mutex);
+    std::vector<EchoGenerator::Target> out;
+    const int primaryCount = primaryRadar.size();
+    if (radar < 0 || radar >= primaryCount + radarTable.store.size()) return out;
+    primaryRadar.syncGeodetic();
+    radarTable.store.syncGeodetic();
+    targetTable.store.syncGeodetic();
+
+    const EntityStore &s = (radar < primaryCount) ? primaryRadar : radarTable.store;
+    const int i = (radar < primaryCount) ? radar : radar - primaryCount;
+    EchoGenerator::Platform p;
+    p.X = s.X[i]; p.Y = s.Y[i]; p.Z = s.Z[i];
+    p.lat = s.lat[i]; p.lon = s.lon[i];
+    p.velN = s.velN[i]; p.velE = s.velE[i]; p.velD = s.velD[i];
+    const EntityStore &t = targetTable.store;
+    EchoGenerator::kinematics(p, t.X.data(), t.Y.data(), t.Z.data(), t.lat.data(), t.lon.data(),
+                              t.velN.data(), t.velE.data(), t.velD.data(), targetRcs.data(),
+                              std::size_t(t.size()), out);
+    return out;
+}
+
+QVector<SimDetectionEvent> SimEngine::takeDetectionEvents(int *dropped)
+{
+    QMutexLocker locker(&mutex);
+    QVector<SimDetectionEvent> out;
+    out.swap(pendingDetections);
+    if (dropped) *dropped = droppedDetections;
+    droppedDetections = 0;
+    return out;
+}
+
+LosEngine::Stats SimEngine::lineOfSightStats() const
+{
+    QMutexLocker locker(&mutex);
+    return los.lastStats();
+}
+
+void SimEngine::setPhysicsHz(int hz)
+{
+    m_physicsHz = std::max(1, hz);
+}
+
+void SimEngine::setDisplayHz(int hz)
+{
+    m_displayHz = std::max(1, hz);
+}
+
+void SimEngine::setTimeScale(double scale)
+{
+    m_timeScale = (scale > 0.0) ? scale : AsFastAsPossible;
+}
+
+void SimEngine::setPaused(bool paused)
+{
+    m_paused = paused;
+}
+
+void SimEngine::requestSteps(int ticks)
+{
+    if (ticks > 0) m_pendingSteps.fetch_add(ticks);
+}
+
+void SimEngine::requestStop()
+{
+    m_stopRequested = true;
+}
+
+void SimEngine::run()
+{
+    using Clock = std::chrono::steady_clock;
+
+    m_stopRequested = false;
+    m_running = true;
+
+    const int hz = m_physicsHz.load();
+    const double dtSim = 1.0 / hz;
+    // Bu kadar geride kalırsak yetişmeye çalışmak yerine saati yeniden hizala
+    const auto maxLag = std::chrono::seconds(1);
+    // Uzun adım aralıklarında (ör. x0.1 @ 1 Hz) stop/pause'a yanıt süresi sınırı
+    const auto maxSleep = std::chrono::milliseconds(20);
+    // Beklemesiz modda kilit başına adım sayısı
+    const int fastBatch = 64;
+
+    // Sapmasız saat: her adımın zamanı t0 + n*dt/scale ile mutlak olarak hesaplanır,
+    // uyku hataları birikmez; geç kalınan adımlar arka arkaya işlenir. Ölçek
+    // değiştiğinde veya duraklatmadan dönüldüğünde t0 yeniden tabanlanır.
+    const auto runStart = Clock::now();
+    auto t0 = runStart;
+    quint64 n = 0;
+    double scaleUsed = m_timeScale.load();
+    bool wasPaused = false;
+    auto nextDisplay = runStart;
+
+    // Elde edilen hızlanma, yayınlar arasındaki sim/duvar süresinden ölçülür
+    auto rateWall = runStart;
+    double rateSim = simulationTime();
+    double speedUp = 0.0;
+
+    auto publish = [&](Clock::time_point now) {
+        SimSnapshot snap = snapshot();
+        const double wallDt = std::chrono::duration<double>(now - rateWall).count();
+        if (wallDt > 0.0 && !wasPaused) speedUp = (snap.simTime - rateSim) / wallDt;
+        rateWall = now;
+        rateSim = snap.simTime;
+        snap.wallTime = std::chrono::duration<double>(now - runStart).count();
+        snap.speedUp = speedUp;
+        emit snapshotReady(snap);
+    };
+
+    while (!m_stopRequested.load(std::memory_order_relaxed)) {
+        const auto displayPeriod = std::chrono::duration_cast<Clock::duration>(
+            std::chrono::duration<double>(1.0 / m_displayHz.load()));
+        auto now = Clock::now();
+
+        if (m_paused.load(std::memory_order_relaxed)) {
+            wasPaused = true;
+            const int pending = m_pendingSteps.exchange(0);
+            if (pending > 0) {
+                step(pending);
+                publish(Clock::now());
+            } else {
+                std::this_thread::sleep_for(maxSleep);
+            }
+            continue;
+        }
+
+        const double scale = m_timeScale.load(std::memory_order_relaxed);
+        if (wasPaused || scale != scaleUsed) {
+            t0 = now;
+            n = 0;
+            scaleUsed = scale;
+            if (wasPaused) { rateWall = now; rateSim = simulationTime(); }
+            wasPaused = false;
+        }
+
+        if (scale <= 0.0) {
+            step(fastBatch);
+        } else {
+            const auto stepPeriod = std::chrono::duration_cast<Clock::duration>(
+                std::chrono::duration<double>(dtSim / scale));
+            const auto due = t0 + stepPeriod * static_cast<Clock::rep>(n + 1);
+            if (due > now) {
+                std::this_thread::sleep_until(std::min(due, now + maxSleep));
+                if (Clock::now() < due) continue;
+            } else if (now - due > maxLag) {
+                qDebug() << "SimEngine: physics fell behind by more than 1 s, re-aligning clock";
+                t0 = now - stepPeriod * static_cast<Clock::rep>(n + 1);
+            }
+            step();
+            ++n;
+        }
+
+        now = Clock::now();
+        if (now >= nextDisplay) {
+            publish(now);
+            nextDisplay += displayPeriod;
+            if (nextDisplay < now) nextDisplay = now + displayPeriod;
+        }
+    }
+
+    // Son durumu da yayınla
+    publish(Clock::now());
+    m_running = false;
+    emit stopped();
+}
+
+void SimEngine::step(int ticks)
+{
+    QMutexLocker locker(&mutex);
+    const double deltaTime = 1.0 / m_physicsHz.load();
+    for (int i = 0; i < ticks; ++i) stepLocked(deltaTime);
+}
+
+void SimEngine::stepLocked(double deltaTime)
+{
+    simTime += deltaTime;
+    ++tickCount;
+
+    // Her tablo dense diziler üzerinde doğrusal tek geçişle ilerler
+    primaryRadar.step(deltaTime, waypointArriveThresholdMeters);
+    radarTable.store.step(deltaTime, waypointArriveThresholdMeters);
+    targetTable.store.step(deltaTime, waypointArriveThresholdMeters);
+
+    if (m_losEnabled.load()) updateLineOfSightLocked();
+    updateDetectionLocked();
+}
+
+void SimEngine::updateLineOfSightLocked()
+{
+    primaryRadar.syncGeodetic();
+    radarTable.store.syncGeodetic();
+    targetTable.store.syncGeodetic();
+
+    auto fill = [](const EntityStore &s, std::vector<Los::Endpoint> &out) {
+        for (int i = 0; i < s.size(); ++i) out.push_back(Los::Endpoint{s.lat[i], s.lon[i], s.alt[i]});
+    };
+    losRadars.clear();
+    fill(primaryRadar, losRadars);
+    fill(radarTable.store, losRadars);
+    losTargets.clear();
+    fill(targetTable.store, losTargets);
+
+    if (propagation.mode == PropagationMode::StationaryOnce360) {
+        refreshCoverageLocked();
+        los.compute(losRadars, losTargets, losVisible, &radarCoverage);
+    } else {
+        radarCoverage.clear();
+        los.compute(losRadars, losTargets, losVisible);
+    }
+
+    if (solvesPropagation(propagation.mode)) {
+        updatePropagationLocked();
+    } else {
+        radarFields.clear();
+        propagationDb.clear();
+    }
+}
+
+bool SimEngine::radarStationaryLocked(std::size_t r) const
+{
+    const int primaryCount = primaryRadar.size();
+    const EntityStore &s = (int(r) < primaryCount) ? primaryRadar : radarTable.store;
+    const int i = (int(r) < primaryCount) ? int(r) : int(r) - primaryCount;
+    return s.velN[i] == 0.0 && s.velE[i] == 0.0 && s.velD[i] == 0.0 && s.remainingWaypoints(i) == 0;
+}
+
+void SimEngine::updatePropagationLocked()
+{
+    WorkStealingPool &pool = los.workers();
+    // Hareketli radar: adım başına worker sayısı kadar radyal (radyal ~65 ms); 360°
+    // her adımda değil, ~360 / worker adımda dolaşılır (MovingRolling360). Tek
+    // çekirdekte tur ~23 s duvar saatidir; arada kullanılan en eski radyalin yaşı
+    // SimSnapshot::propagationAge'dir
+    const int budget = pool.workerCount();
+    propagationTick = PropagationField::Stats{};
+
+    const bool targetDirection = propagation.mode == PropagationMode::MovingTargetDirection;
+
+    radarFields.resize(losRadars.size());
+    for (std::size_t r = 0; r < losRadars.size(); ++r) {
+        std::unique_ptr<PropagationField> &field = radarFields[r];
+        if (!field) field = std::make_unique<PropagationField>(fieldSettings(propagation, los.parameters()));
+        field->setRadar(losRadars[r], simTime);
+        if (targetDirection) {
+            // Aynı azimut kovasındaki hedefler tek radyali paylaşır
+            bearingMark.assign(std::size_t(field->azimuthBins()), 0);
+            bearingBins.clear();
+            for (const Los::Endpoint &t : losTargets) {
+                const int a = field->azimuthBin(t);
+                if (a < 0 || bearingMark[a]) continue;
+                bearingMark[a] = 1;
+                bearingBins.push_back(a);
+            }
+            field->refresh(*terrain, pool, 0, &bearingBins);
+        } else {
+            field->refresh(*terrain, pool, radarStationaryLocked(r) ? 0 : budget);
+        }
+        const PropagationField::Stats &st = field->lastStats();
+        propagationTick.solved += st.solved;
+        propagationTick.stale += st.stale;
+        propagationTick.profilesReused += st.profilesReused;
+        propagationTick.oldestAge = std::max(propagationTick.oldestAge, st.oldestAge);
+        propagationTick.milliseconds += st.milliseconds;
+    }
+
+    const std::size_t nt = losTargets.size();
+    propagationDb.resize(losRadars.size() * nt);
+    for (std::size_t r = 0; r < losRadars.size(); ++r)
+        for (std::size_t t = 0; t < nt; ++t) propagationDb[r * nt + t] = radarFields[r]->factorDb(losTargets[t]);
+}
+
+void SimEngine::updateDetectionLocked()
+{
+    const int primaryCount = primaryRadar.size();
+    const std::size_t nr = std::size_t(primaryCount + radarTable.store.size());
+    const std::size_t nt = std::size_t(targetTable.store.size());
+    const std::size_t pairs = nr * nt;
+
+    detectionRadars.resize(nr);
+    for (int r = 0; r < primaryCount; ++r) detectionRadars[r] = detectionRadar(primaryRadar, r, primaryParameters);
+    for (int i = 0; i < radarTable.store.size(); ++i)
+        detectionRadars[primaryCount + i] = detectionRadar(radarTable.store, i, radarParameters[i]);
+
+    // LOS/PE matrisleri bu adımın varlık sayılarına aitse kullanılır
+    const bool haveLos = m_losEnabled.load() && losVisible.size() == pairs;
+    const bool havePe = haveLos && propagationDb.size() == pairs;
+    const EntityStore &t = targetTable.store;
+    detectionEvents.clear();
+    detection.compute(detectionRadars, t.X.data(), t.Y.data(), t.Z.data(), targetRcs.data(), nt,
+                      haveLos ? losVisible.data() : nullptr, havePe ? propagationDb.data() : nullptr,
+                      pairs >= DetectionEngine::kParallelPairs ? &los.workers() : nullptr,
+                      snrDb, detectionEvents);
+
+    for (const DetectionEngine::Event &e : detectionEvents) {
+        if (pendingDetections.size() >= kMaxPendingDetections) {
+            ++droppedDetections;
+            continue;
+        }
+        SimDetectionEvent ev;
+        ev.simTime = simTime;
+        ev.radar = e.radar;
+        if (e.radar >= primaryCount) ev.radarName = radarTable.names[e.radar - primaryCount];
+        ev.targetName = targetTable.names[e.target];
+        ev.detected = e.detected;
+        ev.snrDb = e.snrDb;
+        pendingDetections.push_back(ev);
+    }
+}
+
+void SimEngine::refreshCoverageLocked()
+{
+    CoverageMap::Settings cs;
+    cs.maxAltitude = propagation.maxAltitude;
+    cs.maxDistance = propagation.maxDistanceKm * 1000.0;
+    cs.altitudeStep = std::max(1.0, propagation.altitudeStep);
+    cs.distanceStep = std::max(1.0, propagation.distanceStep);
+    const QString cacheDir = QDir(terrain->cacheDirectory()).filePath("coverage");
+
+    radarCoverage.resize(losRadars.size());
+    for (std::size_t r = 0; r < losRadars.size(); ++r) {
+        std::shared_ptr<const CoverageMap> &map = radarCoverage[r];
+        if (!radarStationaryLocked(r)) {
+            map.reset();
+            continue;
+        }
+        const Los::Endpoint &p = losRadars[r];
+        if (map && std::fabs(map->radar().lat - p.lat) < 1e-7 && std::fabs(map->radar().lon - p.lon) < 1e-7
+            && std::fabs(map->radar().alt - p.alt) < 0.01) continue;
+
+        bool fromDisk = false;
+        map = CoverageMap::loadOrBuild(*terrain, los.workers(), p, cs, los.parameters(), cacheDir, &fromDisk);
+        qDebug() << "Coverage map for radar" << r << (fromDisk ? "loaded from cache" : "computed")
+                 << map->azimuthBins() << "x" << map->rangeBins() << "x" << map->altitudeLevels();
+    }
+}
+
+SimSnapshot SimEngine::snapshot()
+{
+    QMutexLocker locker(&mutex);
+    return snapshotLocked();
+}
+
+SimSnapshot SimEngine::snapshotLocked()
+{
+    // lat/lon/alt yalnızca yayın anında, toplu olarak ECEF'ten türetilir
+    primaryRadar.syncGeodetic();
+    radarTable.store.syncGeodetic();
+    targetTable.store.syncGeodetic();
+
+    SimSnapshot snap;
+    snap.simTime = simTime;
+    snap.tick = tickCount;
+    if (!primaryRadar.empty()) {
+        snap.radarValid = true;
+        snap.radar = SimEntityPosition{QString(), primaryRadar.lat[0], primaryRadar.lon[0], primaryRadar.alt[0]};
+    }
+    auto fill = [](const EntityTable &t, QVector<SimEntityPosition> &out) {
+        const EntityStore &s = t.store;
+        out.resize(s.size());
+        for (int i = 0; i < s.size(); ++i) {
+            out[i] = SimEntityPosition{t.names[i], s.lat[i], s.lon[i], s.alt[i]};
+        }
+    };
+    fill(radarTable, snap.radars);
+    fill(targetTable, snap.targets);
+
+    // Matris son adımdaki varlık sayılarına aittir; henüz adım atılmadıysa ya da
+    // arada ekleme/silme olduysa şimdi hesaplanır
+    const int radarCount = primaryRadar.size() + radarTable.store.size();
+    const int targetCount = targetTable.store.size();
+    if (m_losEnabled.load()) {
+        const std::size_t pairs = std::size_t(radarCount) * targetCount;
+        if (losVisible.size() != pairs || (solvesPropagation(propagation.mode) && propagationDb.size() != pairs))
+            updateLineOfSightLocked();
+        snap.lineOfSight = QVector<quint8>(losVisible.begin(), losVisible.end());
+        snap.propagationDb = QVector<float>(propagationDb.begin(), propagationDb.end());
+        snap.propagationAge = propagationTick.oldestAge;
+        for (int t = 0; t < targetCount; ++t) {
+            bool any = false;
+            for (int r = 0; r < radarCount && !any; ++r) any = losVisible[std::size_t(r) * targetCount + t] != 0;
+            snap.targets[t].visible = any;
+        }
+    }
+
+    if (snrDb.size() != std::size_t(radarCount) * targetCount
+        || detection.state().size() != std::size_t(radarCount) * targetCount)
+        updateDetectionLocked();
+    snap.snrDb = QVector<float>(snrDb.begin(), snrDb.end());
+    const std::vector<unsigned char> &detected = detection.state();
+    for (int t = 0; t < targetCount; ++t) {
+        bool any = false;
+        for (int r = 0; r < radarCount && !any; ++r) any = detected[std::size_t(r) * targetCount + t] != 0;
+        snap.targets[t].detected = any;
+    }
+    snap.detections.swap(pendingDetections);
+    snap.detectionsDropped = droppedDetections;
+    droppedDetections = 0;
+    return snap;
+}
+
+double SimEngine::simulationTime() const
+{
+    QMutexLocker locker(&mutex);
+    return simTime;
+}
+
+std::vector<EntityWaypoint> SimEngine::toEntityRoute(const QVector<RadarRouteWaypoint> &route)
+{
+    std::vector<EntityWaypoint> out;
+    out.reserve(static_cast<size_t>(route.size()));
+    for (const auto &wp : route) {
+        EntityWaypoint ew;
+        ew.lat = wp.lat; ew.lon = wp.lon; ew.alt = wp.alt;
+        ew.velN = wp.velN; ew.velE = wp.velE; ew.velD = wp.velD;
+        out.push_back(ew);
+    }
+    return out;
+}
+
+int SimEngine::EntityTable::insert(const QString &name, double lat, double lon, double alt,
+                                   double velN, double velE, double velD)
+{
+    auto it = index.constFind(name);
+    if (it != index.constEnd()) {
+        // Aynı isim: yerinde yeniden başlat, rotayı sıfırla
+        store.setKinematics(it.value(), lat, lon, alt, velN, velE, velD);
+        store.setRoute(it.value(), {});
+        return it.value();
+    }
+    const int i = store.add(lat, lon, alt, velN, velE, velD);
+    names.push_back(name);
+    index.insert(name, i);
+    return i;
+}
+
+void SimEngine::EntityTable::remove(const QString &name)
+{
+    auto it = index.find(name);
+    if (it == index.end()) return;
+    const int i = it.value();
+    index.erase(it);
+    const int moved = store.removeSwap(i);
+    if (moved >= 0) {
+        names[i] = names[moved];
+        index[names[i]] = i;
+    }
+    names.removeLast();
+}
+
+void SimEngine::EntityTable::clear()
+{
+    store.clear();
+    names.clear();
+    index.clear();
+}
+
+void SimEngine::setRadarInitialKinematics(double lat, double lon, double alt, double velN, double velE, double velD)
+{
+    QMutexLocker locker(&mutex);
+    if (primaryRadar.empty()) primaryRadar.add(lat, lon, alt, velN, velE, velD);
+    else primaryRadar.setKinematics(0, lat, lon, alt, velN, velE, velD);
+    simTime = 0.0;
+    tickCount = 0;
+    // Yeni senaryo: satır 0 eklenmiş olabilir, tespitler sıfırdan
+    detection.reset();
+    pendingDetections.clear();
+    droppedDetections = 0;
+}
+
+void SimEngine::setRadarRoute(const QVector<RadarRouteWaypoint> &route)
+{
+    QMutexLocker locker(&mutex);
+    if (primaryRadar.empty()) return;
+    primaryRadar.setRoute(0, toEntityRoute(route));
+}
+
+void SimEngine::addRadarProfile(const QString &name, double lat, double lon, double alt, double velN, double velE, double velD, const QVector<RadarRouteWaypoint> &route,
+                                const RadarParameters &parameters)
+{
+    QMutexLocker locker(&mutex);
+    const int i = radarTable.insert(name, lat, lon, alt, velN, velE, velD);
+    radarTable.store.setRoute(i, toEntityRoute(route));
+    if (std::size_t(i) < radarParameters.size()) radarParameters[i] = parameters;
+    else radarParameters.push_back(parameters);
+    // Tespit matrisi yeni satırla hizalı kalsın (snapshot bir sonraki adımı beklemeden okur)
+    detection.resize(std::size_t(primaryRadar.size() + radarTable.store.size()), targetRcs.size());
+}
+
+void SimEngine::addTarget(const Target &target)
+{
+    QMutexLocker locker(&mutex);
+    const int i = targetTable.insert(target.name, target.initLatitude, target.initLongitude, target.initAltitude,
+                                     target.initVelocityN, target.initVelocityE, target.initVelocityD);
+    if (std::size_t(i) < targetRcs.size()) targetRcs[i] = static_cast<float>(target.initRCS);
+    else targetRcs.push_back(static_cast<float>(target.initRCS));
+    detection.resize(std::size_t(primaryRadar.size() + radarTable.store.size()), targetRcs.size());
+}
+
+void SimEngine::removeTarget(const QString &targetName)
+{
+    QMutexLocker locker(&mutex);
+    auto it = targetTable.index.constFind(targetName);
+    if (it == targetTable.index.constEnd()) return;
+    const int i = it.value();
+    // Tespit durumu da swap-with-last ile; önce son adımdan sonra eklenenlere hizala
+    detection.resize(std::size_t(primaryRadar.size() + radarTable.store.size()), targetRcs.size());
+    detection.removeTarget(std::size_t(i));
+    targetRcs[i] = targetRcs.back();
+    targetRcs.pop_back();
+    targetTable.remove(targetName);
+}
+
+void SimEngine::clearTargets()
+{
+    QMutexLocker locker(&mutex);
+    targetTable.clear();
+    targetRcs.clear();
+    detection.resize(std::size_t(primaryRadar.size() + radarTable.store.size()), 0);
+}
+
+void SimEngine::setTargetRoute(const QString &targetName, const QVector<RadarRouteWaypoint> &route)
+{
+    QMutexLocker locker(&mutex);
+    // Rota yalnızca eklenmiş target'lar için anlamlı (addTarget rotayı sıfırlar)
+    auto it = targetTable.index.constFind(targetName);
+    if (it == targetTable.index.constEnd()) return;
+    targetTable.store.setRoute(it.value(), toEntityRoute(route));
+}
+
+void SimEngine::setWaypointArriveThreshold(double meters)
+{
+    QMutexLocker locker(&mutex);
+    waypointArriveThresholdMeters = meters;
+}
+
+void SimEngine::setBasisRefreshDistance(double meters)
+{
+    QMutexLocker locker(&mutex);
+    basisRefreshDistanceMeters = std::max(0.0, meters);
+    primaryRadar.setBasisRefreshDistance(basisRefreshDistanceMeters);
+    radarTable.store.setBasisRefreshDistance(basisRefreshDistanceMeters);
+    targetTable.store.setBasisRefreshDistance(basisRefreshDistanceMeters);
+}
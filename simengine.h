@@ -0,0 +1,233 @@
+#ifndef SIMENGINE_H
+#define SIMENGINE_H
+
+#include <QObject>
+#include <QHash>
+#include <QVector>
+#include <QString>
+#include <QMutex>
+#include <QMetaType>
+#include <atomic>
+#include <memory>
+#include "simtypes.h"
+#include "entitystore.h"
+#include "terraincache.h"
+#include "losengine.h"
+#include "coveragemap.h"
+#include "propagationfield.h"
+#include "detectionengine.h"
+#include "echogenerator.h"
+
+// UI'ya gönderilen tek bir varlık konumu
+struct SimEntityPosition {
+    QString name;
+    double lat{0.0};
+    double lon{0.0};
+    double alt{0.0};
+    bool visible{true};             // target: en az bir radardan görüş hattı var (LOS kapalıysa true)
+    bool detected{false};           // target: en az bir radarda SNR eşiği aşıldı
+};
+
+// Tespit durumu değişimi (radar denklemi, SimEngine::updateDetectionLocked)
+struct SimDetectionEvent {
+    double simTime{0.0};
+    int radar{0};                   // matris satırı: tekil radar (varsa) sonra radars
+    QString radarName;              // tekil radar için boş
+    QString targetName;
+    bool detected{false};           // false: tespit kaybedildi
+    float snrDb{0.0f};
+};
+
+// Ekran hızında yayınlanan simülasyon görüntüsü
+struct SimSnapshot {
+    double simTime{0.0};            // simülasyon süresi (s)
+    quint64 tick{0};                // toplam fizik adımı
+    double wallTime{0.0};           // run() başından beri duvar saati (s)
+    double speedUp{0.0};            // son yayın aralığında elde edilen sim/duvar oranı
+    bool radarValid{false};
+    SimEntityPosition radar;        // tekil radar
+    QVector<SimEntityPosition> radars;  // çoklu radar
+    QVector<SimEntityPosition> targets;
+    // Radar x target görüş matrisi, satır sırası: tekil radar (varsa) sonra radars.
+    // LOS kapalıyken boş.
+    QVector<quint8> lineOfSight;
+    // Aynı sırada yayılım faktörü (dB, PE). NaN: radyal henüz çözülmedi ya da
+    // hedef ızgara dışında. PE modu seçili değilse boş.
+    QVector<float> propagationDb;
+    // Radar kaydığı hâlde henüz tazelenmemiş, kullanılan en eski PE radyalinin
+    // yaşı (simülasyon s, tüm radarlar). 360° tur sürerken büyür, sabit radarda 0.
+    double propagationAge{0.0};
+    // Aynı sırada SNR (dB, radar denklemi); her adımda hesaplanır
+    QVector<float> snrDb;
+    // Önceki yayından bu yana tespit olayları (en fazla kMaxPendingDetections)
+    QVector<SimDetectionEvent> detections;
+    int detectionsDropped{0};
+};
+
+Q_DECLARE_METATYPE(SimSnapshot)
+
+// Kinematik motoru: GUI'den bağımsız, kendi thread'inde sabit adımlı çalışır.
+// Fizik adımı (physicsHz) ile UI'ya yayın hızı (displayHz) birbirinden ayrıdır.
+class SimEngine : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit SimEngine(QObject *parent = nullptr);
+    ~SimEngine();
+
+    void setPhysicsHz(int hz);
+    void setDisplayHz(int hz);
+    int physicsHz() const { return m_physicsHz.load(); }
+    int displayHz() const { return m_displayHz.load(); }
+
+    // Zaman ölçeği: 1.0 gerçek zaman, 10.0 on kat hızlı; <= 0 beklemesiz
+    // (CPU'nun izin verdiği hızda). Çalışırken değiştirilebilir.
+    static constexpr double AsFastAsPossible = 0.0;
+    void setTimeScale(double scale);
+    double timeScale() const { return m_timeScale.load(); }
+
+    // Duraklatma ve duraklatılmışken N adım ilerletme (thread-safe)
+    void setPaused(bool paused);
+    bool isPaused() const { return m_paused.load(); }
+    void requestSteps(int ticks);
+
+    // Senaryo kurulumu (thread-safe)
+    void setRadarInitialKinematics(double lat, double lon, double alt, double velN, double velE, double velD);
+    void setRadarRoute(const QVector<RadarRouteWaypoint> &route);
+    void addRadarProfile(const QString &name, double lat, double lon, double alt, double velN, double velE, double velD, const QVector<RadarRouteWaypoint> &route,
+                         const RadarParameters &parameters = RadarParameters());
+    // Tekil radarın radar denklemi girdileri
+    void setRadarParameters(const RadarParameters &parameters);
+    void addTarget(const Target &target);
+    void removeTarget(const QString &targetName);
+    void clearTargets();
+    void setTargetRoute(const QString &targetName, const QVector<RadarRouteWaypoint> &route);
+    void setWaypointArriveThreshold(double meters);
+    // ENU tabanının yeniden hesaplanacağı yer değiştirme (m)
+    void setBasisRefreshDistance(double meters);
+
+    // DTED arazi önbelleği (worker thread'ler Reader ile kilitsiz okur)
+    bool addTerrainFile(const QString &path, QString *errorString = nullptr);
+    std::shared_ptr<TerrainTileCache> terrainCache() const { return terrain; }
+
+    // Her adımda radar-target görüş hattı (arazi yüklü değilse yalnızca dünya eğriliği)
+    void setLineOfSightEnabled(bool enabled);
+    bool lineOfSightEnabled() const { return m_losEnabled.load(); }
+    // Önbellek eşiği: uç nokta bu kadar kaymadıkça çift yeniden taranmaz (m)
+    void setLineOfSightMoveThreshold(double meters);
+    LosEngine::Stats lineOfSightStats() const;
+
+    // Advanced Propagations ayarları. StationaryOnce360 modunda hızı sıfır ve rotası
+    // bitmiş radarlar için 360° görüş haritası bir kez kurulur (disk önbellekli);
+    // o radarların target sorguları ızgaradan okunur.
+    // LOS açıkken PE modlarında her radar için PropagationField tutulur: 360°
+    // modlarında sabit radarın tüm radyalleri bir kez, hareketli radarınkiler adım
+    // başına worker sayısı kadar (en bayattan) çözülür; tam tur ~360 / worker adım
+    // sürer (radyal ~65 ms, tek çekirdekte ~23 s). Yalnızca hedef yönü
+    // modunda hedef içeren azimut kovalarının bayat radyalleri çözülür.
+    void setPropagationSettings(const PropagationSettings &settings);
+    PropagationSettings propagationSettings() const;
+    // Son adımda tüm radarlar için toplam
+    PropagationField::Stats propagationStats() const;
+
+    // Her adımda tüm radar x target çiftleri için SNR ve tespit (target initRCS ile).
+    // LOS açıkken engelli çiftler tespit edilmez, PE modlarında F iki yönlü eklenir;
+    // hücreler verilirse yol üstündeki yağmur/sis zayıflaması düşülür.
+    void setWeatherCells(const QVector<WeatherCell> &cells);
+    DetectionEngine::Stats detectionStats() const;
+    // Bekleyen tespit olaylarını snapshot almadan boşaltır (radarsim_cli --events)
+    QVector<SimDetectionEvent> takeDetectionEvents(int *dropped = nullptr);
+    static constexpr int kMaxPendingDetections = 10000;
+    // Radar satırından (tekil radar sonra radars) tüm target'lara menzil, radyal
+    // hız ve RCS: EchoGenerator::setTargets girdisi. Geodeziği tazeler.
+    std::vector<EchoGenerator::Target> echoTargets(int radar);
+
+    // ticks kadar sabit fizik adımı (deltaTime = 1/physicsHz), tek kilitle
+    void step(int ticks = 1);
+    // Geodezik görünümü tazeler (ECEF -> lat/lon/alt), bu yüzden const değil
+    SimSnapshot snapshot();
+    double simulationTime() const;
+
+    void requestStop();
+    bool isRunning() const { return m_running.load(); }
+
+public slots:
+    // Sabit adımlı döngü; requestStop() çağrılana kadar bloklar
+    void run();
+
+signals:
+    void snapshotReady(const SimSnapshot &snapshot);
+    void stopped();
+
+private:
+    // Dense varlık tablosu + kenarlarda kullanılan isim -> indeks eşlemesi
+    struct EntityTable {
+        EntityStore store;
+        QVector<QString> names;
+        QHash<QString, int> index;
+
+        int insert(const QString &name, double lat, double lon, double alt,
+                   double velN, double velE, double velD);
+        void remove(const QString &name);
+        void clear();
+    };
+
+    void stepLocked(double deltaTime);
+    void updateLineOfSightLocked();
+    void refreshCoverageLocked();
+    void updatePropagationLocked();
+    void updateDetectionLocked();
+    bool radarStationaryLocked(std::size_t r) const;
+    SimSnapshot snapshotLocked();
+    static std::vector<EntityWaypoint> toEntityRoute(const QVector<RadarRouteWaypoint> &route);
+
+    mutable QMutex mutex;
+    std::atomic<int> m_physicsHz{10};
+    std::atomic<int> m_displayHz{30};
+    std::atomic<double> m_timeScale{1.0};
+    std::atomic<bool> m_paused{false};
+    std::atomic<int> m_pendingSteps{0};
+    std::atomic<bool> m_stopRequested{false};
+    std::atomic<bool> m_running{false};
+    std::atomic<bool> m_losEnabled{false};
+
+    double simTime{0.0};
+    quint64 tickCount{0};
+
+    EntityStore primaryRadar;   // tekil radar (0 ya da 1 eleman)
+    EntityTable radarTable;     // multi-radar
+    EntityTable targetTable;
+
+    double waypointArriveThresholdMeters{10.0};
+    double basisRefreshDistanceMeters{100.0};
+
+    std::shared_ptr<TerrainTileCache> terrain;
+
+    LosEngine los;
+    std::vector<Los::Endpoint> losRadars;     // yalnızca büyüdüğünde ayırır
+    std::vector<Los::Endpoint> losTargets;
+    std::vector<unsigned char> losVisible;
+
+    PropagationSettings propagation;
+    // LOS radar sırasıyla (tekil radar, sonra radars); hareketli radar için boş
+    std::vector<std::shared_ptr<const CoverageMap>> radarCoverage;
+    // LOS radar sırasıyla; PE modu dışında boş
+    std::vector<std::unique_ptr<PropagationField>> radarFields;
+    std::vector<float> propagationDb;
+    PropagationField::Stats propagationTick;
+    std::vector<int> bearingBins;             // hedef yönü modu: bu adımın azimut kovaları
+    std::vector<unsigned char> bearingMark;
+
+    RadarParameters primaryParameters;
+    std::vector<RadarParameters> radarParameters;   // radarTable ile aynı sırada
+    std::vector<float> targetRcs;                   // targetTable ile aynı sırada (dBsm)
+    DetectionEngine detection;
+    std::vector<DetectionEngine::Radar> detectionRadars;
+    std::vector<float> snrDb;
+    std::vector<DetectionEngine::Event> detectionEvents;
+    QVector<SimDetectionEvent> pendingDetections;
+    int droppedDetections{0};
+};
+
+#endif // SIMENGINE_H
@@ -0,0 +1,105 @@
+#ifndef SIMTYPES_H
+#define SIMTYPES_H
+
+// Simülasyon çekirdeğinin paylaştığı senaryo tipleri. Yalnızca QtCore'a bağlıdır;
+// böylece radarsim_cli gibi Widgets/WebEngine içermeyen hedefler de kullanabilir.
+
+#include <QString>
+#include <QStringList>
+#include <QMetaType>
+
+// Target struct
+struct Target {
+    QString name;
+    // Initial Position
+    double initLatitude;
+    double initLongitude;
+    double initAltitude; // m
+    double initRCS; // dBsm
+    double initVelocityN; // mps
+    double initVelocityE; // mps
+    double initVelocityD; // mps
+    // Trajectory
+    double trajLatitude;
+    double trajLongitude;
+    double trajAltitude; // m
+    double trajVelocityN; // mps
+    double trajVelocityE; // mps
+    double trajVelocityD; // mps
+    // Waypoints
+    QStringList waypoints;
+};
+
+// Radar route waypoint (for simulation)
+struct RadarRouteWaypoint {
+    double lat{0.0};
+    double lon{0.0};
+    double alt{0.0};
+    double velN{0.0};
+    double velE{0.0};
+    double velD{0.0};
+};
+
+Q_DECLARE_METATYPE(RadarRouteWaypoint)
+
+// Advanced Propagations sekmesi (Sidebar::createAdvancedPropertiesTab); sıra combo ile aynı
+enum class PropagationMode {
+    StationaryOnce360 = 0,      // radar sabit: 360° bir kez hesapla
+    MovingRolling360,           // radar hareketli: 360° adım başına en bayat radyallerden kısmi tazeleme
+    MovingTargetDirection,      // radar hareketli: yalnızca target yönü
+    SkipPpf,
+    SkipPpfAndTerrain
+};
+
+enum class GroundProfile {
+    Pec = 0,
+    Impedance
+};
+
+struct PropagationSettings {
+    PropagationMode mode{PropagationMode::StationaryOnce360};
+    double maxAltitude{10000.0};    // m
+    double maxDistanceKm{100.0};
+    double altitudeStep{100.0};     // m
+    double distanceStep{1000.0};    // m
+    // PE çözücüsü (Ground / Terrain Profile grupları ve radar yapılandırması)
+    GroundProfile ground{GroundProfile::Pec};
+    double conductivity{0.005};     // S/m
+    double permittivity{15.0};      // bağıl dielektrik sabiti
+    bool flatTerrain{false};        // "Flat Terrain: not use DTED data"
+    double halfBeamWidthDeg{1.0};
+    double frequencyGHz{3.0};
+    bool verticalPolarization{false};
+};
+
+// Radar denklemi girdileri (Sidebar radar yapılandırması; varsayılanlar Sidebar ile aynı)
+struct RadarParameters {
+    double txPeakW{8000.0};
+    double frequencyGHz{3.0};
+    double pulseWidthUs{0.51};
+    double gainDbi{20.0};           // Fixed Gain kapalıysa hüzme genişliğinden kestirilir
+    double noiseFigureDb{3.0};
+    double temperatureK{290.0};
+    double systemLossDb{2.0};
+    double dwellSec{1.0};           // dwellSec * prfHz darbe uyumlu toplanır
+    double prfHz{750.0};
+    double snrThresholdDb{10.0};
+};
+
+enum class WeatherType {
+    Rain = 0,
+    Fog
+};
+
+// Zayıflatıcı hava hücresi: merkezden radiusKm yarıçaplı düşey silindir
+struct WeatherCell {
+    WeatherType type{WeatherType::Rain};
+    double lat{0.0};
+    double lon{0.0};
+    double radiusKm{10.0};
+    double rainRate{10.0};          // mm/h
+    double fogVisibility{300.0};    // m
+    double temperatureK{283.0};
+};
+
+#endif // SIMTYPES_H
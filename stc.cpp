@@ -0,0 +1,34 @@
+#include "stc.h"
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <mutex>
+#include <tuple>
+
+namespace Stc {
+
+std::shared_ptr<const AlignedVector<float>> table(const Settings &settings, std::size_t rangeBins,
+                                                  double rangePerBin)
+{
+    if (!settings.enabled || rangeBins == 0) return nullptr;
+    const double cutoff = std::max(settings.cutoffRange, 0.0), factor = std::max(settings.factor, 0.0);
+
+    static std::mutex mutex;
+    static std::map<std::tuple<double, double, std::size_t, double>, std::shared_ptr<const AlignedVector<float>>> tables;
+    std::lock_guard<std::mutex> lock(mutex);
+    std::shared_ptr<const AlignedVector<float>> &lut = tables[{cutoff, factor, rangeBins, rangePerBin}];
+    if (lut) return lut;
+
+    auto g = std::make_shared<AlignedVector<float>>(rangeBins, 1.0f);
+    if (cutoff > 0.0) {
+        for (std::size_t r = 0; r < rangeBins; ++r) {
+            const double x = double(r) * rangePerBin / cutoff;
+            if (x >= 1.0) break;
+            (*g)[r] = static_cast<float>(std::pow(x, factor));
+        }
+    }
+    lut = std::move(g);
+    return lut;
+}
+
+} // namespace Stc
@@ -0,0 +1,29 @@
+#ifndef STC_H
+#define STC_H
+
+#include <cstddef>
+#include <memory>
+#include "alignedbuffer.h"
+
+// Sensitivity Time Control: yakın menzil yankılarını menzile bağlı zayıflatma.
+// Güç kazancı g(R) = (R / Rc)^factor (R < Rc), R >= Rc için 1; factor = 4
+// yankının R⁻⁴ düşüşünü kesim menziline kadar dengeler.
+//
+// Eğri (ayar, hücre sayısı, hücre boyu) başına bir kez menzil hücresi
+// tablosuna dökülür ve paylaşılır; işleme zincirinde ayrı bir geçiş yerine
+// güç yazan döngüye çarpım olarak katılır (bkz. RangeDopplerProcessor).
+namespace Stc {
+
+struct Settings {
+    bool enabled{false};
+    double cutoffRange{50000.0};    // m
+    double factor{4.0};
+};
+
+// Hücre r'nin (menzil r · rangePerBin) güç kazancı; kapalıysa nullptr
+std::shared_ptr<const AlignedVector<float>> table(const Settings &settings, std::size_t rangeBins,
+                                                  double rangePerBin);
+
+} // namespace Stc
+
+#endif // STC_H
@@ -0,0 +1,487 @@
+#include "terraincache.h"
+#include <QFile>
+#include <QFileInfo>
+#include <QDir>
+#include <QSaveFile>
+#include <QDateTime>
+#include <QStandardPaths>
+#include <QCryptographicHash>
+#include <QMutexLocker>
+#include <QDebug>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace {
+
+// DTED yerleşimi (MIL-PRF-89020B): UHL 80 + DSI 648 + ACC 2700, ardından
+// her boylam çizgisi için bir veri kaydı (güneyden kuzeye).
+constexpr int kUhlSize = 80;
+constexpr int kDataOffset = 80 + 648 + 2700;
+constexpr int kRecordHeader = 8;     // 0xAA + blok no (3) + boylam no (2) + enlem no (2)
+constexpr int kRecordChecksum = 4;
+constexpr qint16 kDtedVoid = -32767;
+
+struct UhlInfo {
+    double south{0.0};
+    double west{0.0};
+    int lonIntervalTenths{0};   // 0.1 yay saniyesi
+    int latIntervalTenths{0};
+    int lonLines{0};
+    int latPoints{0};
+};
+
+int parseInt(const char *p, int n, bool *ok)
+{
+    return QByteArray(p, n).trimmed().toInt(ok);
+}
+
+// DDDMMSSH
+bool parseDms(const char *p, double &deg)
+{
+    bool ok1 = false, ok2 = false, ok3 = false;
+    const int d = parseInt(p, 3, &ok1);
+    const int m = parseInt(p + 3, 2, &ok2);
+    const int s = parseInt(p + 5, 2, &ok3);
+    if (!ok1 || !ok2 || !ok3) return false;
+    deg = d + m / 60.0 + s / 3600.0;
+    if (p[7] == 'S' || p[7] == 'W') deg = -deg;
+    return true;
+}
+
+bool parseUhl(const QByteArray &h, UhlInfo &out)
+{
+    if (h.size() < kUhlSize || !h.startsWith("UHL")) return false;
+    const char *p = h.constData();
+    bool ok1 = false, ok2 = false, ok3 = false, ok4 = false;
+    if (!parseDms(p + 4, out.west) || !parseDms(p + 12, out.south)) return false;
+    out.lonIntervalTenths = parseInt(p + 20, 4, &ok1);
+    out.latIntervalTenths = parseInt(p + 24, 4, &ok2);
+    out.lonLines = parseInt(p + 47, 4, &ok3);
+    out.latPoints = parseInt(p + 51, 4, &ok4);
+    return ok1 && ok2 && ok3 && ok4 && out.lonIntervalTenths > 0 && out.latIntervalTenths > 0
+        && out.lonLines > 1 && out.latPoints > 1;
+}
+
+// Yerel ızgara dosyası: 64 baytlık başlık + karolu int16 ızgara (Terrain::tileGrid)
+// + karo başına en yüksek nokta (Terrain::tileMaxima)
+struct GridHeader {
+    char magic[8];
+    qint64 sourceSize;
+    qint64 sourceMtime;
+    qint32 rows;
+    qint32 cols;
+    double south;
+    double west;
+    double latStep;
+    double lonStep;
+};
+static_assert(sizeof(GridHeader) == 64, "grid header must stay 64 bytes");
+constexpr char kGridMagic[8] = {'R', 'D', 'R', 'T', 'G', 'R', 'D', '3'};
+
+qint64 gridBytes(int rows, int cols)
+{
+    return qint64(Terrain::tilesFor(rows)) * Terrain::tilesFor(cols) * (Terrain::kTilePosts + 1) * qint64(sizeof(qint16));
+}
+
+bool convertDted(const QString &src, const QString &dst, QString *errorString)
+{
+    QFile in(src);
+    if (!in.open(QIODevice::ReadOnly)) {
+        if (errorString) *errorString = QString("Cannot open DTED: %1").arg(src);
+        return false;
+    }
+    const QByteArray raw = in.readAll();
+    UhlInfo uhl;
+    if (!parseUhl(raw, uhl)) {
+        if (errorString) *errorString = QString("Invalid DTED header: %1").arg(src);
+        return false;
+    }
+    const qint64 recordSize = kRecordHeader + 2 * qint64(uhl.latPoints) + kRecordChecksum;
+    if (raw.size() < kDataOffset + recordSize * uhl.lonLines) {
+        if (errorString) *errorString = QString("Truncated DTED: %1").arg(src);
+        return false;
+    }
+
+    const int rows = uhl.latPoints, cols = uhl.lonLines;
+    std::vector<qint16> grid(std::size_t(rows) * std::size_t(cols));
+    const uchar *base = reinterpret_cast<const uchar *>(raw.constData()) + kDataOffset;
+    for (int c = 0; c < cols; ++c) {
+        const uchar *rec = base + recordSize * c;
+        if (rec[0] != 0xAA) {
+            if (errorString) *errorString = QString("Corrupt DTED record %1: %2").arg(c).arg(src);
+            return false;
+        }
+        const uchar *e = rec + kRecordHeader;
+        for (int i = 0; i < rows; ++i) {
+            // Büyük endian, işaret-büyüklük
+            const int v = (int(e[2 * i]) << 8) | e[2 * i + 1];
+            const qint16 h = (v & 0x8000) ? qint16(-(v & 0x7fff)) : qint16(v);
+            grid[std::size_t(rows - 1 - i) * cols + c] = (h == kDtedVoid) ? TerrainCell::Void : h;
+        }
+    }
+
+    std::vector<qint16> tiled, maxima;
+    Terrain::tileGrid(grid.data(), rows, cols, tiled);
+    Terrain::tileMaxima(tiled, maxima);
+
+    GridHeader hdr{};
+    std::memcpy(hdr.magic, kGridMagic, sizeof(kGridMagic));
+    const QFileInfo fi(src);
+    hdr.sourceSize = fi.size();
+    hdr.sourceMtime = fi.lastModified().toMSecsSinceEpoch();
+    hdr.rows = rows;
+    hdr.cols = cols;
+    hdr.south = uhl.south;
+    hdr.west = uhl.west;
+    hdr.latStep = uhl.latIntervalTenths / 36000.0;
+    hdr.lonStep = uhl.lonIntervalTenths / 36000.0;
+
+    QSaveFile out(dst);
+    if (!out.open(QIODevice::WriteOnly)
+        || out.write(reinterpret_cast<const char *>(&hdr), sizeof(hdr)) != qint64(sizeof(hdr))
+        || out.write(reinterpret_cast<const char *>(tiled.data()), qint64(tiled.size() * sizeof(qint16)))
+               != qint64(tiled.size() * sizeof(qint16))
+        || out.write(reinterpret_cast<const char *>(maxima.data()), qint64(maxima.size() * sizeof(qint16)))
+               != qint64(maxima.size() * sizeof(qint16))
+        || !out.commit()) {
+        if (errorString) *errorString = QString("Cannot write terrain grid: %1").arg(dst);
+        return false;
+    }
+    return true;
+}
+
+} // namespace
+
+// ---------------------------------------------------------------- TerrainCell
+
+TerrainCell::~TerrainCell()
+{
+    if (file && mapping) file->unmap(mapping);
+}
+
+float TerrainCell::nearest(double lat, double lon) const
+{
+    const int r = std::clamp(static_cast<int>(std::lround((grid.north - lat) / grid.latStep)), 0, grid.rows - 1);
+    const int c = std::clamp(static_cast<int>(std::lround((lon - grid.west) / grid.lonStep)), 0, grid.cols - 1);
+    const qint16 h = grid.posts[Terrain::postIndex(grid.tilesX, r, c)];
+    return (h == Void) ? std::numeric_limits<float>::quiet_NaN() : float(h);
+}
+
+// ---------------------------------------------------------------- TerrainTileCache
+
+TerrainTileCache::TerrainTileCache(const QString &cacheDirectory)
+    : cacheDir(cacheDirectory)
+    , cells(new std::atomic<TerrainCell *>[kCells])
+    , hasSource(new std::atomic<bool>[kCells])
+    , sources(kCells)
+{
+    for (int i = 0; i < kCells; ++i) {
+        cells[i].store(nullptr, std::memory_order_relaxed);
+        hasSource[i].store(false, std::memory_order_relaxed);
+    }
+    activeReaders[0].store(0);
+    activeReaders[1].store(0);
+
+    if (cacheDir.isEmpty()) {
+        const QString base = QStandardPaths::writableLocation(QStandardPaths::CacheLocation);
+        cacheDir = base.isEmpty() ? QDir::temp().filePath("radarsim-terrain")
+                                  : QDir(base).filePath("terrain");
+    }
+    QDir().mkpath(cacheDir);
+}
+
+TerrainTileCache::~TerrainTileCache()
+{
+    clear();
+    QMutexLocker locker(&writeMutex);
+    reclaim(true);
+}
+
+int TerrainTileCache::cellIndex(double lat, double lon)
+{
+    if (!(lat >= -90.0 && lat <= 90.0) || !std::isfinite(lon)) return -1;
+    while (lon >= 180.0) lon -= 360.0;
+    while (lon < -180.0) lon += 360.0;
+    const int la = std::min(static_cast<int>(std::floor(lat)) + 90, 179);
+    const int lo = static_cast<int>(std::floor(lon)) + 180;
+    return la * 360 + lo;
+}
+
+bool TerrainTileCache::addFile(const QString &path, QString *errorString)
+{
+    QFile f(path);
+    if (!f.open(QIODevice::ReadOnly)) {
+        if (errorString) *errorString = QString("Cannot open DTED: %1").arg(path);
+        return false;
+    }
+    UhlInfo uhl;
+    if (!parseUhl(f.read(kUhlSize), uhl)) {
+        if (errorString) *errorString = QString("Invalid DTED header: %1").arg(path);
+        return false;
+    }
+    // Köşe noktası tam dereceye oturur; yuvarlama hatasına karşı merkezden indeksle
+    const int index = cellIndex(uhl.south + 0.5, uhl.west + 0.5);
+    if (index < 0) return false;
+
+    QMutexLocker locker(&writeMutex);
+    Source &s = sources[index];
+    if (!s.path.isEmpty() && s.latIntervalTenthArcSec <= uhl.latIntervalTenths) return true;
+    s.path = QFileInfo(path).absoluteFilePath();
+    s.latIntervalTenthArcSec = uhl.latIntervalTenths;
+    hasSource[index].store(true);
+
+    // Daha kaba bir sürüm eşlenmişse bırak; sonraki sorgu yenisini yükler
+    if (TerrainCell *old = cells[index].exchange(nullptr)) {
+        loaded.erase(std::remove(loaded.begin(), loaded.end(), index), loaded.end());
+        std::vector<TerrainCell *> victims{old};
+        retire(victims);
+    }
+    return true;
+}
+
+void TerrainTileCache::clear()
+{
+    QMutexLocker locker(&writeMutex);
+    std::vector<TerrainCell *> victims;
+    for (int index : loaded) {
+        if (TerrainCell *c = cells[index].exchange(nullptr)) victims.push_back(c);
+    }
+    loaded.clear();
+    for (int i = 0; i < kCells; ++i) {
+        hasSource[i].store(false);
+        sources[i] = Source();
+    }
+    retire(victims);
+}
+
+QStringList TerrainTileCache::files() const
+{
+    QMutexLocker locker(&writeMutex);
+    QStringList out;
+    for (const Source &s : sources) if (!s.path.isEmpty()) out.append(s.path);
+    return out;
+}
+
+void TerrainTileCache::setBudgetMB(int megabytes)
+{
+    budgetBytes.store(qint64(std::max(1, megabytes)) << 20);
+    QMutexLocker locker(&writeMutex);
+    evictFor(0);
+}
+
+// --- epoch ---
+
+int TerrainTileCache::enterRead()
+{
+    for (;;) {
+        const quint64 e = epoch.load();
+        const int p = static_cast<int>(e & 1);
+        activeReaders[p].fetch_add(1);
+        // Sayaç artarken faz değiştiyse yeniden dene; aksi halde bu faza kayıtlıyız
+        if (epoch.load() == e) return p;
+        activeReaders[p].fetch_sub(1);
+    }
+}
+
+void TerrainTileCache::leaveRead(int parity)
+{
+    activeReaders[parity].fetch_sub(1, std::memory_order_release);
+}
+
+bool TerrainTileCache::tryAdvance()
+{
+    // e -> e+1: yeni okuyucular e+1'in fazına kaydolur; o fazda e-1'den kalan
+    // okuyucu varsa ilerlenmez. Epoch E'de kaldırılan hücreyi görmüş olabilecek
+    // (E ve öncesinde girmiş) okuyucuların hepsi E+2'ye ulaşıldığında çıkmıştır.
+    quint64 e = epoch.load();
+    if (activeReaders[static_cast<int>((e + 1) & 1)].load(std::memory_order_acquire) != 0) return false;
+    return epoch.compare_exchange_strong(e, e + 1);
+}
+
+void TerrainTileCache::retire(std::vector<TerrainCell *> &victims)
+{
+    if (victims.empty()) return;
+    // Tablodan çıkarıldıktan sonra damgala; bütçe hemen düşer, bellek reclaim'de
+    const quint64 e = epoch.load();
+    for (TerrainCell *c : victims) {
+        residentBytes.fetch_sub(c->bytes);
+        pending.push_back(Retired{c, e});
+    }
+    victims.clear();
+    reclaim();
+}
+
+void TerrainTileCache::reclaim(bool force)
+{
+    if (pending.empty()) return;
+    if (!force) {
+        // En yeni damgaya kadar en fazla iki adım; okuyucu varsa sonraki çağrıya kalır
+        const quint64 newest = pending.back().epoch;
+        for (int i = 0; i < 2 && epoch.load() < newest + 2; ++i)
+            if (!tryAdvance()) break;
+    }
+    const quint64 now = epoch.load();
+    std::size_t kept = 0;
+    for (const Retired &r : pending) {
+        if (force || r.epoch + 2 <= now) delete r.cell;
+        else pending[kept++] = r;
+    }
+    pending.resize(kept);
+    pendingCount.store(static_cast<int>(kept), std::memory_order_release);
+}
+
+// --- yükleme ---
+
+QString TerrainTileCache::gridPathFor(const QString &sourcePath) const
+{
+    const QByteArray key = QCryptographicHash::hash(sourcePath.toUtf8(), QCryptographicHash::Sha1).toHex();
+    return QDir(cacheDir).filePath(QString::fromLatin1(key.left(20)) + ".i16grid");
+}
+
+std::unique_ptr<TerrainCell> TerrainTileCache::mapCell(const Source &source, QString *errorString) const
+{
+    const QString gridPath = gridPathFor(source.path);
+    const QFileInfo srcInfo(source.path);
+
+    auto tryMap = [&]() -> std::unique_ptr<TerrainCell> {
+        auto file = std::make_unique<QFile>(gridPath);
+        if (!file->open(QIODevice::ReadOnly) || file->size() < qint64(sizeof(GridHeader))) return nullptr;
+        uchar *m = file->map(0, file->size());
+        if (!m) return nullptr;
+        GridHeader hdr;
+        std::memcpy(&hdr, m, sizeof(hdr));
+        const qint64 expected = qint64(sizeof(GridHeader)) + gridBytes(hdr.rows, hdr.cols);
+        if (std::memcmp(hdr.magic, kGridMagic, sizeof(kGridMagic)) != 0
+            || hdr.sourceSize != srcInfo.size()
+            || hdr.sourceMtime != srcInfo.lastModified().toMSecsSinceEpoch()
+            || hdr.rows < 2 || hdr.cols < 2 || file->size() != expected) {
+            file->unmap(m);
+            return nullptr;
+        }
+        auto cell = std::make_unique<TerrainCell>();
+        Terrain::GridView &g = cell->grid;
+        g.posts = reinterpret_cast<const qint16 *>(m + sizeof(GridHeader));
+        g.rows = hdr.rows;
+        g.cols = hdr.cols;
+        g.tilesX = Terrain::tilesFor(hdr.cols);
+        g.north = hdr.south + (hdr.rows - 1) * hdr.latStep;
+        g.west = hdr.west;
+        g.latStep = hdr.latStep;
+        g.lonStep = hdr.lonStep;
+        g.tileMax = g.posts + std::size_t(Terrain::tilesFor(hdr.rows)) * g.tilesX * Terrain::kTilePosts;
+        cell->bytes = file->size();
+        cell->mapping = m;
+        cell->file = std::move(file);
+        return cell;
+    };
+
+    if (auto cell = tryMap()) return cell;
+    // Izgara yok ya da kaynak değişmiş: DTED'i bir kez aç
+    if (!convertDted(source.path, gridPath, errorString)) return nullptr;
+    auto cell = tryMap();
+    if (!cell && errorString) *errorString = QString("Cannot map terrain grid: %1").arg(gridPath);
+    return cell;
+}
+
+void TerrainTileCache::evictFor(qint64 incomingBytes)
+{
+    const qint64 budget = budgetBytes.load();
+    if (residentBytes.load() + incomingBytes <= budget || loaded.empty()) return;
+
+    // En eski kullanılanlar önde
+    std::sort(loaded.begin(), loaded.end(), [this](int a, int b) {
+        return cells[a].load()->lastUse.load(std::memory_order_relaxed)
+             < cells[b].load()->lastUse.load(std::memory_order_relaxed);
+    });
+    std::vector<TerrainCell *> victims;
+    qint64 freed = 0;
+    std::size_t n = 0;
+    while (n < loaded.size() && residentBytes.load() - freed + incomingBytes > budget) {
+        TerrainCell *c = cells[loaded[n]].exchange(nullptr);
+        freed += c->bytes;
+        victims.push_back(c);
+        ++n;
+    }
+    loaded.erase(loaded.begin(), loaded.begin() + static_cast<std::ptrdiff_t>(n));
+    retire(victims);
+}
+
+const TerrainCell *TerrainTileCache::load(int index)
+{
+    QMutexLocker locker(&writeMutex);
+    if (TerrainCell *c = cells[index].load()) return c;   // başka bir thread yükledi
+    if (!hasSource[index].load()) return nullptr;
+
+    reclaim();
+    QString error;
+    std::unique_ptr<TerrainCell> cell = mapCell(sources[index], &error);
+    if (!cell) {
+        qDebug() << "Terrain cell unavailable:" << error;
+        // Tekrar tekrar denenmesin
+        hasSource[index].store(false);
+        return nullptr;
+    }
+    evictFor(cell->bytes);
+    cell->lastUse.store(useClock.fetch_add(1) + 1, std::memory_order_relaxed);
+    residentBytes.fetch_add(cell->bytes);
+    TerrainCell *raw = cell.release();
+    cells[index].store(raw, std::memory_order_release);
+    loaded.push_back(index);
+    return raw;
+}
+
+float TerrainTileCache::elevation(double lat, double lon)
+{
+    Reader reader(*this);
+    return reader.elevation(lat, lon);
+}
+
+// ---------------------------------------------------------------- Reader
+
+TerrainTileCache::Reader::Reader(TerrainTileCache &c)
+    : cache(c)
+    , parity(c.enterRead())
+{
+}
+
+TerrainTileCache::Reader::~Reader()
+{
+    cache.leaveRead(parity);
+    // Bekleyen hücre varsa fırsatçı geri kazanım; kilit meşgulse sonraki kapanışa kalır
+    if (cache.pendingCount.load(std::memory_order_acquire) != 0 && cache.writeMutex.tryLock()) {
+        cache.reclaim();
+        cache.writeMutex.unlock();
+    }
+}
+
+const TerrainCell *TerrainTileCache::Reader::cellAt(double lat, double lon)
+{
+    const int index = cellIndex(lat, lon);
+    if (index < 0) return nullptr;
+    if (index == lastIndex) return last;
+
+    const TerrainCell *c = cache.cells[index].load(std::memory_order_acquire);
+    if (!c && cache.hasSource[index].load(std::memory_order_relaxed)) {
+        // Iska: yükleme çıkarma yapabilir, bu yüzden epoch dışında bekle
+        cache.leaveRead(parity);
+        cache.load(index);
+        parity = cache.enterRead();
+        c = cache.cells[index].load(std::memory_order_acquire);
+    }
+    if (c) {
+        // LRU damgası: yalnızca değiştiyse yaz (paylaşılan satırı kirletme)
+        const quint32 now = cache.useClock.load(std::memory_order_relaxed);
+        if (c->lastUse.load(std::memory_order_relaxed) != now)
+            const_cast<TerrainCell *>(c)->lastUse.store(now, std::memory_order_relaxed);
+    }
+    lastIndex = index;
+    last = c;
+    return c;
+}
+
+float TerrainTileCache::Reader::elevation(double lat, double lon)
+{
+    const TerrainCell *c = cellAt(lat, lon);
+    return c ? c->nearest(lat, lon) : std::numeric_limits<float>::quiet_NaN();
+}
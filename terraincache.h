@@ -0,0 +1,139 @@
+#ifndef TERRAINCACHE_H
+#define TERRAINCACHE_H
+
+#include <QString>
+#include <QMutex>
+#include <QStringList>
+#include <atomic>
+#include <memory>
+#include <vector>
+#include <limits>
+#include "terrainsampler.h"
+
+class QFile;
+
+// Bellekte eşlenmiş tek bir 1°x1° DTED hücresi. Izgara karolu int16'dır
+// (terrainsampler.h): satır 0 kuzey kenarı, sütun 0 batı kenarı; kenarlar dahildir.
+struct TerrainCell {
+    Terrain::GridView grid;
+
+    static constexpr qint16 Void = Terrain::Void;
+
+    // En yakın nokta (m); boşluk ise NaN
+    float nearest(double lat, double lon) const;
+
+    // --- önbellek iç durumu ---
+    std::unique_ptr<QFile> file;
+    uchar *mapping{nullptr};
+    qint64 bytes{0};
+    std::atomic<quint32> lastUse{0};
+    ~TerrainCell();
+};
+
+// DTED-0/1/2 hücrelerinin bellek eşlemli int16 ızgara önbelleği.
+//
+// addFile() yalnızca UHL başlığını okur. Hücre ilk sorgulandığında DTED bir kez
+// yerel int16 ızgara dosyasına (cacheDirectory altında) açılır ve QFile::map ile
+// eşlenir; sonraki yüklemeler yalnızca mmap'tir. Eşlenen toplam boyut bütçeyi
+// (MB) aşınca en uzun süredir kullanılmayan hücreler çıkarılır.
+//
+// Okuma kilitsizdir: her worker bir Reader açar; hücre tablosu atomik işaretçilerdir
+// ve çıkarılan hücreler, onları görmüş olabilecek tüm Reader'lar kapanana kadar
+// (iki fazlı epoch) serbest bırakılmaz. Çıkarma beklemez: hücre bekleme listesine
+// alınır ve epoch eski fazın okuyucuları boşaldıkça ilerledikçe sonraki ıska,
+// ekleme ya da Reader kapanışında serbest bırakılır. Kilit yalnızca ıska (hücre
+// yükleme) ve ekleme/çıkarma sırasında alınır. Uzun açık kalan bir Reader yalnızca
+// belleğin geri verilmesini geciktirir; yine de Reader'ı iş parçası kapsamında açın.
+class TerrainTileCache
+{
+public:
+    explicit TerrainTileCache(const QString &cacheDirectory = QString());
+    ~TerrainTileCache();
+
+    TerrainTileCache(const TerrainTileCache &) = delete;
+    TerrainTileCache &operator=(const TerrainTileCache &) = delete;
+
+    // DTED dosyasını kaydeder (aynı hücre için daha yüksek çözünürlük kazanır)
+    bool addFile(const QString &path, QString *errorString = nullptr);
+    void clear();
+    QStringList files() const;
+
+    void setBudgetMB(int megabytes);
+    int budgetMB() const { return static_cast<int>(budgetBytes.load() >> 20); }
+    qint64 mappedBytes() const { return residentBytes.load(); }
+    QString cacheDirectory() const { return cacheDir; }
+
+    // Bir worker thread'in okuma oturumu (kopyalanamaz, thread'ler arası paylaşılmaz)
+    class Reader
+    {
+    public:
+        explicit Reader(TerrainTileCache &cache);
+        ~Reader();
+        Reader(const Reader &) = delete;
+        Reader &operator=(const Reader &) = delete;
+
+        // Noktayı içeren hücre; veri yoksa nullptr. İşaretçi aynı Reader'daki bir
+        // sonraki cellAt/elevation çağrısına kadar geçerlidir (ıska epoch'tan çıkartır).
+        const TerrainCell *cellAt(double lat, double lon);
+        // En yakın DTED noktası (m); veri yoksa NaN
+        float elevation(double lat, double lon);
+
+    private:
+        TerrainTileCache &cache;
+        int parity{0};
+        int lastIndex{-1};
+        const TerrainCell *last{nullptr};
+    };
+
+    // Tek sorgu kolaylığı (her çağrıda Reader açar; döngülerde Reader kullanın)
+    float elevation(double lat, double lon);
+
+    static int cellIndex(double lat, double lon);
+
+private:
+    struct Source {
+        QString path;
+        int latIntervalTenthArcSec{0};   // küçük = daha ince
+    };
+
+    static constexpr int kCells = 180 * 360;
+
+    int enterRead();
+    void leaveRead(int parity);
+    // Bir önceki fazda okuyucu kalmadıysa epoch'u ilerletir (beklemez)
+    bool tryAdvance();
+
+    // Iskada: kilit altında yükler ve yayımlar (çağıran Reader epoch dışındadır)
+    const TerrainCell *load(int index);
+    std::unique_ptr<TerrainCell> mapCell(const Source &source, QString *errorString) const;
+    QString gridPathFor(const QString &sourcePath) const;
+    // Bütçeye sığmak için LRU hücreleri çıkarır (kilit altında)
+    void evictFor(qint64 incomingBytes);
+    // Hücreleri bekleme listesine alır; reclaim() epoch'u iki ilerlemişleri siler (kilit altında)
+    void retire(std::vector<TerrainCell *> &victims);
+    void reclaim(bool force = false);
+
+    QString cacheDir;
+    std::unique_ptr<std::atomic<TerrainCell *>[]> cells;
+    std::unique_ptr<std::atomic<bool>[]> hasSource;
+
+    mutable QMutex writeMutex;
+    std::vector<Source> sources;      // kCells, writeMutex altında
+    std::vector<int> loaded;          // eşlenmiş hücre indeksleri, writeMutex altında
+    struct Retired {
+        TerrainCell *cell;
+        quint64 epoch;                // tablodan kaldırıldığı epoch
+    };
+    std::vector<Retired> pending;     // writeMutex altında
+    std::atomic<int> pendingCount{0};
+
+    std::atomic<qint64> budgetBytes{qint64(512) << 20};
+    std::atomic<qint64> residentBytes{0};
+    std::atomic<quint32> useClock{1};
+
+    // İki fazlı okuma epoch'u
+    std::atomic<quint64> epoch{0};
+    std::atomic<int> activeReaders[2];
+};
+
+#endif // TERRAINCACHE_H
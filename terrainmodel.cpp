@@ -0,0 +1,99 @@
+#include "terrainmodel.h"
+#include "geo.h"
+
+namespace {
+
+// Girdi boylamı sarılmamışsa (ör. 181°) hücre görünümünü aynı dünyaya kaydır
+Terrain::GridView viewFor(const TerrainCell &cell, double lon)
+{
+    Terrain::GridView g = cell.grid;
+    g.west += lon - Geo::wrapLon(lon);
+    return g;
+}
+
+} // namespace
+
+TerrainModel::TerrainModel(std::shared_ptr<TerrainTileCache> cache)
+    : tiles(std::move(cache))
+{
+}
+
+double TerrainModel::heightAt(double lat, double lon) const
+{
+    TerrainTileCache::Reader reader(*tiles);
+    return heightAt(reader, lat, lon);
+}
+
+void TerrainModel::heightsAlong(const double *lat, const double *lon, double *out, std::size_t count) const
+{
+    TerrainTileCache::Reader reader(*tiles);
+    heightsAlong(reader, lat, lon, out, count);
+}
+
+double TerrainModel::heightAt(TerrainTileCache::Reader &reader, double lat, double lon)
+{
+    const TerrainCell *cell = reader.cellAt(lat, lon);
+    return cell ? Terrain::bilinear(viewFor(*cell, lon), lat, lon) : 0.0;
+}
+
+void TerrainModel::heightsAlong(TerrainTileCache::Reader &reader,
+                                const double *lat, const double *lon, double *out, std::size_t count)
+{
+    std::size_t i = 0;
+    while (i < count) {
+        const TerrainCell *cell = reader.cellAt(lat[i], lon[i]);
+        if (!cell) {
+            out[i++] = 0.0;
+            continue;
+        }
+        // Hücre kutusunda kalan ardışık noktalar tek toplu çağrıya gider
+        const Terrain::GridView g = viewFor(*cell, lon[i]);
+        const double south = g.north - (g.rows - 1) * g.latStep;
+        const double east = g.west + (g.cols - 1) * g.lonStep;
+        std::size_t j = i + 1;
+        while (j < count && lat[j] >= south && lat[j] <= g.north && lon[j] >= g.west && lon[j] <= east) ++j;
+        Terrain::bilinearBatch(g, lat + i, lon + i, out + i, j - i);
+        i = j;
+    }
+}
+
+void TerrainModel::heightsOnArc(TerrainTileCache::Reader &reader, const Terrain::Arc &arc, float *out, std::size_t count)
+{
+    std::size_t i = 0;
+    while (i < count) {
+        const double lon = arc.lonAt(double(i));
+        const TerrainCell *cell = reader.cellAt(arc.latAt(double(i)), lon);
+        if (!cell) {
+            out[i++] = 0.0f;
+            continue;
+        }
+        const Terrain::GridView g = viewFor(*cell, lon);
+        const double south = g.north - (g.rows - 1) * g.latStep;
+        const double east = g.west + (g.cols - 1) * g.lonStep;
+        auto inside = [&](std::size_t j) {
+            const double la = arc.latAt(double(j)), lo = arc.lonAt(double(j));
+            return la >= south && la <= g.north && lo >= g.west && lo <= east;
+        };
+        // Kısa yay hücreden bir kez çıkar: içerideki önek ikili aramayla bulunur
+        std::size_t lo = i, hi = count;
+        if (inside(count - 1)) lo = count - 1;
+        while (hi - lo > 1) {
+            const std::size_t mid = lo + (hi - lo) / 2;
+            (inside(mid) ? lo : hi) = mid;
+        }
+        Terrain::bilinearArc(g, arc.from(double(i)), out + i, hi - i);
+        i = hi;
+    }
+}
+
+float TerrainModel::ceilingOnArc(TerrainTileCache::Reader &reader, const Terrain::Arc &arc, std::size_t count)
+{
+    double latMin, latMax, lonMin, lonMax;
+    arc.bounds(count, latMin, latMax, lonMin, lonMax);
+    if (TerrainTileCache::cellIndex(latMin, lonMin) != TerrainTileCache::cellIndex(latMax, lonMax))
+        return std::numeric_limits<float>::infinity();
+    const TerrainCell *cell = reader.cellAt(arc.lat, arc.lon);
+    // Veri yok: örnekler 0 m
+    if (!cell) return 0.0f;
+    return Terrain::ceilingAlongArc(viewFor(*cell, arc.lon), arc, count);
+}
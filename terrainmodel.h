@@ -0,0 +1,40 @@
+#ifndef TERRAINMODEL_H
+#define TERRAINMODEL_H
+
+#include <cstddef>
+#include <memory>
+#include "terraincache.h"
+
+// Arazi yüksekliği sorguları (m, WGS84 enlem/boylam derece). DTED noktaları
+// arasında çift doğrusal enterpolasyon yapılır; veri olmayan yerler (kayıtlı hücre
+// yok ya da boşluk) 0 m (deniz seviyesi) döner.
+//
+// heightsAlong bir yol üzerindeki ardışık noktaları hücre sınırlarında parçalara
+// ayırır ve her parçayı Terrain::bilinearBatch ile toplu örnekler; hücre sınırı
+// geçişi ek maliyet getirmez (kenar noktaları iki hücrede de vardır). Radyal
+// yollar (LOS, kapsama, PE profili) heightsOnArc kullanır: yay hücre sınırlarında
+// ikili aramayla bölünür, parçalar Terrain::bilinearArc ile float örneklenir.
+// Worker thread'ler önbelleğe tek tek değil, kendi Reader'ları üzerinden erişmelidir.
+class TerrainModel
+{
+public:
+    explicit TerrainModel(std::shared_ptr<TerrainTileCache> cache);
+
+    double heightAt(double lat, double lon) const;
+    void heightsAlong(const double *lat, const double *lon, double *out, std::size_t count) const;
+
+    static double heightAt(TerrainTileCache::Reader &reader, double lat, double lon);
+    static void heightsAlong(TerrainTileCache::Reader &reader,
+                             const double *lat, const double *lon, double *out, std::size_t count);
+    static void heightsOnArc(TerrainTileCache::Reader &reader, const Terrain::Arc &arc, float *out, std::size_t count);
+    // Yayın ilk count örneği altındaki arazinin üst sınırı (karo en yükseği); yay
+    // birden çok hücreye yayılıyorsa +sonsuz
+    static float ceilingOnArc(TerrainTileCache::Reader &reader, const Terrain::Arc &arc, std::size_t count);
+
+    const std::shared_ptr<TerrainTileCache> &cache() const { return tiles; }
+
+private:
+    std::shared_ptr<TerrainTileCache> tiles;
+};
+
+#endif // TERRAINMODEL_H
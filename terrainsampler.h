@@ -0,0 +1,283 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+#include "geo.h"
+
+// Qt'siz arazi örnekleme çekirdekleri (TerrainModel ve bench ortak kullanır).
+namespace Terrain {
+
+    // Izgara 64x64'lük karolar halinde saklanır; her karo bir satır/sütun taşmayla
+    // (apron) 65x65'tir. Böylece herhangi bir (r,c) için 2x2 komşuluk tek karodadır
+    // ve (c, c+1) bellekte bitişiktir. Radyal yollarda satır-öncelikli düzende her
+    // satır yeni bir sayfadır (DTED-2'de 7.2 KB); karolu düzende yol birkaç karoda kalır.
+    static constexpr int kTileShift = 6;
+    static constexpr int kTile = 1 << kTileShift;
+    static constexpr int kTileStride = kTile + 1;
+    static constexpr int kTilePosts = kTileStride * kTileStride;
+
+    inline int tilesFor(int posts) { return (posts - 2) / kTile + 1; }
+
+    // Tek bir hücrenin ızgarası: satır 0 kuzey, sütun 0 batı, kenarlar dahil
+    struct GridView {
+        const std::int16_t *posts{nullptr};
+        int rows{0};
+        int cols{0};
+        int tilesX{0};
+        double north{0.0};
+        double west{0.0};
+        double latStep{1.0};
+        double lonStep{1.0};
+        const std::int16_t *tileMax{nullptr};   // karo başına en yüksek nokta (yoksa sınır bilinmez)
+    };
+
+    static constexpr std::int16_t Void = INT16_MIN;   // boşluklar 0 m kabul edilir
+
+    // (r,c) noktasının karolu dizideki yeri; r <= rows-1, c <= cols-1
+    inline std::size_t postIndex(int tilesX, int r, int c)
+    {
+        // Son satır/sütun bir önceki karonun apron'undadır
+        const int tr = std::max(0, (r - (r > 0 ? 1 : 0)) >> kTileShift);
+        const int tc = std::max(0, (c - (c > 0 ? 1 : 0)) >> kTileShift);
+        const std::size_t tile = std::size_t(tr) * tilesX + tc;
+        return (tile * kTileStride + (r - (tr << kTileShift))) * kTileStride + (c - (tc << kTileShift));
+    }
+
+    // Satır-öncelikli ızgarayı karolu düzene çevirir (kenar karolar son satır/sütunu tekrarlar)
+    inline void tileGrid(const std::int16_t *rowMajor, int rows, int cols, std::vector<std::int16_t> &out)
+    {
+        const int tilesY = tilesFor(rows), tilesX = tilesFor(cols);
+        out.resize(std::size_t(tilesY) * tilesX * kTilePosts);
+        std::int16_t *o = out.data();
+        for (int ty = 0; ty < tilesY; ++ty)
+            for (int tx = 0; tx < tilesX; ++tx)
+                for (int i = 0; i < kTileStride; ++i) {
+                    const std::int16_t *src = rowMajor + std::size_t(std::min(ty * kTile + i, rows - 1)) * cols;
+                    for (int j = 0; j < kTileStride; ++j) *o++ = src[std::min(tx * kTile + j, cols - 1)];
+                }
+    }
+
+    inline float postValue(std::int16_t v) { return v == Void ? 0.0f : float(v); }
+
+    // Karolu ızgaranın karo başına en yüksek noktası (apron dahil, boşluk 0 m)
+    inline void tileMaxima(const std::vector<std::int16_t> &tiled, std::vector<std::int16_t> &out)
+    {
+        out.resize(tiled.size() / kTilePosts);
+        for (std::size_t t = 0; t < out.size(); ++t) {
+            const std::int16_t *p = tiled.data() + t * kTilePosts;
+            int m = INT16_MIN + 1;
+            for (int i = 0; i < kTilePosts; ++i) m = std::max(m, p[i] == Void ? 0 : int(p[i]));
+            out[t] = static_cast<std::int16_t>(m);
+        }
+    }
+
+    // Tek nokta çift doğrusal (hücre dışı koordinatlar kenara kırpılır)
+    inline double bilinear(const GridView &g, double lat, double lon)
+    {
+        const double y = std::clamp((g.north - lat) / g.latStep, 0.0, double(g.rows - 1));
+        const double x = std::clamp((lon - g.west) / g.lonStep, 0.0, double(g.cols - 1));
+        const int r = std::min(static_cast<int>(y), g.rows - 2);
+        const int c = std::min(static_cast<int>(x), g.cols - 2);
+        const float fy = static_cast<float>(y - r), fx = static_cast<float>(x - c);
+        const std::int16_t *p = g.posts
+            + (std::size_t((r >> kTileShift) * g.tilesX + (c >> kTileShift)) * kTileStride
+               + (r & (kTile - 1))) * kTileStride + (c & (kTile - 1));
+        const float top = postValue(p[0]) + fx * (postValue(p[1]) - postValue(p[0]));
+        const float bot = postValue(p[kTileStride]) + fx * (postValue(p[kTileStride + 1]) - postValue(p[kTileStride]));
+        return top + fy * (bot - top);
+    }
+
+    // Çift doğrusal, toplu (rastgele noktalar)
+    inline void bilinearBatch(const GridView &g,
+                              const double *GEO_RESTRICT lat,
+                              const double *GEO_RESTRICT lon,
+                              double *GEO_RESTRICT out,
+                              std::size_t count)
+    {
+        for (std::size_t i = 0; i < count; ++i) out[i] = bilinear(g, lat[i], lon[i]);
+    }
+
+    // Yol örnekleri: j. örnek (lat + j*dLat + j^2*ddLat, lon + j*dLon + j^2*ddLon).
+    // Kısa büyük daire yayları (Los::Path parçaları) bu biçimdedir.
+    struct Arc {
+        double lat{0.0}, lon{0.0};
+        double dLat{0.0}, dLon{0.0};
+        double ddLat{0.0}, ddLon{0.0};
+
+        double latAt(double j) const { return lat + j * (dLat + j * ddLat); }
+        double lonAt(double j) const { return lon + j * (dLon + j * ddLon); }
+        // k. örnekten başlayan aynı yay
+        Arc from(double k) const
+        {
+            return {latAt(k), lonAt(k), dLat + 2.0 * k * ddLat, dLon + 2.0 * k * ddLon, ddLat, ddLon};
+        }
+        // İlk count örneğini kapsayan kutu: uçlar, ikinci dereceden terimin kirişten
+        // en büyük sapması (|dd| n^2 / 4) kadar genişletilir
+        void bounds(std::size_t count, double &latMin, double &latMax, double &lonMin, double &lonMax) const
+        {
+            const double n = count > 0 ? double(count - 1) : 0.0;
+            auto range = [n](double v0, double vn, double dd, double &lo, double &hi) {
+                const double bow = 0.25 * std::fabs(dd) * n * n;
+                lo = std::min(v0, vn) - bow;
+                hi = std::max(v0, vn) + bow;
+            };
+            range(lat, latAt(n), ddLat, latMin, latMax);
+            range(lon, lonAt(n), ddLon, lonMin, lonMax);
+        }
+    };
+
+    // Yayın ilk count örneği altındaki arazinin üst sınırı (m): kutuyu kapsayan
+    // karoların en yükseği. Kutu ızgaradan taşıyorsa ya da tileMax yoksa +sonsuz.
+    inline float ceilingAlongArc(const GridView &g, const Arc &arc, std::size_t count)
+    {
+        constexpr float kNone = std::numeric_limits<float>::infinity();
+        if (!g.tileMax || count == 0) return kNone;
+        double latMin, latMax, lonMin, lonMax;
+        arc.bounds(count, latMin, latMax, lonMin, lonMax);
+        const double invLat = 1.0 / g.latStep, invLon = 1.0 / g.lonStep;
+        const double y0 = (g.north - latMax) * invLat, y1 = (g.north - latMin) * invLat;
+        const double x0 = (lonMin - g.west) * invLon, x1 = (lonMax - g.west) * invLon;
+        if (y0 < 0.0 || x0 < 0.0 || y1 > double(g.rows - 1) || x1 > double(g.cols - 1)) return kNone;
+        // bilinear'ın seçtiği karolar: r = min(y, rows-2) >> kTileShift
+        const int tr0 = std::min(int(y0), g.rows - 2) >> kTileShift, tr1 = std::min(int(y1), g.rows - 2) >> kTileShift;
+        const int tc0 = std::min(int(x0), g.cols - 2) >> kTileShift, tc1 = std::min(int(x1), g.cols - 2) >> kTileShift;
+        int m = INT16_MIN;
+        for (int tr = tr0; tr <= tr1; ++tr)
+            for (int tc = tc0; tc <= tc1; ++tc) m = std::max(m, int(g.tileMax[std::size_t(tr) * g.tilesX + tc]));
+        return float(m);
+    }
+
+    // Yay boyunca çift doğrusal, float çıkış. Satır/sütun konumu 32.32 sabit noktada
+    // artımlı ilerler: p(j) = p0 + j*v + j^2*a tam sayıda, örnek başına bölme ya da
+    // double dönüşümü yok. AVX2'de 8 örnek birlikte (iki 4 x int64 vektör; 8 örnek
+    // ötesinin farkı 8v + (16j + 64)a, ikinci fark 128a), posts 32-bit gather ile
+    // okunur: (c, c+1) bitişik olduğundan 8 örneğe 2 gather yeter. v ve a'nın
+    // yuvarlaması 4096 örnekte 2e-3 nokta konum hatası verir. Izgara dışına taşan
+    // örnekler kenara kırpılır; çağıran yolu hücre sınırlarında böler.
+    inline void bilinearArc(const GridView &g, const Arc &arc, float *GEO_RESTRICT out, std::size_t count)
+    {
+        constexpr double kOne = 4294967296.0;   // 2^32
+        const double sy = -kOne / g.latStep, sx = kOne / g.lonStep;
+        const std::int64_t maxY = std::int64_t(g.rows - 1) << 32, maxX = std::int64_t(g.cols - 1) << 32;
+        auto fixedY = [&](double lat) { return std::llround(std::clamp((g.north - lat) / g.latStep, -1.0, double(g.rows)) * kOne); };
+        auto fixedX = [&](double lon) { return std::llround(std::clamp((lon - g.west) / g.lonStep, -1.0, double(g.cols)) * kOne); };
+
+        std::size_t k = 0;
+#if defined(__AVX2__)
+        if (count >= 8) {
+            const std::int64_t y0 = fixedY(arc.lat), x0 = fixedX(arc.lon);
+            const std::int64_t vy = std::llround(arc.dLat * sy), vx = std::llround(arc.dLon * sx);
+            const std::int64_t ay = std::llround(arc.ddLat * sy), ax = std::llround(arc.ddLon * sx);
+            alignas(32) std::int64_t Y[8], X[8], DY[8], DX[8];
+            for (std::int64_t j = 0; j < 8; ++j) {
+                Y[j] = y0 + j * vy + j * j * ay;
+                X[j] = x0 + j * vx + j * j * ax;
+                DY[j] = 8 * vy + (16 * j + 64) * ay;
+                DX[j] = 8 * vx + (16 * j + 64) * ax;
+            }
+            auto load = [](const std::int64_t *p) { return _mm256_load_si256(reinterpret_cast<const __m256i *>(p)); };
+            __m256i y0v = load(Y), y1v = load(Y + 4), x0v = load(X), x1v = load(X + 4);
+            __m256i dy0 = load(DY), dy1 = load(DY + 4), dx0 = load(DX), dx1 = load(DX + 4);
+            const __m256i ddy = _mm256_set1_epi64x(128 * ay), ddx = _mm256_set1_epi64x(128 * ax);
+            const __m256i vZero = _mm256_setzero_si256();
+            const __m256i vMaxY = _mm256_set1_epi64x(maxY), vMaxX = _mm256_set1_epi64x(maxX);
+            const __m256i vLastR = _mm256_set1_epi32(g.rows - 2), vLastC = _mm256_set1_epi32(g.cols - 2);
+            const __m256i vMask = _mm256_set1_epi32(kTile - 1);
+            const __m256i vStride = _mm256_set1_epi32(kTileStride);
+            const __m256i vTilePosts = _mm256_set1_epi32(kTilePosts);
+            const __m256i vTilesX = _mm256_set1_epi32(g.tilesX);
+            const __m256i vVoid = _mm256_set1_epi32(Void);
+            const __m256 vFrac = _mm256_set1_ps(1.0f / 2147483648.0f);
+            const int *base32 = reinterpret_cast<const int *>(g.posts);
+
+            auto clamp64 = [&](__m256i v, __m256i hi) {
+                v = _mm256_blendv_epi8(v, vZero, _mm256_cmpgt_epi64(vZero, v));
+                return _mm256_blendv_epi8(v, hi, _mm256_cmpgt_epi64(v, hi));
+            };
+            // İki 4 x int64'ün yüksek (tam) ya da düşük (kesir) yarıları, örnek sırasında 8 x int32
+            auto halves = [](__m256i a, __m256i b, bool high) {
+                const __m256 s = high
+                    ? _mm256_shuffle_ps(_mm256_castsi256_ps(a), _mm256_castsi256_ps(b), _MM_SHUFFLE(3, 1, 3, 1))
+                    : _mm256_shuffle_ps(_mm256_castsi256_ps(a), _mm256_castsi256_ps(b), _MM_SHUFFLE(2, 0, 2, 0));
+                return _mm256_permute4x64_epi64(_mm256_castps_si256(s), _MM_SHUFFLE(3, 1, 2, 0));
+            };
+            // Kesir: düşük yarının üst 31 biti; kırpılan son satır/sütunda +1
+            auto fraction = [&](__m256i lo, __m256i whole, __m256i clipped) {
+                return _mm256_add_ps(_mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_srli_epi32(lo, 1)), vFrac),
+                                     _mm256_cvtepi32_ps(_mm256_sub_epi32(whole, clipped)));
+            };
+
+            for (; k + 8 <= count; k += 8) {
+                const __m256i cy0 = clamp64(y0v, vMaxY), cy1 = clamp64(y1v, vMaxY);
+                const __m256i cx0 = clamp64(x0v, vMaxX), cx1 = clamp64(x1v, vMaxX);
+                const __m256i wr = halves(cy0, cy1, true), wc = halves(cx0, cx1, true);
+                const __m256i r = _mm256_min_epi32(wr, vLastR), c = _mm256_min_epi32(wc, vLastC);
+                const __m256 fy = fraction(halves(cy0, cy1, false), wr, r);
+                const __m256 fx = fraction(halves(cx0, cx1, false), wc, c);
+
+                // ((tr * tilesX + tc) * 65 + (r & 63)) * 65 + (c & 63)
+                const __m256i tile = _mm256_add_epi32(_mm256_mullo_epi32(_mm256_srli_epi32(r, kTileShift), vTilesX),
+                                                      _mm256_srli_epi32(c, kTileShift));
+                const __m256i vi = _mm256_add_epi32(
+                    _mm256_mullo_epi32(tile, vTilePosts),
+                    _mm256_add_epi32(_mm256_mullo_epi32(_mm256_and_si256(r, vMask), vStride),
+                                     _mm256_and_si256(c, vMask)));
+
+                // Ölçek 2: adres = posts + idx*2 bayt; düşük 16 bit post[c], yüksek post[c+1]
+                const __m256i top = _mm256_i32gather_epi32(base32, vi, 2);
+                const __m256i bot = _mm256_i32gather_epi32(base32, _mm256_add_epi32(vi, vStride), 2);
+                __m256i h00 = _mm256_srai_epi32(_mm256_slli_epi32(top, 16), 16);
+                __m256i h01 = _mm256_srai_epi32(top, 16);
+                __m256i h10 = _mm256_srai_epi32(_mm256_slli_epi32(bot, 16), 16);
+                __m256i h11 = _mm256_srai_epi32(bot, 16);
+                h00 = _mm256_andnot_si256(_mm256_cmpeq_epi32(h00, vVoid), h00);
+                h01 = _mm256_andnot_si256(_mm256_cmpeq_epi32(h01, vVoid), h01);
+                h10 = _mm256_andnot_si256(_mm256_cmpeq_epi32(h10, vVoid), h10);
+                h11 = _mm256_andnot_si256(_mm256_cmpeq_epi32(h11, vVoid), h11);
+                const __m256 f00 = _mm256_cvtepi32_ps(h00), f01 = _mm256_cvtepi32_ps(h01);
+                const __m256 f10 = _mm256_cvtepi32_ps(h10), f11 = _mm256_cvtepi32_ps(h11);
+                const __m256 t = _mm256_fmadd_ps(fx, _mm256_sub_ps(f01, f00), f00);
+                const __m256 b = _mm256_fmadd_ps(fx, _mm256_sub_ps(f11, f10), f10);
+                _mm256_storeu_ps(out + k, _mm256_fmadd_ps(fy, _mm256_sub_ps(b, t), t));
+
+                y0v = _mm256_add_epi64(y0v, dy0); y1v = _mm256_add_epi64(y1v, dy1);
+                x0v = _mm256_add_epi64(x0v, dx0); x1v = _mm256_add_epi64(x1v, dx1);
+                dy0 = _mm256_add_epi64(dy0, ddy); dy1 = _mm256_add_epi64(dy1, ddy);
+                dx0 = _mm256_add_epi64(dx0, ddx); dx1 = _mm256_add_epi64(dx1, ddx);
+            }
+        }
+#endif
+        // Skaler: kalan örnekler (AVX2 yoksa hepsi); ilk fark v + (2j+1)a, ikinci 2a
+        const Arc tail = k ? arc.from(double(k)) : arc;
+        std::int64_t y = fixedY(tail.lat), x = fixedX(tail.lon);
+        std::int64_t dy = std::llround((tail.dLat + tail.ddLat) * sy), dx = std::llround((tail.dLon + tail.ddLon) * sx);
+        const std::int64_t ddy = std::llround(2.0 * tail.ddLat * sy), ddx = std::llround(2.0 * tail.ddLon * sx);
+        const std::size_t tilesX = std::size_t(g.tilesX);
+        // Kırpma sınırı son hücrenin içinde kalır: tam kısım en çok rows-2,
+        // kesir düşük 32 bit (kenarda 2^-32 nokta hata)
+        const std::int64_t lastY = maxY - 1, lastX = maxX - 1;
+        for (float *o = out + k, *end = out + count; o < end; ++o) {
+            const std::int64_t cy = std::clamp<std::int64_t>(y, 0, lastY), cx = std::clamp<std::int64_t>(x, 0, lastX);
+            const std::size_t r = std::size_t(cy >> 32), c = std::size_t(cx >> 32);
+            const float fy = float(std::uint32_t(cy)) * (1.0f / 4294967296.0f);
+            const float fx = float(std::uint32_t(cx)) * (1.0f / 4294967296.0f);
+            const std::int16_t *p = g.posts
+                + (((r >> kTileShift) * tilesX + (c >> kTileShift)) * kTileStride
+                   + (r & (kTile - 1))) * kTileStride + (c & (kTile - 1));
+            const float h00 = postValue(p[0]), h01 = postValue(p[1]);
+            const float h10 = postValue(p[kTileStride]), h11 = postValue(p[kTileStride + 1]);
+            const float top = h00 + fx * (h01 - h00);
+            const float bot = h10 + fx * (h11 - h10);
+            *o = top + fy * (bot - top);
+            y += dy; dy += ddy;
+            x += dx; dx += ddx;
+        }
+    }
+
+} // namespace Terrain
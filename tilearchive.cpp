@@ -0,0 +1,407 @@
+#include "tilearchive.h"
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonDocument>
+#include <QJsonArray>
+#include <QSqlDatabase>
+#include <QSqlQuery>
+#include <QSqlError>
+#include <QThreadStorage>
+#include <QMutexLocker>
+#include <QSet>
+#include <QDebug>
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <vector>
+#include <zlib.h>
+
+// Bir arşivin açık bağlantı adları. Bağlantıyı arşiv yıkıcısı ya da açan thread'in
+// bitişi kaldırır; hangisi önce kümeden silerse o.
+struct MBTilesConnections {
+    QMutex mutex;
+    QSet<QString> names;
+
+    bool release(const QString &name)
+    {
+        QMutexLocker locker(&mutex);
+        return names.remove(name);
+    }
+};
+
+namespace {
+
+TileArchive::Format formatFromName(const QString &name)
+{
+    const QString f = name.trimmed().toLower();
+    if (f == "pbf" || f == "mvt") return TileArchive::Format::Pbf;
+    if (f == "png") return TileArchive::Format::Png;
+    if (f == "jpg" || f == "jpeg") return TileArchive::Format::Jpeg;
+    if (f == "webp") return TileArchive::Format::Webp;
+    return TileArchive::Format::Unknown;
+}
+
+quint64 readLE64(const uchar *p)
+{
+    quint64 v = 0;
+    for (int i = 7; i >= 0; --i) v = (v << 8) | p[i];
+    return v;
+}
+
+qint32 readLE32(const uchar *p)
+{
+    return static_cast<qint32>(quint32(p[0]) | (quint32(p[1]) << 8) | (quint32(p[2]) << 16) | (quint32(p[3]) << 24));
+}
+
+bool readVarint(const uchar *&p, const uchar *end, quint64 &out)
+{
+    out = 0;
+    for (int shift = 0; shift < 64 && p < end; shift += 7) {
+        const uchar b = *p++;
+        out |= quint64(b & 0x7f) << shift;
+        if (!(b & 0x80)) return true;
+    }
+    return false;
+}
+
+// Thread'in açtığı MBTiles bağlantıları; QThreadStorage thread bitince siler
+struct ThreadConnections {
+    struct Open {
+        std::weak_ptr<MBTilesConnections> owner;
+        QString name;
+    };
+    std::vector<Open> open;
+
+    ~ThreadConnections()
+    {
+        for (const Open &o : open) {
+            const std::shared_ptr<MBTilesConnections> owner = o.owner.lock();
+            if (owner && owner->release(o.name)) QSqlDatabase::removeDatabase(o.name);
+        }
+    }
+};
+
+QThreadStorage<ThreadConnections *> threadConnections;
+std::atomic<quint64> connectionSerial{0};
+
+// PMTiles sıkıştırma kodları
+constexpr quint8 kCompressionNone = 1;
+constexpr quint8 kCompressionGzip = 2;
+
+} // namespace
+
+QString TileArchive::contentType() const
+{
+    switch (tileFormat) {
+    case Format::Pbf: return QStringLiteral("application/x-protobuf");
+    case Format::Png: return QStringLiteral("image/png");
+    case Format::Jpeg: return QStringLiteral("image/jpeg");
+    case Format::Webp: return QStringLiteral("image/webp");
+    default: return QStringLiteral("application/octet-stream");
+    }
+}
+
+QByteArray TileArchive::inflateIfCompressed(const QByteArray &data)
+{
+    if (data.size() < 2) return data;
+    const uchar b0 = static_cast<uchar>(data[0]);
+    const uchar b1 = static_cast<uchar>(data[1]);
+    const bool gzip = (b0 == 0x1f && b1 == 0x8b);
+    const bool zlibHdr = (b0 == 0x78 && (b0 * 256 + b1) % 31 == 0);
+    if (!gzip && !zlibHdr) return data;
+
+    z_stream zs;
+    std::memset(&zs, 0, sizeof(zs));
+    // 15 + 32: gzip ve zlib başlığını otomatik tanı
+    if (inflateInit2(&zs, 15 + 32) != Z_OK) return QByteArray();
+    zs.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(data.constData()));
+    zs.avail_in = static_cast<uInt>(data.size());
+
+    QByteArray out;
+    out.resize(data.size() * 4);
+    int ret = Z_OK;
+    while (ret == Z_OK) {
+        if (zs.total_out >= static_cast<uLong>(out.size())) out.resize(out.size() * 2);
+        zs.next_out = reinterpret_cast<Bytef *>(out.data() + zs.total_out);
+        zs.avail_out = static_cast<uInt>(out.size() - zs.total_out);
+        ret = inflate(&zs, Z_NO_FLUSH);
+    }
+    const uLong produced = zs.total_out;
+    inflateEnd(&zs);
+    if (ret != Z_STREAM_END) return QByteArray();
+    out.resize(static_cast<int>(produced));
+    return out;
+}
+
+std::unique_ptr<TileArchive> TileArchive::open(const QString &path, QString *errorString)
+{
+    const QString suffix = QFileInfo(path).suffix().toLower();
+    if (suffix == "mbtiles") {
+        auto a = std::make_unique<MBTilesArchive>();
+        if (a->load(path, errorString)) return a;
+    } else if (suffix == "pmtiles") {
+        auto a = std::make_unique<PMTilesArchive>();
+        if (a->load(path, errorString)) return a;
+    } else if (errorString) {
+        *errorString = QString("Unsupported tile archive: %1").arg(path);
+    }
+    return nullptr;
+}
+
+// ---------------------------------------------------------------- MBTiles
+
+MBTilesArchive::MBTilesArchive()
+    : connections(std::make_shared<MBTilesConnections>())
+{
+}
+
+MBTilesArchive::~MBTilesArchive()
+{
+    QSet<QString> names;
+    {
+        QMutexLocker locker(&connections->mutex);
+        names.swap(connections->names);
+    }
+    for (const QString &name : std::as_const(names)) QSqlDatabase::removeDatabase(name);
+}
+
+QString MBTilesArchive::connectionForCurrentThread()
+{
+    if (!threadConnections.hasLocalData()) threadConnections.setLocalData(new ThreadConnections);
+    std::vector<ThreadConnections::Open> &open = threadConnections.localData()->open;
+    // Kapanmış arşivlerin girdilerini at (bağlantıları yıkıcıda kaldırıldı)
+    open.erase(std::remove_if(open.begin(), open.end(),
+                              [](const ThreadConnections::Open &o) { return o.owner.expired(); }),
+               open.end());
+    for (const ThreadConnections::Open &o : open)
+        if (o.owner.lock() == connections) return o.name;
+
+    // Ad süreç boyunca tekil: thread id'si gibi yeniden kullanılmaz
+    const QString name = QString("mbtiles-%1").arg(connectionSerial.fetch_add(1) + 1);
+    QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", name);
+    db.setDatabaseName(filePath);
+    db.setConnectOptions("QSQLITE_OPEN_READONLY");
+    if (!db.open()) {
+        qDebug() << "MBTiles open failed:" << db.lastError().text();
+        QSqlDatabase::removeDatabase(name);
+        return QString();
+    }
+    // Sayfa önbelleği yerine dosyayı doğrudan eşle (256 MB'a kadar)
+    QSqlQuery(db).exec("PRAGMA mmap_size=268435456");
+    {
+        QMutexLocker locker(&connections->mutex);
+        connections->names.insert(name);
+    }
+    open.push_back(ThreadConnections::Open{connections, name});
+    return name;
+}
+
+bool MBTilesArchive::load(const QString &path, QString *errorString)
+{
+    filePath = path;
+    const QString conn = connectionForCurrentThread();
+    if (conn.isEmpty()) {
+        if (errorString) *errorString = QString("Cannot open MBTiles: %1").arg(path);
+        return false;
+    }
+    QSqlQuery q(QSqlDatabase::database(conn));
+    if (!q.exec("SELECT name, value FROM metadata")) {
+        if (errorString) *errorString = QString("Invalid MBTiles (no metadata): %1").arg(path);
+        return false;
+    }
+    while (q.next()) {
+        const QString name = q.value(0).toString();
+        const QString value = q.value(1).toString();
+        if (name == "format") tileFormat = formatFromName(value);
+        else if (name == "minzoom") zoomMin = value.toInt();
+        else if (name == "maxzoom") zoomMax = value.toInt();
+        else if (name == "bounds") {
+            const QStringList parts = value.split(',');
+            if (parts.size() == 4) for (int i = 0; i < 4; ++i) bbox[i] = parts[i].toDouble();
+        } else if (name == "json") {
+            const QJsonObject o = QJsonDocument::fromJson(value.toUtf8()).object();
+            for (auto it = o.begin(); it != o.end(); ++it) meta.insert(it.key(), it.value());
+        } else {
+            meta.insert(name, value);
+        }
+    }
+    if (tileFormat == Format::Unknown) tileFormat = Format::Pbf;
+    return true;
+}
+
+QByteArray MBTilesArchive::tile(int z, int x, int y)
+{
+    const QString conn = connectionForCurrentThread();
+    if (conn.isEmpty()) return QByteArray();
+    QSqlQuery q(QSqlDatabase::database(conn));
+    q.prepare("SELECT tile_data FROM tiles WHERE zoom_level=? AND tile_column=? AND tile_row=?");
+    q.addBindValue(z);
+    q.addBindValue(x);
+    q.addBindValue((1 << z) - 1 - y);   // MBTiles TMS şemasıdır (y güneyden)
+    if (!q.exec() || !q.next()) return QByteArray();
+    return inflateIfCompressed(q.value(0).toByteArray());
+}
+
+// ---------------------------------------------------------------- PMTiles
+
+PMTilesArchive::~PMTilesArchive()
+{
+    if (file && base) file->unmap(const_cast<uchar *>(base));
+}
+
+quint64 PMTilesArchive::zxyToTileId(int z, quint32 x, quint32 y)
+{
+    // 0..z-1 seviyelerindeki tile sayısı: (4^z - 1) / 3
+    const quint64 acc = ((quint64(1) << (2 * z)) - 1) / 3;
+    quint64 d = 0;
+    quint64 tx = x, ty = y;
+    for (quint64 s = (quint64(1) << z) >> 1; s > 0; s >>= 1) {
+        const quint64 rx = (tx & s) ? 1 : 0;
+        const quint64 ry = (ty & s) ? 1 : 0;
+        d += s * s * ((3 * rx) ^ ry);
+        if (ry == 0) {
+            if (rx == 1) {
+                tx = s - 1 - tx;
+                ty = s - 1 - ty;
+            }
+            std::swap(tx, ty);
+        }
+    }
+    return acc + d;
+}
+
+bool PMTilesArchive::load(const QString &path, QString *errorString)
+{
+    filePath = path;
+    file = std::make_unique<QFile>(path);
+    if (!file->open(QIODevice::ReadOnly)) {
+        if (errorString) *errorString = QString("Cannot open PMTiles: %1").arg(path);
+        return false;
+    }
+    fileSize = static_cast<quint64>(file->size());
+    base = file->map(0, file->size());
+    if (!base || fileSize < 127 || std::memcmp(base, "PMTiles", 7) != 0 || base[7] != 3) {
+        if (errorString) *errorString = QString("Not a PMTiles v3 archive: %1").arg(path);
+        return false;
+    }
+    const uchar *h = base;
+    rootOffset = readLE64(h + 8);
+    rootLength = readLE64(h + 16);
+    const quint64 metaOffset = readLE64(h + 24);
+    const quint64 metaLength = readLE64(h + 32);
+    leafOffset = readLE64(h + 40);
+    dataOffset = readLE64(h + 56);
+    internalCompression = h[97];
+    tileCompression = h[98];
+    switch (h[99]) {
+    case 1: tileFormat = Format::Pbf; break;
+    case 2: tileFormat = Format::Png; break;
+    case 3: tileFormat = Format::Jpeg; break;
+    case 4: tileFormat = Format::Webp; break;
+    default: tileFormat = Format::Unknown; break;
+    }
+    zoomMin = h[100];
+    zoomMax = h[101];
+    bbox[0] = readLE32(h + 102) / 1e7;
+    bbox[1] = readLE32(h + 106) / 1e7;
+    bbox[2] = readLE32(h + 110) / 1e7;
+    bbox[3] = readLE32(h + 114) / 1e7;
+
+    if (internalCompression != kCompressionNone && internalCompression != kCompressionGzip) {
+        if (errorString) *errorString = QString("Unsupported PMTiles directory compression %1").arg(internalCompression);
+        return false;
+    }
+    if (rootOffset + rootLength > fileSize || metaOffset + metaLength > fileSize) {
+        if (errorString) *errorString = QString("Truncated PMTiles archive: %1").arg(path);
+        return false;
+    }
+    if (metaLength > 0) {
+        meta = QJsonDocument::fromJson(decompressInternal(base + metaOffset, metaLength)).object();
+    }
+    return directoryAt(rootOffset, rootLength) != nullptr;
+}
+
+QByteArray PMTilesArchive::decompressInternal(const uchar *data, quint64 length) const
+{
+    const QByteArray raw = QByteArray::fromRawData(reinterpret_cast<const char *>(data), static_cast<int>(length));
+    if (internalCompression == kCompressionGzip) return inflateIfCompressed(raw);
+    return QByteArray(raw.constData(), raw.size());
+}
+
+std::shared_ptr<const PMTilesArchive::Directory> PMTilesArchive::directoryAt(quint64 offset, quint64 length)
+{
+    {
+        QMutexLocker locker(&directoryMutex);
+        auto it = directories.constFind(offset);
+        if (it != directories.constEnd()) return it.value();
+    }
+    if (offset + length > fileSize) return nullptr;
+
+    const QByteArray bytes = decompressInternal(base + offset, length);
+    const uchar *p = reinterpret_cast<const uchar *>(bytes.constData());
+    const uchar *end = p + bytes.size();
+    quint64 n = 0;
+    if (!readVarint(p, end, n)) return nullptr;
+
+    auto dir = std::make_shared<Directory>(static_cast<int>(n));
+    Directory &e = *dir;
+    quint64 v = 0, last = 0;
+    for (quint64 i = 0; i < n; ++i) {
+        if (!readVarint(p, end, v)) return nullptr;
+        last += v;
+        e[i].tileId = last;
+    }
+    for (quint64 i = 0; i < n; ++i) {
+        if (!readVarint(p, end, v)) return nullptr;
+        e[i].runLength = static_cast<quint32>(v);
+    }
+    for (quint64 i = 0; i < n; ++i) {
+        if (!readVarint(p, end, v)) return nullptr;
+        e[i].length = static_cast<quint32>(v);
+    }
+    for (quint64 i = 0; i < n; ++i) {
+        if (!readVarint(p, end, v)) return nullptr;
+        // 0: önceki girdinin hemen arkası
+        e[i].offset = (v == 0 && i > 0) ? e[i - 1].offset + e[i - 1].length : v - 1;
+    }
+
+    QMutexLocker locker(&directoryMutex);
+    // Çok büyük arşivlerde yaprak dizin önbelleğini sınırla (kök her zaman kalır)
+    if (directories.size() > 4096) {
+        auto root = directories.value(rootOffset);
+        directories.clear();
+        if (root) directories.insert(rootOffset, root);
+    }
+    directories.insert(offset, dir);
+    return dir;
+}
+
+QByteArray PMTilesArchive::tile(int z, int x, int y)
+{
+    if (z < zoomMin || z > zoomMax || x < 0 || y < 0 || x >= (1 << z) || y >= (1 << z)) return QByteArray();
+    const quint64 id = zxyToTileId(z, static_cast<quint32>(x), static_cast<quint32>(y));
+
+    quint64 dirOffset = rootOffset, dirLength = rootLength;
+    for (int depth = 0; depth < 4; ++depth) {
+        const auto dir = directoryAt(dirOffset, dirLength);
+        if (!dir || dir->isEmpty()) return QByteArray();
+        // tileId <= id olan son girdi
+        auto it = std::upper_bound(dir->cbegin(), dir->cend(), id,
+                                   [](quint64 v, const Entry &e) { return v < e.tileId; });
+        if (it == dir->cbegin()) return QByteArray();
+        const Entry &e = *(it - 1);
+        if (e.runLength == 0) {
+            // Yaprak dizine in
+            dirOffset = leafOffset + e.offset;
+            dirLength = e.length;
+            continue;
+        }
+        if (id >= e.tileId + e.runLength) return QByteArray();
+        const quint64 off = dataOffset + e.offset;
+        if (off + e.length > fileSize) return QByteArray();
+        const QByteArray raw = QByteArray::fromRawData(reinterpret_cast<const char *>(base + off), static_cast<int>(e.length));
+        if (tileCompression == kCompressionGzip) return inflateIfCompressed(raw);
+        return QByteArray(raw.constData(), raw.size());
+    }
+    return QByteArray();
+}
@@ -0,0 +1,111 @@
+#ifndef TILEARCHIVE_H
+#define TILEARCHIVE_H
+
+#include <QString>
+#include <QByteArray>
+#include <QJsonObject>
+#include <QHash>
+#include <QMutex>
+#include <QVector>
+#include <memory>
+
+class QFile;
+struct MBTilesConnections;
+
+// Diskteki tek bir tile arşivi (MBTiles ya da PMTiles v3).
+// tile() thread-safe'tir; dönen veri sıkıştırılmamış ham tile'dır (pbf/png/jpg/webp).
+class TileArchive
+{
+public:
+    enum class Format { Unknown, Pbf, Png, Jpeg, Webp };
+
+    virtual ~TileArchive() = default;
+
+    // Uzantıya göre uygun arşivi açar; başarısızsa nullptr
+    static std::unique_ptr<TileArchive> open(const QString &path, QString *errorString = nullptr);
+
+    // z/x/y (XYZ şeması, y kuzeyden güneye); yoksa boş QByteArray
+    virtual QByteArray tile(int z, int x, int y) = 0;
+
+    Format format() const { return tileFormat; }
+    bool isVector() const { return tileFormat == Format::Pbf; }
+    QString contentType() const;
+    int minZoom() const { return zoomMin; }
+    int maxZoom() const { return zoomMax; }
+    // [minLon, minLat, maxLon, maxLat]
+    const double *bounds() const { return bbox; }
+    // vector_layers vb. (TileJSON'a benzer metadata)
+    QJsonObject metadata() const { return meta; }
+    QString path() const { return filePath; }
+
+    // gzip/zlib ile sıkıştırılmışsa açar, değilse olduğu gibi döndürür
+    static QByteArray inflateIfCompressed(const QByteArray &data);
+
+protected:
+    QString filePath;
+    Format tileFormat{Format::Unknown};
+    int zoomMin{0};
+    int zoomMax{14};
+    double bbox[4]{-180.0, -85.0511, 180.0, 85.0511};
+    QJsonObject meta;
+};
+
+// SQLite tabanlı MBTiles. SQLite'ın kendi mmap'i (PRAGMA mmap_size) kullanılır;
+// QSqlDatabase bağlantıları thread'e bağlı olduğundan her thread kendi bağlantısını
+// açar. Bağlantı QThreadStorage'da tutulur ve thread bitince kaldırılır (havuz
+// thread'leri sona erip OS id'leri yeniden kullanılsa da ölü thread'in bağlantısı
+// verilmez).
+class MBTilesArchive : public TileArchive
+{
+public:
+    MBTilesArchive();
+    ~MBTilesArchive() override;
+    bool load(const QString &path, QString *errorString);
+    QByteArray tile(int z, int x, int y) override;
+
+private:
+    QString connectionForCurrentThread();
+
+    std::shared_ptr<MBTilesConnections> connections;   // açık bağlantı adları (thread'lerle paylaşılır)
+};
+
+// PMTiles v3: tüm dosya salt-okunur eşlenir (QFile::map), dizinler gerektiğinde
+// açılıp önbelleklenir. Tile baytları ara okuma tamponu olmadan mmap
+// bölgesinden alınır; dönen QByteArray kendi kopyasıdır (sıkıştırılmışsa açılmış
+// hali), arşiv kapandıktan sonra da geçerli kalır.
+class PMTilesArchive : public TileArchive
+{
+public:
+    ~PMTilesArchive() override;
+    bool load(const QString &path, QString *errorString);
+    QByteArray tile(int z, int x, int y) override;
+
+    // Hilbert eğrisi üzerinde z/x/y -> tile id (PMTiles spesifikasyonu)
+    static quint64 zxyToTileId(int z, quint32 x, quint32 y);
+
+private:
+    struct Entry {
+        quint64 tileId{0};
+        quint64 offset{0};
+        quint32 length{0};
+        quint32 runLength{0};
+    };
+    using Directory = QVector<Entry>;
+
+    std::shared_ptr<const Directory> directoryAt(quint64 offset, quint64 length);
+    QByteArray decompressInternal(const uchar *data, quint64 length) const;
+
+    std::unique_ptr<QFile> file;
+    const uchar *base{nullptr};
+    quint64 fileSize{0};
+    quint64 rootOffset{0}, rootLength{0};
+    quint64 leafOffset{0};
+    quint64 dataOffset{0};
+    quint8 internalCompression{0};
+    quint8 tileCompression{0};
+
+    QMutex directoryMutex;
+    QHash<quint64, std::shared_ptr<const Directory>> directories;   // offset -> dizin
+};
+
+#endif // TILEARCHIVE_H
@@ -0,0 +1,220 @@
+#include "tileprovider.h"
+#include <QFile>
+#include <QFileInfo>
+#include <QDir>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonArray>
+#include <QMutexLocker>
+#include <QThread>
+#include <QDebug>
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+constexpr int kDefaultCacheMB = 256;
+// Boş (arşivde olmayan) tile'lar da önbelleklenir; tekrar tekrar SQLite'a gitmesin
+constexpr qint64 kEmptyTileCost = 64;
+
+int lonToTileX(double lon, int z)
+{
+    const int n = 1 << z;
+    const int x = static_cast<int>(std::floor((lon + 180.0) / 360.0 * n));
+    return std::clamp(x, 0, n - 1);
+}
+
+int latToTileY(double lat, int z)
+{
+    const int n = 1 << z;
+    const double la = std::clamp(lat, -85.0511, 85.0511) * M_PI / 180.0;
+    const int y = static_cast<int>(std::floor((1.0 - std::asinh(std::tan(la)) / M_PI) / 2.0 * n));
+    return std::clamp(y, 0, n - 1);
+}
+
+bool isWaterLayer(const QString &id)
+{
+    const QString s = id.toLower();
+    return s.contains("water") || s.contains("ocean") || s.contains("sea") || s.contains("lake");
+}
+
+} // namespace
+
+TileProvider::TileProvider()
+{
+    int mb = kDefaultCacheMB;
+    bool ok = false;
+    const int env = qEnvironmentVariableIntValue("RADARMAP_TILE_CACHE_MB", &ok);
+    if (ok && env > 0) mb = env;
+    setCacheBudgetMB(mb);
+    // Ön yükleme arayüzdeki istekleri boğmasın
+    prefetchPool.setMaxThreadCount(std::max(1, QThread::idealThreadCount() / 2));
+}
+
+TileProvider::~TileProvider()
+{
+    cancelPrefetch();
+    prefetchPool.waitForDone();
+}
+
+bool TileProvider::open(const QString &archivePath, QString *errorString)
+{
+    cancelPrefetch();
+    prefetchPool.waitForDone();
+    {
+        QMutexLocker locker(&cacheMutex);
+        cache.clear();
+    }
+    archive = TileArchive::open(archivePath, errorString);
+    return archive != nullptr;
+}
+
+void TileProvider::setCacheBudgetMB(int megabytes)
+{
+    QMutexLocker locker(&cacheMutex);
+    cache.setMaxCost(qint64(std::max(1, megabytes)) * 1024 * 1024);
+}
+
+int TileProvider::cacheBudgetMB() const
+{
+    QMutexLocker locker(&cacheMutex);
+    return static_cast<int>(cache.maxCost() / (1024 * 1024));
+}
+
+qint64 TileProvider::cachedBytes() const
+{
+    QMutexLocker locker(&cacheMutex);
+    return cache.totalCost();
+}
+
+qint64 TileProvider::loadIntoCache(int z, int x, int y, QByteArray *out)
+{
+    const QByteArray data = archive->tile(z, x, y);
+    const qint64 cost = data.isEmpty() ? kEmptyTileCost : data.size();
+    QMutexLocker locker(&cacheMutex);
+    cache.insert(cacheKey(z, x, y), new QByteArray(data), cost);
+    if (out) *out = data;
+    return cost;
+}
+
+QByteArray TileProvider::tile(int z, int x, int y)
+{
+    if (!archive || z < 0 || z > 24) return QByteArray();
+    {
+        QMutexLocker locker(&cacheMutex);
+        // object() öğeyi LRU listesinin başına taşır
+        if (const QByteArray *hit = cache.object(cacheKey(z, x, y))) return *hit;
+    }
+    QByteArray data;
+    loadIntoCache(z, x, y, &data);
+    return data;
+}
+
+void TileProvider::cancelPrefetch()
+{
+    ++prefetchGeneration;
+}
+
+void TileProvider::prefetch(double minLon, double minLat, double maxLon, double maxLat,
+                            int minZoom, int maxZoom)
+{
+    if (!archive) return;
+    const int gen = ++prefetchGeneration;
+    minZoom = std::max(minZoom, archive->minZoom());
+    maxZoom = std::min(maxZoom, archive->maxZoom());
+
+    // Her zoom seviyesi ayrı bir iş; kaba seviyeler önce biter
+    for (int z = minZoom; z <= maxZoom; ++z) {
+        const int x0 = lonToTileX(minLon, z), x1 = lonToTileX(maxLon, z);
+        const int y0 = latToTileY(maxLat, z), y1 = latToTileY(minLat, z);
+        prefetchPool.start([this, gen, z, x0, x1, y0, y1]() {
+            for (int y = y0; y <= y1; ++y) {
+                for (int x = x0; x <= x1; ++x) {
+                    if (prefetchGeneration.load() != gen) return;
+                    {
+                        QMutexLocker locker(&cacheMutex);
+                        // Bütçe dolduysa dur; aksi halde ön yükleme kendi tile'larını çıkarır
+                        if (cache.totalCost() >= cache.maxCost() * 9 / 10) return;
+                        if (cache.contains(cacheKey(z, x, y))) continue;
+                    }
+                    loadIntoCache(z, x, y, nullptr);
+                }
+            }
+        });
+    }
+}
+
+QByteArray TileProvider::styleJson(const QString &tileUrlTemplate, const QString &glyphsUrl) const
+{
+    if (!archive) return QByteArray();
+    const QJsonArray tiles{tileUrlTemplate};
+    const double *b = archive->bounds();
+    const QJsonArray bounds{b[0], b[1], b[2], b[3]};
+
+    // Arşiv yanında el yapımı stil varsa kaynaklarını yerel tile'lara yönlendir
+    const QFileInfo fi(archive->path());
+    QFile sidecar(fi.dir().filePath(fi.completeBaseName() + ".style.json"));
+    if (sidecar.open(QIODevice::ReadOnly)) {
+        QJsonObject style = QJsonDocument::fromJson(sidecar.readAll()).object();
+        if (!style.isEmpty()) {
+            QJsonObject sources = style.value("sources").toObject();
+            for (auto it = sources.begin(); it != sources.end(); ++it) {
+                QJsonObject src = it.value().toObject();
+                const QString type = src.value("type").toString();
+                if (type != "vector" && type != "raster") continue;
+                src.remove("url");
+                src.insert("tiles", tiles);
+                it.value() = src;
+            }
+            style.insert("sources", sources);
+            if (!style.contains("glyphs")) style.insert("glyphs", glyphsUrl);
+            return QJsonDocument(style).toJson(QJsonDocument::Compact);
+        }
+        qDebug() << "Ignoring invalid style sidecar" << sidecar.fileName();
+    }
+
+    QJsonObject source{
+        {"type", archive->isVector() ? "vector" : "raster"},
+        {"tiles", tiles},
+        {"minzoom", archive->minZoom()},
+        {"maxzoom", archive->maxZoom()},
+        {"bounds", bounds},
+    };
+    if (!archive->isVector()) source.insert("tileSize", 256);
+
+    QJsonArray layers;
+    layers.append(QJsonObject{
+        {"id", "background"}, {"type", "background"},
+        {"paint", QJsonObject{{"background-color", "#1b1f24"}}},
+    });
+    if (archive->isVector()) {
+        // vector_layers: her katman için sade bir dolgu + çizgi
+        const QJsonArray vectorLayers = archive->metadata().value("vector_layers").toArray();
+        for (const QJsonValue &v : vectorLayers) {
+            const QString id = v.toObject().value("id").toString();
+            if (id.isEmpty()) continue;
+            const bool water = isWaterLayer(id);
+            layers.append(QJsonObject{
+                {"id", id + "-fill"}, {"type", "fill"}, {"source", "offline"}, {"source-layer", id},
+                {"filter", QJsonArray{"==", QJsonArray{"geometry-type"}, "Polygon"}},
+                {"paint", QJsonObject{{"fill-color", water ? "#1d3b53" : "#262c33"}, {"fill-opacity", 0.8}}},
+            });
+            layers.append(QJsonObject{
+                {"id", id + "-line"}, {"type", "line"}, {"source", "offline"}, {"source-layer", id},
+                {"filter", QJsonArray{"==", QJsonArray{"geometry-type"}, "LineString"}},
+                {"paint", QJsonObject{{"line-color", water ? "#2f5f86" : "#4a525c"}, {"line-width", 0.7}}},
+            });
+        }
+    } else {
+        layers.append(QJsonObject{{"id", "offline-raster"}, {"type", "raster"}, {"source", "offline"}});
+    }
+
+    const QJsonObject style{
+        {"version", 8},
+        {"name", fi.completeBaseName()},
+        {"glyphs", glyphsUrl},
+        {"sources", QJsonObject{{"offline", source}}},
+        {"layers", layers},
+    };
+    return QJsonDocument(style).toJson(QJsonDocument::Compact);
+}
@@ -0,0 +1,61 @@
+#ifndef TILEPROVIDER_H
+#define TILEPROVIDER_H
+
+#include <QByteArray>
+#include <QCache>
+#include <QMutex>
+#include <QString>
+#include <QThreadPool>
+#include <atomic>
+#include <memory>
+#include "tilearchive.h"
+
+// Arşiv + bellek içi LRU tile önbelleği. tile() herhangi bir thread'den çağrılabilir.
+// Önbellek bütçesi bayt cinsindendir (QCache maliyeti = tile boyutu); varsayılan
+// 256 MB, RADARMAP_TILE_CACHE_MB ortam değişkeniyle değiştirilebilir.
+class TileProvider
+{
+public:
+    TileProvider();
+    ~TileProvider();
+
+    bool open(const QString &archivePath, QString *errorString = nullptr);
+    bool isOpen() const { return archive != nullptr; }
+    const TileArchive *tileArchive() const { return archive.get(); }
+    QString contentType() const { return archive ? archive->contentType() : QString(); }
+
+    // Önbellekten ya da arşivden; yoksa boş
+    QByteArray tile(int z, int x, int y);
+
+    // MapLibre stil JSON'u: arşiv yanında <ad>.style.json varsa o, yoksa
+    // arşiv türüne göre üretilen basit stil. Kaynak url'leri tileUrlTemplate'e bağlanır.
+    QByteArray styleJson(const QString &tileUrlTemplate, const QString &glyphsUrl) const;
+
+    void setCacheBudgetMB(int megabytes);
+    int cacheBudgetMB() const;
+    qint64 cachedBytes() const;
+
+    // Sınır kutusundaki [minZoom, maxZoom] tile'larını arka planda önbelleğe alır.
+    // Önbellek bütçesi dolunca durur. Yeni çağrı öncekini iptal eder.
+    void prefetch(double minLon, double minLat, double maxLon, double maxLat,
+                  int minZoom, int maxZoom);
+    void cancelPrefetch();
+
+private:
+    static quint64 cacheKey(int z, int x, int y)
+    {
+        return (quint64(z) << 58) | (quint64(x) << 29) | quint64(y);
+    }
+    // Önbelleğe alır; eklenen bayt maliyetini döndürür
+    qint64 loadIntoCache(int z, int x, int y, QByteArray *out);
+
+    std::unique_ptr<TileArchive> archive;
+
+    mutable QMutex cacheMutex;
+    QCache<quint64, QByteArray> cache;
+
+    QThreadPool prefetchPool;
+    std::atomic<int> prefetchGeneration{0};
+};
+
+#endif // TILEPROVIDER_H
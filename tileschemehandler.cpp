@@ -0,0 +1,131 @@
+#include "tileschemehandler.h"
+#include "tileprovider.h"
+#include <QWebEngineUrlRequestJob>
+#include <QWebEngineUrlScheme>
+#include <QCoreApplication>
+#include <QThreadPool>
+#include <QPointer>
+#include <QBuffer>
+#include <QFile>
+#include <QFileInfo>
+#include <QDir>
+#include <QUrl>
+
+namespace {
+
+QByteArray mimeForSuffix(const QString &suffix)
+{
+    const QString s = suffix.toLower();
+    if (s == "js") return "application/javascript";
+    if (s == "css") return "text/css";
+    if (s == "json") return "application/json";
+    if (s == "pbf") return "application/x-protobuf";
+    if (s == "png") return "image/png";
+    if (s == "svg") return "image/svg+xml";
+    return "application/octet-stream";
+}
+
+// Okuma bitince cevabı UI thread'inde ver; iş bu arada iptal edildiyse QPointer boşalır
+void replyLater(QPointer<QWebEngineUrlRequestJob> job, const QByteArray &mime, const QByteArray &data)
+{
+    QMetaObject::invokeMethod(qApp, [job, mime, data]() {
+        if (!job) return;
+        auto *buffer = new QBuffer(job);
+        buffer->setData(data);
+        buffer->open(QIODevice::ReadOnly);
+        job->reply(mime, buffer);
+    }, Qt::QueuedConnection);
+}
+
+void failLater(QPointer<QWebEngineUrlRequestJob> job, QWebEngineUrlRequestJob::Error error)
+{
+    QMetaObject::invokeMethod(qApp, [job, error]() {
+        if (job) job->fail(error);
+    }, Qt::QueuedConnection);
+}
+
+} // namespace
+
+TileSchemeHandler::TileSchemeHandler(std::shared_ptr<TileProvider> provider, QObject *parent)
+    : QWebEngineUrlSchemeHandler(parent)
+    , provider(std::move(provider))
+{
+}
+
+void TileSchemeHandler::registerUrlScheme()
+{
+    QWebEngineUrlScheme scheme(schemeName());
+    scheme.setSyntax(QWebEngineUrlScheme::Syntax::Host);
+    QWebEngineUrlScheme::Flags flags = QWebEngineUrlScheme::SecureScheme
+                                     | QWebEngineUrlScheme::LocalAccessAllowed
+                                     | QWebEngineUrlScheme::CorsEnabled;
+#if QT_VERSION >= QT_VERSION_CHECK(6, 6, 0)
+    flags |= QWebEngineUrlScheme::FetchApiAllowed;
+#endif
+    scheme.setFlags(flags);
+    QWebEngineUrlScheme::registerScheme(scheme);
+}
+
+QString TileSchemeHandler::assetsDir()
+{
+    return QDir(QCoreApplication::applicationDirPath()).filePath("maplibre");
+}
+
+void TileSchemeHandler::requestStarted(QWebEngineUrlRequestJob *job)
+{
+    const QUrl url = job->requestUrl();
+    const QString host = url.host();
+    const QString path = url.path();
+    QPointer<QWebEngineUrlRequestJob> guard(job);
+
+    if (host == "assets") {
+        // Yalnızca assets dizini altı; ".." ile dışarı çıkılamaz
+        const QString root = QDir(assetsDir()).canonicalPath();
+        const QString file = QFileInfo(QDir(root).filePath(path.mid(1))).canonicalFilePath();
+        if (root.isEmpty() || file.isEmpty() || !file.startsWith(root + '/')) {
+            job->fail(QWebEngineUrlRequestJob::UrlNotFound);
+            return;
+        }
+        QThreadPool::globalInstance()->start([guard, file]() {
+            QFile f(file);
+            if (!f.open(QIODevice::ReadOnly)) { failLater(guard, QWebEngineUrlRequestJob::UrlNotFound); return; }
+            replyLater(guard, mimeForSuffix(QFileInfo(file).suffix()), f.readAll());
+        });
+        return;
+    }
+
+    if (host != "tiles" || !provider || !provider->isOpen()) {
+        job->fail(QWebEngineUrlRequestJob::UrlNotFound);
+        return;
+    }
+
+    if (path == "/style.json") {
+        const QString base = QString("%1://tiles").arg(schemeName());
+        const QByteArray style = provider->styleJson(base + "/{z}/{x}/{y}",
+                                                     QString("%1://assets/fonts/{fontstack}/{range}.pbf").arg(schemeName()));
+        replyLater(guard, "application/json", style);
+        return;
+    }
+
+    // /{z}/{x}/{y}[.ext]
+    const QStringList parts = path.mid(1).split('/');
+    bool okZ = false, okX = false, okY = false;
+    const int z = parts.value(0).toInt(&okZ);
+    const int x = parts.value(1).toInt(&okX);
+    const int y = parts.value(2).section('.', 0, 0).toInt(&okY);
+    if (parts.size() != 3 || !okZ || !okX || !okY) {
+        job->fail(QWebEngineUrlRequestJob::UrlInvalid);
+        return;
+    }
+
+    auto p = provider;
+    QThreadPool::globalInstance()->start([guard, p, z, x, y]() {
+        const QByteArray data = p->tile(z, x, y);
+        if (data.isEmpty() && !p->tileArchive()->isVector()) {
+            failLater(guard, QWebEngineUrlRequestJob::UrlNotFound);
+            return;
+        }
+        // Vektörde eksik tile boş pbf olarak döner (MapLibre hata basmaz)
+        replyLater(guard, p->contentType().toUtf8(), data);
+    });
+}
@@ -0,0 +1,33 @@
+#ifndef TILESCHEMEHANDLER_H
+#define TILESCHEMEHANDLER_H
+
+#include <QWebEngineUrlSchemeHandler>
+#include <QString>
+#include <memory>
+
+class TileProvider;
+
+// radartiles:// şeması (internet gerektirmeyen harita):
+//   radartiles://tiles/{z}/{x}/{y}   -> arşivdeki tile (TileProvider önbelleği üzerinden)
+//   radartiles://tiles/style.json    -> arşive göre üretilen MapLibre stili
+//   radartiles://assets/<dosya>      -> <uygulama dizini>/maplibre altındaki JS/CSS/font
+// İstekler UI thread'inde alınır, diskten okuma thread havuzunda yapılır.
+class TileSchemeHandler : public QWebEngineUrlSchemeHandler
+{
+    Q_OBJECT
+
+public:
+    explicit TileSchemeHandler(std::shared_ptr<TileProvider> provider, QObject *parent = nullptr);
+
+    static const char *schemeName() { return "radartiles"; }
+    // QApplication oluşturulmadan önce bir kez çağrılmalıdır
+    static void registerUrlScheme();
+    static QString assetsDir();
+
+    void requestStarted(QWebEngineUrlRequestJob *job) override;
+
+private:
+    std::shared_ptr<TileProvider> provider;
+};
+
+#endif // TILESCHEMEHANDLER_H
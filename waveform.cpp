@@ -0,0 +1,277 @@
+#include "waveform.h"
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <mutex>
+#include <numeric>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+
+namespace Wf {
+
+namespace {
+
+constexpr double kPi = 3.14159265358979323846;
+// Tek darbe üst sınırı (örnek); 1000 us x 1 GHz x 2 = 2M sığar
+constexpr std::size_t kMaxSamples = std::size_t(1) << 22;
+
+// Faz x·π / m, x tam sayı (büyük kodlarda double hassasiyeti korunur)
+double phaseMod(long long x, long long m)
+{
+    const long long period = 2 * m;
+    x %= period;
+    if (x < 0) x += period;
+    return kPi * double(x) / double(m);
+}
+
+const std::vector<int> &barker(int length)
+{
+    static const std::map<int, std::vector<int>> codes = {
+        {2, {1, -1}},
+        {3, {1, 1, -1}},
+        {4, {1, 1, -1, 1}},
+        {5, {1, 1, 1, -1, 1}},
+        {7, {1, 1, 1, -1, -1, 1, -1}},
+        {11, {1, 1, 1, -1, -1, -1, 1, -1, -1, 1, -1}},
+        {13, {1, 1, 1, 1, 1, -1, -1, 1, 1, -1, 1, -1, 1}},
+    };
+    const auto it = codes.find(length);
+    if (it == codes.end()) throw std::invalid_argument("Wf: unsupported Barker length");
+    return it->second;
+}
+
+// Zadoff-Chu uzunluğu: B·τ'dan başlayıp kök mod L sıfır değil ve aralarında asal olana dek
+long long zadoffChuLength(const Settings &s)
+{
+    long long L = std::max<long long>(2, std::llround(s.pulseWidthUs * s.bandwidthMHz));
+    const long long u = std::max(1, s.zcRoot);
+    while (u % L == 0 || std::gcd(u % L, L) != 1) ++L;
+    return L;
+}
+
+void hashBytes(std::uint64_t &h, const void *data, std::size_t size)
+{
+    const unsigned char *p = static_cast<const unsigned char *>(data);
+    for (std::size_t i = 0; i < size; ++i) {
+        h ^= p[i];
+        h *= 1099511628211ull;
+    }
+}
+
+bool sameSettings(const Settings &a, const Settings &b)
+{
+    return a.type == b.type && a.pulseWidthUs == b.pulseWidthUs && a.bandwidthMHz == b.bandwidthMHz
+           && a.barkerLength == b.barkerLength && a.frankSize == b.frankSize && a.pCodeSize == b.pCodeSize
+           && a.zcRoot == b.zcRoot && a.window == b.window && a.oversampling == b.oversampling;
+}
+
+} // namespace
+
+Type typeFromName(const std::string &name)
+{
+    static const std::pair<const char *, Type> names[] = {
+        {"LFM", Type::Lfm}, {"Barker", Type::Barker}, {"Frank", Type::Frank},
+        {"P1", Type::P1}, {"P2", Type::P2}, {"P3", Type::P3}, {"P4", Type::P4},
+        {"Zadoff-Chu", Type::ZadoffChu},
+    };
+    for (const auto &n : names)
+        if (name == n.first) return n.second;
+    return Type::Rectangular;
+}
+
+Window windowFromName(const std::string &name)
+{
+    if (name == "Hamming") return Window::Hamming;
+    if (name == "Hanning") return Window::Hanning;
+    if (name == "Blackman") return Window::Blackman;
+    if (name == "Flat-top") return Window::FlatTop;
+    return Window::None;
+}
+
+Settings canonical(const Settings &settings)
+{
+    Settings s = settings;
+    s.pulseWidthUs = std::max(s.pulseWidthUs, 1e-3);
+    s.bandwidthMHz = std::max(s.bandwidthMHz, 1e-3);
+    s.oversampling = std::max(s.oversampling, 1.0);
+    if (s.type != Type::Barker) s.barkerLength = 0;
+    s.frankSize = s.type == Type::Frank ? std::max(s.frankSize, 2) : 0;
+    const bool pCode = s.type == Type::P1 || s.type == Type::P2 || s.type == Type::P3 || s.type == Type::P4;
+    s.pCodeSize = pCode ? std::max(s.pCodeSize, 2) : 0;
+    s.zcRoot = s.type == Type::ZadoffChu ? std::max(s.zcRoot, 1) : 0;
+    return s;
+}
+
+std::uint64_t settingsHash(const Settings &settings)
+{
+    const Settings s = canonical(settings);
+    std::uint64_t h = 14695981039346656037ull;
+    const int type = int(s.type), win = int(s.window);
+    hashBytes(h, &type, sizeof type);
+    hashBytes(h, &s.pulseWidthUs, sizeof s.pulseWidthUs);
+    hashBytes(h, &s.bandwidthMHz, sizeof s.bandwidthMHz);
+    hashBytes(h, &s.barkerLength, sizeof s.barkerLength);
+    hashBytes(h, &s.frankSize, sizeof s.frankSize);
+    hashBytes(h, &s.pCodeSize, sizeof s.pCodeSize);
+    hashBytes(h, &s.zcRoot, sizeof s.zcRoot);
+    hashBytes(h, &win, sizeof win);
+    hashBytes(h, &s.oversampling, sizeof s.oversampling);
+    return h;
+}
+
+std::shared_ptr<const AlignedVector<float>> window(Window type, std::size_t n)
+{
+    static std::mutex mutex;
+    static std::map<std::pair<int, std::size_t>, std::shared_ptr<const AlignedVector<float>>> tables;
+    std::lock_guard<std::mutex> lock(mutex);
+    std::shared_ptr<const AlignedVector<float>> &table = tables[{int(type), n}];
+    if (table) return table;
+
+    // Kosinüs toplamı: w = a0 - a1 cos x + a2 cos 2x - a3 cos 3x + a4 cos 4x
+    double a[5] = {1.0, 0.0, 0.0, 0.0, 0.0};
+    switch (type) {
+    case Window::Hamming: a[0] = 0.54; a[1] = 0.46; break;
+    case Window::Hanning: a[0] = 0.5; a[1] = 0.5; break;
+    case Window::Blackman: a[0] = 0.42; a[1] = 0.5; a[2] = 0.08; break;
+    case Window::FlatTop:
+        a[0] = 0.21557895; a[1] = 0.41663158; a[2] = 0.277263158; a[3] = 0.083578947; a[4] = 0.006947368;
+        break;
+    case Window::None: break;
+    }
+    auto w = std::make_shared<AlignedVector<float>>(n, 1.0f);
+    if (type != Window::None && n > 1) {
+        for (std::size_t i = 0; i < n; ++i) {
+            const double x = 2.0 * kPi * double(i) / double(n - 1);
+            (*w)[i] = static_cast<float>(a[0] - a[1] * std::cos(x) + a[2] * std::cos(2.0 * x)
+                                         - a[3] * std::cos(3.0 * x) + a[4] * std::cos(4.0 * x));
+        }
+    }
+    table = std::move(w);
+    return table;
+}
+
+std::vector<double> chipPhases(const Settings &settings)
+{
+    const Settings s = canonical(settings);
+    std::vector<double> phase;
+    switch (s.type) {
+    case Type::Rectangular:
+    case Type::Lfm:
+        phase.assign(1, 0.0);
+        break;
+    case Type::Barker:
+        for (int c : barker(s.barkerLength)) phase.push_back(c > 0 ? 0.0 : kPi);
+        break;
+    case Type::Frank:
+    case Type::P1:
+    case Type::P2: {
+        // N² çip, j: frekans grubu, i: grup içi eleman
+        const long long N = s.type == Type::Frank ? s.frankSize : s.pCodeSize;
+        phase.reserve(std::size_t(N * N));
+        for (long long j = 0; j < N; ++j) {
+            for (long long i = 0; i < N; ++i) {
+                if (s.type == Type::Frank) phase.push_back(phaseMod(2 * i * j, N));
+                else if (s.type == Type::P1) phase.push_back(phaseMod(-(N - (2 * j + 1)) * (j * N + i), N));
+                else phase.push_back(phaseMod((N + 1 - 2 * (i + 1)) * (N + 1 - 2 * (j + 1)), 2 * N));
+            }
+        }
+        break;
+    }
+    case Type::P3:
+    case Type::P4: {
+        const long long N = s.pCodeSize;
+        phase.reserve(std::size_t(N));
+        for (long long i = 0; i < N; ++i)
+            phase.push_back(s.type == Type::P3 ? phaseMod(i * i, N) : phaseMod(i * i - i * N, N));
+        break;
+    }
+    case Type::ZadoffChu: {
+        const long long L = zadoffChuLength(s), u = s.zcRoot % L;
+        phase.reserve(std::size_t(L));
+        for (long long n = 0; n < L; ++n)
+            phase.push_back(phaseMod(-u * (L % 2 ? n * (n + 1) : n * n), L));
+        break;
+    }
+    }
+    return phase;
+}
+
+std::shared_ptr<const Waveform> build(const Settings &settings)
+{
+    auto wf = std::make_shared<Waveform>();
+    wf->settings = canonical(settings);
+    const Settings &s = wf->settings;
+
+    const std::vector<double> phase = chipPhases(s);
+    const bool coded = s.type != Type::Rectangular && s.type != Type::Lfm;
+    wf->chips = phase.size();
+    const double T = s.pulseWidthUs * 1e-6, B = s.bandwidthMHz * 1e6;
+    const double chipRate = coded ? double(wf->chips) / T : 1.0 / T;
+    wf->sampleRateHz = s.oversampling * std::max(B, chipRate);
+    const double count = std::max(std::round(T * wf->sampleRateHz), double(coded ? wf->chips : 1));
+    if (count > double(kMaxSamples)) throw std::invalid_argument("Wf: pulse too long for the sample rate");
+    const std::size_t n = static_cast<std::size_t>(count);
+    wf->samples = n;
+
+    wf->re.resize(n);
+    wf->im.resize(n);
+    if (s.type == Type::Lfm) {
+        // φ(t) = π (B / τ) t², t darbe ortasına göre
+        const double k = kPi * B / T, mid = 0.5 * double(n - 1);
+        for (std::size_t i = 0; i < n; ++i) {
+            const double t = (double(i) - mid) / wf->sampleRateHz;
+            const double p = std::fmod(k * t * t, 2.0 * kPi);
+            wf->re[i] = static_cast<float>(std::cos(p));
+            wf->im[i] = static_cast<float>(std::sin(p));
+        }
+    } else {
+        // Çip başına faz; örnek i, floor(i * chips / n) numaralı çipe düşer
+        std::vector<float> chipRe(phase.size()), chipIm(phase.size());
+        for (std::size_t c = 0; c < phase.size(); ++c) {
+            chipRe[c] = static_cast<float>(std::cos(phase[c]));
+            chipIm[c] = static_cast<float>(std::sin(phase[c]));
+        }
+        for (std::size_t i = 0; i < n; ++i) {
+            const std::size_t c = std::size_t((std::uint64_t(i) * wf->chips) / n);
+            wf->re[i] = chipRe[c];
+            wf->im[i] = chipIm[c];
+        }
+    }
+
+    const std::shared_ptr<const AlignedVector<float>> w = window(s.window, n);
+    wf->refRe.resize(n);
+    wf->refIm.resize(n);
+    double sum = 0.0, sum2 = 0.0;
+    for (std::size_t i = 0; i < n; ++i) {
+        wf->refRe[i] = wf->re[i] * (*w)[i];
+        wf->refIm[i] = wf->im[i] * (*w)[i];
+        sum += (*w)[i];
+        sum2 += double((*w)[i]) * (*w)[i];
+    }
+    wf->windowLossDb = sum2 > 0.0 ? -10.0 * std::log10(sum * sum / (double(n) * sum2)) : 0.0;
+    return wf;
+}
+
+std::shared_ptr<const Waveform> get(const Settings &settings)
+{
+    static std::mutex mutex;
+    static std::unordered_map<std::uint64_t, std::shared_ptr<const Waveform>> cache;
+    const Settings s = canonical(settings);
+    const std::uint64_t key = settingsHash(s);
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        const auto it = cache.find(key);
+        if (it != cache.end()) {
+            // Karma çakışması: önbelleğe yazmadan üret
+            if (sameSettings(it->second->settings, s)) return it->second;
+            return build(s);
+        }
+    }
+    // Üretim kilit dışında; yarışta ilk yazılan kalır
+    std::shared_ptr<const Waveform> wf = build(s);
+    std::lock_guard<std::mutex> lock(mutex);
+    return cache.emplace(key, std::move(wf)).first->second;
+}
+
+} // namespace Wf
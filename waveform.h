@@ -0,0 +1,71 @@
+#ifndef WAVEFORM_H
+#define WAVEFORM_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "alignedbuffer.h"
+
+// Darbe dalga biçimi kütüphanesi (yalnızca std): Radar sekmesindeki dalga
+// biçimi ve pencere seçimleri için karmaşık taban bant örnekleri.
+//
+// Faz kodları (Barker, Frank, P1-P4, Zadoff-Chu) çip başına sabit fazdır; örnek
+// n, t = n / fs anındaki çipi alır. Örnekleme hızı bant genişliği ile çip
+// hızının büyüğünün oversampling katıdır. Örnekler split formattadır (re[],
+// im[], 64 bayt hizalı), FftPlan ile doğrudan kullanılabilir.
+//
+// Dalga biçimleri ayar karmasıyla (hash) önbelleğe alınır: get() aynı ayarlar
+// için aynı sabit nesneyi döndürür, darbe başına yeniden üretim yapılmaz.
+// Pencere katsayıları da (tür, boy) başına bir kez hesaplanır.
+namespace Wf {
+
+enum class Type { Rectangular, Lfm, Barker, Frank, P1, P2, P3, P4, ZadoffChu };
+enum class Window { None, Hamming, Hanning, Blackman, FlatTop };
+
+struct Settings {
+    Type type{Type::Rectangular};
+    double pulseWidthUs{0.51};
+    double bandwidthMHz{5.0};
+    int barkerLength{13};           // 2, 3, 4, 5, 7, 11, 13
+    int frankSize{4};               // N: N² çip
+    int pCodeSize{4};               // P1/P2: N (N² çip), P3/P4: çip sayısı
+    int zcRoot{25};                 // uzunluk B·τ'dan, köke aralarında asal olana dek artırılır
+    Window window{Window::None};    // yalnızca eşlenik filtre referansına uygulanır
+    double oversampling{2.0};
+};
+
+// Sidebar'daki adlar ("Zadoff-Chu", "Flat-top", "No window" ...); bilinmeyen ad
+// Rectangular / None döner
+Type typeFromName(const std::string &name);
+Window windowFromName(const std::string &name);
+
+// İlgisiz alanlar sıfırlanmış kanonik ayarlar ve karması
+Settings canonical(const Settings &settings);
+std::uint64_t settingsHash(const Settings &settings);
+
+// Simetrik pencere katsayıları, (tür, boy) başına paylaşılan tablo
+std::shared_ptr<const AlignedVector<float>> window(Window type, std::size_t n);
+
+struct Waveform {
+    Settings settings;              // kanonik
+    double sampleRateHz{0.0};
+    std::size_t chips{1};           // faz kodu uzunluğu (Rectangular/LFM: 1)
+    std::size_t samples{0};
+    AlignedVector<float> re, im;    // gönderilen darbe, birim genlik
+    AlignedVector<float> refRe, refIm;  // pencereli referans (eşlenik filtre s*(-t) bundan)
+    double windowLossDb{0.0};       // pencerenin SNR kaybı (>= 0)
+};
+
+// Hesaplar (önbelleksiz). Geçersiz Barker uzunluğunda std::invalid_argument.
+std::shared_ptr<const Waveform> build(const Settings &settings);
+// Ayar karması başına tek nesne (thread-safe önbellek)
+std::shared_ptr<const Waveform> get(const Settings &settings);
+
+// Çip fazları (radyan), faz kodları için; diğer türlerde tek sıfır
+std::vector<double> chipPhases(const Settings &settings);
+
+} // namespace Wf
+
+#endif // WAVEFORM_H
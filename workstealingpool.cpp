@@ -0,0 +1,115 @@
+#include "workstealingpool.h"
+#include <algorithm>
+
+WorkStealingPool::WorkStealingPool(int threadCount)
+{
+    if (threadCount <= 0) threadCount = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    for (int i = 0; i < threadCount; ++i) queues.push_back(std::make_unique<Queue>());
+    // Worker 0 çağıran thread'dir
+    for (int i = 1; i < threadCount; ++i) threads.emplace_back(&WorkStealingPool::workerLoop, this, i);
+}
+
+WorkStealingPool::~WorkStealingPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(jobMutex);
+        shuttingDown = true;
+    }
+    jobStart.notify_all();
+    for (std::thread &t : threads) t.join();
+}
+
+bool WorkStealingPool::popLocal(int worker, Range &out)
+{
+    Queue &q = *queues[worker];
+    std::lock_guard<std::mutex> lock(q.mutex);
+    if (q.ranges.empty()) return false;
+    out = q.ranges.back();
+    q.ranges.pop_back();
+    return true;
+}
+
+bool WorkStealingPool::steal(int thief, Range &out)
+{
+    const int n = workerCount();
+    for (int k = 1; k < n; ++k) {
+        Queue &q = *queues[(thief + k) % n];
+        std::lock_guard<std::mutex> lock(q.mutex);
+        if (q.ranges.empty()) continue;
+        out = q.ranges.front();
+        q.ranges.pop_front();
+        return true;
+    }
+    return false;
+}
+
+void WorkStealingPool::drain(int worker)
+{
+    Range r;
+    while (remaining.load(std::memory_order_acquire) > 0) {
+        if (!popLocal(worker, r) && !steal(worker, r)) {
+            // Kalan parçalar başka worker'larda işleniyor
+            std::this_thread::yield();
+            continue;
+        }
+        (*job)(r.begin, r.end, worker);
+        remaining.fetch_sub(1, std::memory_order_acq_rel);
+    }
+}
+
+void WorkStealingPool::workerLoop(int worker)
+{
+    unsigned long long seen = 0;
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(jobMutex);
+            jobStart.wait(lock, [&] { return shuttingDown || jobGeneration != seen; });
+            if (shuttingDown) return;
+            seen = jobGeneration;
+            ++busyWorkers;
+        }
+        drain(worker);
+        {
+            std::lock_guard<std::mutex> lock(jobMutex);
+            --busyWorkers;
+        }
+        jobDone.notify_all();
+    }
+}
+
+void WorkStealingPool::parallelFor(std::size_t count, std::size_t grain, const RangeFn &fn)
+{
+    if (count == 0) return;
+    grain = std::max<std::size_t>(1, grain);
+    const std::size_t chunks = (count + grain - 1) / grain;
+    if (chunks == 1 || threads.empty()) {
+        fn(0, count, 0);
+        return;
+    }
+
+    std::lock_guard<std::mutex> call(callMutex);
+    // Bitişik blokları worker'lara dağıt
+    const int n = workerCount();
+    for (int w = 0; w < n; ++w) {
+        const std::size_t c0 = chunks * w / n, c1 = chunks * (w + 1) / n;
+        Queue &q = *queues[w];
+        std::lock_guard<std::mutex> lock(q.mutex);
+        // Sondan alınacağı için ters sırada it: worker kendi bloğunu baştan işler
+        for (std::size_t c = c1; c-- > c0;) q.ranges.push_back({c * grain, std::min(count, (c + 1) * grain)});
+    }
+    {
+        // Önceki işten geç uyanan worker job'u ve remaining'i birlikte görmeli
+        std::lock_guard<std::mutex> lock(jobMutex);
+        job = &fn;
+        remaining.store(chunks, std::memory_order_release);
+        ++jobGeneration;
+    }
+    jobStart.notify_all();
+
+    drain(0);
+
+    // fn referansı, onu kullanan son worker çıkana kadar geçerli kalmalı
+    std::unique_lock<std::mutex> lock(jobMutex);
+    jobDone.wait(lock, [&] { return busyWorkers == 0; });
+    job = nullptr;
+}
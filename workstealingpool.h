@@ -0,0 +1,62 @@
+#ifndef WORKSTEALINGPOOL_H
+#define WORKSTEALINGPOOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Basit iş çalan thread havuzu (yalnızca std, Qt gerektirmez).
+//
+// parallelFor aralığı grain boyutlu parçalara böler ve her worker'ın kuyruğuna
+// bitişik bloklar halinde dağıtır. Worker kendi kuyruğunun sonundan alır (önbellek
+// dostu), boşalınca diğerlerinin başından çalar. Çağıran thread worker 0 olarak
+// katılır ve tüm parçalar bitene kadar döner. Aynı anda tek parallelFor çalışır.
+class WorkStealingPool
+{
+public:
+    // threads <= 0: donanım thread sayısı (çağıran dahil)
+    explicit WorkStealingPool(int threads = 0);
+    ~WorkStealingPool();
+
+    WorkStealingPool(const WorkStealingPool &) = delete;
+    WorkStealingPool &operator=(const WorkStealingPool &) = delete;
+
+    // Çağıran dahil worker sayısı; fn'e verilen worker indeksi [0, workerCount)
+    int workerCount() const { return static_cast<int>(queues.size()); }
+
+    using RangeFn = std::function<void(std::size_t begin, std::size_t end, int worker)>;
+    void parallelFor(std::size_t count, std::size_t grain, const RangeFn &fn);
+
+private:
+    struct Range { std::size_t begin; std::size_t end; };
+    struct Queue {
+        std::mutex mutex;
+        std::deque<Range> ranges;
+    };
+
+    void workerLoop(int worker);
+    void drain(int worker);
+    bool popLocal(int worker, Range &out);
+    bool steal(int thief, Range &out);
+
+    std::vector<std::unique_ptr<Queue>> queues;
+    std::vector<std::thread> threads;
+
+    std::mutex jobMutex;
+    std::condition_variable jobStart;
+    std::condition_variable jobDone;
+    const RangeFn *job{nullptr};
+    unsigned long long jobGeneration{0};
+    int busyWorkers{0};               // jobMutex altında
+    bool shuttingDown{false};
+    std::atomic<std::size_t> remaining{0};
+    std::mutex callMutex;             // parallelFor'u serileştirir
+};
+
+#endif // WORKSTEALINGPOOL_H